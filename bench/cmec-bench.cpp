@@ -0,0 +1,503 @@
+///////////////////////////////////////////////////////////////////////////////
+///
+///	\file    cmec-bench.cpp
+///	\author  Paul Ullrich
+///	\version September 1, 2026
+///
+///	<remarks>
+///		Copyright (c) 2020 Paul Ullrich
+///
+///		Distributed under the BSD 3-Clause License.
+///		(See accompanying file LICENSE)
+///	</remarks>
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "json.hpp"
+
+#include "ArgumentParser.h"
+#include "DataArray1D.h"
+#include "DataArray2D.h"
+#include "DataArray3D.h"
+#include "Exception.h"
+#include "LookupVectorHash.h"
+#include "LookupVectorHeap.h"
+#include "TimeObj.h"
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Minimum wall time of one benchmark measurement (seconds).  Each
+///		benchmark repeats its workload until this much time has elapsed,
+///		so reported rates are stable across runs.
+///	</summary>
+static const double g_dMinMeasureSeconds = 0.2;
+
+///	<summary>
+///		Accumulator defeating dead code elimination of benchmark kernels.
+///	</summary>
+static volatile double g_dSink = 0.0;
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Outcome of a single benchmark:  the number of workload repetitions,
+///		total elapsed time, and the derived throughput.
+///	</summary>
+struct BenchResult {
+
+	///	<summary>
+	///		Name of the benchmark.
+	///	</summary>
+	std::string strName;
+
+	///	<summary>
+	///		Number of workload repetitions measured.
+	///	</summary>
+	size_t nIterations;
+
+	///	<summary>
+	///		Total elapsed time (seconds).
+	///	</summary>
+	double dSeconds;
+
+	///	<summary>
+	///		Throughput of the benchmark.
+	///	</summary>
+	double dRate;
+
+	///	<summary>
+	///		Unit of the throughput value.
+	///	</summary>
+	std::string strUnit;
+};
+
+///	<summary>
+///		All benchmark results, in execution order.
+///	</summary>
+static std::vector<BenchResult> g_vecResults;
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Run the given workload repeatedly until g_dMinMeasureSeconds has
+///		elapsed and record its throughput, where one repetition performs
+///		dUnitsPerIteration units of work measured in strUnit.
+///	</summary>
+template <typename Workload>
+void RunBenchmark(
+	const char * szName,
+	double dUnitsPerIteration,
+	const char * szUnit,
+	Workload workload
+) {
+	// Warm up caches and allocators
+	workload();
+
+	size_t nIterations = 0;
+	auto timeBegin = std::chrono::steady_clock::now();
+	double dSeconds = 0.0;
+	for (;;) {
+		workload();
+		nIterations++;
+
+		auto timeNow = std::chrono::steady_clock::now();
+		dSeconds =
+			std::chrono::duration<double>(timeNow - timeBegin).count();
+		if (dSeconds >= g_dMinMeasureSeconds) {
+			break;
+		}
+	}
+
+	BenchResult result;
+	result.strName = szName;
+	result.nIterations = nIterations;
+	result.dSeconds = dSeconds;
+	result.dRate =
+		static_cast<double>(nIterations) * dUnitsPerIteration / dSeconds;
+	result.strUnit = szUnit;
+	g_vecResults.push_back(result);
+
+	printf("  %-32s %12.3f %s\n",
+		szName, result.dRate, szUnit);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Build a synthetic CMEC library JSON document with the given number
+///		of modules.
+///	</summary>
+std::string BuildLibraryFixture(
+	size_t sModuleCount
+) {
+	nlohmann::json jlib;
+	jlib["version"] = "00000000";
+	jlib["cmec-driver"] = nlohmann::json::value_t::object;
+	jlib["modules"] = nlohmann::json::value_t::object;
+	for (size_t s = 0; s < sModuleCount; s++) {
+		char szName[32];
+		snprintf(szName, sizeof(szName), "module%06lu", s);
+		jlib["modules"][szName] =
+			std::string("/opt/cmec/modules/") + szName;
+	}
+	return jlib.dump();
+}
+
+///	<summary>
+///		Build a synthetic contents.json document with the given number of
+///		configurations.
+///	</summary>
+std::string BuildTOCFixture(
+	size_t sConfigCount
+) {
+	nlohmann::json jtoc;
+	jtoc["module"]["name"] = "benchmod";
+	jtoc["module"]["long_name"] = "Benchmark Module";
+	jtoc["module"]["version"] = "1.0";
+	jtoc["contents"] = nlohmann::json::value_t::object;
+	for (size_t s = 0; s < sConfigCount; s++) {
+		char szName[32];
+		snprintf(szName, sizeof(szName), "config%04lu", s);
+		jtoc["contents"][szName] =
+			std::string(szName) + "/settings.json";
+	}
+	return jtoc.dump();
+}
+
+///	<summary>
+///		Build a synthetic PMP metrics document:  a RESULTS tree of the
+///		given depth with the given branching factor, with numeric leaves.
+///	</summary>
+nlohmann::json BuildPMPResultsTree(
+	size_t sDepth,
+	size_t sBranch
+) {
+	nlohmann::json jnode;
+	for (size_t s = 0; s < sBranch; s++) {
+		char szName[32];
+		snprintf(szName, sizeof(szName), "key%04lu", s);
+		if (sDepth == 0) {
+			jnode[szName] = 0.125 * static_cast<double>(s);
+		} else {
+			jnode[szName] = BuildPMPResultsTree(sDepth - 1, sBranch);
+		}
+	}
+	return jnode;
+}
+
+///	<summary>
+///		Build a synthetic PMP metrics JSON document.
+///	</summary>
+std::string BuildPMPFixture() {
+	nlohmann::json jpmp;
+	jpmp["SCHEMA"]["name"] = "CMEC";
+	jpmp["DIMENSIONS"]["json_structure"] =
+		nlohmann::json::array({"model", "metric", "statistic"});
+	jpmp["RESULTS"] = BuildPMPResultsTree(3, 16);
+	return jpmp.dump();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Benchmark nlohmann::json::parse on the given document.
+///	</summary>
+void BenchJSONParse(
+	const char * szName,
+	const std::string & strJSON
+) {
+	RunBenchmark(
+		szName,
+		static_cast<double>(strJSON.length()) / (1024.0 * 1024.0),
+		"MB/s",
+		[&]() {
+			nlohmann::json j = nlohmann::json::parse(strJSON);
+			g_dSink += static_cast<double>(j.size());
+		});
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Benchmark DataArray fill-and-reduce loops.
+///	</summary>
+void BenchDataArrays() {
+	static const size_t sElements1D = (1 << 22);
+	static const size_t sRows2D = 2048;
+	static const size_t sCols2D = 2048;
+	static const size_t sDim3D = 160;
+
+	{
+		DataArray1D<double> dData(sElements1D);
+		RunBenchmark(
+			"dataarray1d/fill-sum",
+			static_cast<double>(sElements1D) / 1.0e6,
+			"M elem/s",
+			[&]() {
+				for (size_t i = 0; i < sElements1D; i++) {
+					dData(i) = 0.5 * static_cast<double>(i);
+				}
+				g_dSink += dData.Sum();
+			});
+	}
+
+	{
+		DataArray2D<double> dData(sRows2D, sCols2D);
+		RunBenchmark(
+			"dataarray2d/fill-sum",
+			static_cast<double>(sRows2D * sCols2D) / 1.0e6,
+			"M elem/s",
+			[&]() {
+				for (size_t i = 0; i < sRows2D; i++) {
+					for (size_t j = 0; j < sCols2D; j++) {
+						dData(i,j) = 0.5 * static_cast<double>(i + j);
+					}
+				}
+				g_dSink += dData.Sum();
+			});
+	}
+
+	{
+		DataArray3D<double> dData(sDim3D, sDim3D, sDim3D);
+		RunBenchmark(
+			"dataarray3d/fill-minmax",
+			static_cast<double>(sDim3D * sDim3D * sDim3D) / 1.0e6,
+			"M elem/s",
+			[&]() {
+				for (size_t i = 0; i < sDim3D; i++) {
+					for (size_t j = 0; j < sDim3D; j++) {
+						for (size_t k = 0; k < sDim3D; k++) {
+							dData(i,j,k) =
+								0.5 * static_cast<double>(i + j) - static_cast<double>(k);
+						}
+					}
+				}
+				g_dSink += dData.Max() - dData.Min();
+			});
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Benchmark Time arithmetic from TimeObj.
+///	</summary>
+void BenchTimeArithmetic() {
+	static const size_t sOps = 1000000;
+	static const size_t sArraySize = (1 << 18);
+
+	{
+		RunBenchmark(
+			"time/add-seconds-noleap",
+			static_cast<double>(sOps) / 1.0e6,
+			"M ops/s",
+			[&]() {
+				Time time(2000, 0, 1, 0, 0, Time::CalendarNoLeap);
+				for (size_t s = 0; s < sOps; s++) {
+					time.AddSeconds(86461);
+				}
+				g_dSink += static_cast<double>(time.GetYear());
+			});
+	}
+
+	{
+		RunBenchmark(
+			"time/add-seconds-gregorian",
+			static_cast<double>(sOps) / 1.0e6,
+			"M ops/s",
+			[&]() {
+				Time time(2000, 0, 1, 0, 0, Time::CalendarGregorian);
+				for (size_t s = 0; s < sOps; s++) {
+					time.AddSeconds(86461);
+				}
+				g_dSink += static_cast<double>(time.GetYear());
+			});
+	}
+
+	{
+		DataArray1D<double> dSeconds(sArraySize);
+		for (size_t s = 0; s < sArraySize; s++) {
+			dSeconds(s) = 3600.0 * static_cast<double>(s);
+		}
+		Time timeBase(2000, 0, 1, 0, 0, Time::CalendarGregorian);
+		std::vector<Time> vecTimes;
+		RunBenchmark(
+			"time/add-seconds-array",
+			static_cast<double>(sArraySize) / 1.0e6,
+			"M ops/s",
+			[&]() {
+				Time::AddSecondsToTimeArray(timeBase, dSeconds, vecTimes);
+				g_dSink += static_cast<double>(vecTimes.size());
+			});
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Benchmark LookupVectorHeap and LookupVectorHash insert and lookup.
+///	</summary>
+void BenchLookupVectors() {
+	static const size_t sKeyCount = 100000;
+
+	std::vector<std::string> vecKeys;
+	vecKeys.reserve(sKeyCount);
+	for (size_t s = 0; s < sKeyCount; s++) {
+		char szKey[32];
+		snprintf(szKey, sizeof(szKey), "key%08lu", s);
+		vecKeys.push_back(szKey);
+	}
+
+	{
+		RunBenchmark(
+			"lookupvectorheap/insert",
+			static_cast<double>(sKeyCount) / 1.0e6,
+			"M ops/s",
+			[&]() {
+				LookupVectorHeap<std::string, int> lookup;
+				for (size_t s = 0; s < sKeyCount; s++) {
+					lookup.insert(vecKeys[s], new int(static_cast<int>(s)));
+				}
+				g_dSink += static_cast<double>(lookup.size());
+			});
+	}
+
+	{
+		LookupVectorHeap<std::string, int> lookup;
+		for (size_t s = 0; s < sKeyCount; s++) {
+			lookup.insert(vecKeys[s], new int(static_cast<int>(s)));
+		}
+		RunBenchmark(
+			"lookupvectorheap/find",
+			static_cast<double>(sKeyCount) / 1.0e6,
+			"M ops/s",
+			[&]() {
+				double dTotal = 0.0;
+				for (size_t s = 0; s < sKeyCount; s++) {
+					auto it = lookup.find(vecKeys[s]);
+					dTotal += static_cast<double>(**it);
+				}
+				g_dSink += dTotal;
+			});
+	}
+
+	{
+		RunBenchmark(
+			"lookupvectorhash/insert",
+			static_cast<double>(sKeyCount) / 1.0e6,
+			"M ops/s",
+			[&]() {
+				LookupVectorHash<std::string, int> lookup;
+				lookup.reserve(sKeyCount);
+				for (size_t s = 0; s < sKeyCount; s++) {
+					lookup.insert(vecKeys[s], static_cast<int>(s));
+				}
+				g_dSink += static_cast<double>(lookup.size());
+			});
+	}
+
+	{
+		LookupVectorHash<std::string, int> lookup;
+		lookup.reserve(sKeyCount);
+		for (size_t s = 0; s < sKeyCount; s++) {
+			lookup.insert(vecKeys[s], static_cast<int>(s));
+		}
+		RunBenchmark(
+			"lookupvectorhash/find",
+			static_cast<double>(sKeyCount) / 1.0e6,
+			"M ops/s",
+			[&]() {
+				double dTotal = 0.0;
+				for (size_t s = 0; s < sKeyCount; s++) {
+					auto it = lookup.find(vecKeys[s]);
+					dTotal += static_cast<double>(**it);
+				}
+				g_dSink += dTotal;
+			});
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+int main(int argc, char ** argv) {
+
+	try {
+
+	static const ArgumentFlagSpec aBenchFlagSpec[] = {
+		{"json", 1}
+	};
+
+	ArgumentParser parser(
+		aBenchFlagSpec,
+		sizeof(aBenchFlagSpec) / sizeof(aBenchFlagSpec[0]));
+
+	if (!parser.Parse(1, argc, argv)) {
+		char szParseError[128];
+		parser.GetErrorMessage(szParseError, sizeof(szParseError));
+		printf("%s\n", szParseError);
+		printf("Usage: %s [-json <report file>]\n", argv[0]);
+		return 1;
+	}
+
+	printf("CMEC driver benchmark suite\n");
+	printf("------------------------------------------------------------\n");
+
+	printf("json::parse\n");
+	BenchJSONParse("json/parse/library", BuildLibraryFixture(512));
+	BenchJSONParse("json/parse/toc", BuildTOCFixture(128));
+	BenchJSONParse("json/parse/pmp", BuildPMPFixture());
+
+	printf("DataArray fill-and-reduce\n");
+	BenchDataArrays();
+
+	printf("Time arithmetic\n");
+	BenchTimeArithmetic();
+
+	printf("LookupVector insert/lookup\n");
+	BenchLookupVectors();
+
+	printf("------------------------------------------------------------\n");
+
+	// Write the JSON report, if requested
+	const char * szReportFile = parser.GetFlagValue("json");
+	if (szReportFile != NULL) {
+		nlohmann::json jreport;
+		jreport["benchmarks"] = nlohmann::json::value_t::object;
+		for (size_t s = 0; s < g_vecResults.size(); s++) {
+			nlohmann::json & jbench =
+				jreport["benchmarks"][g_vecResults[s].strName];
+			jbench["iterations"] = g_vecResults[s].nIterations;
+			jbench["seconds"] = g_vecResults[s].dSeconds;
+			jbench["rate"] = g_vecResults[s].dRate;
+			jbench["unit"] = g_vecResults[s].strUnit;
+		}
+
+		std::ofstream ofreport(szReportFile);
+		if (!ofreport.is_open()) {
+			printf("ERROR: Unable to open \"%s\" for writing\n",
+				szReportFile);
+			return 1;
+		}
+		ofreport << jreport.dump(4) << std::endl;
+		printf("Benchmark report written to \"%s\"\n", szReportFile);
+	}
+
+	return 0;
+
+	} catch(Exception & e) {
+		std::cout << std::endl << e.ToString() << std::endl;
+		return 1;
+
+	} catch(...) {
+		return 1;
+	}
+}
@@ -0,0 +1,283 @@
+///////////////////////////////////////////////////////////////////////////////
+///
+///	\file    ArgumentParser.h
+///	\author  Paul Ullrich
+///	\version September 1, 2026
+///
+///	<remarks>
+///		Copyright (c) 2020 Paul Ullrich
+///
+///		Distributed under the BSD 3-Clause License.
+///		(See accompanying file LICENSE)
+///	</remarks>
+
+#ifndef _ARGUMENTPARSER_H_
+#define _ARGUMENTPARSER_H_
+
+///////////////////////////////////////////////////////////////////////////////
+
+#include "Exception.h"
+
+#include <cstdio>
+#include <cstring>
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Specification of one command line flag:  the flag name (without
+///		the leading dash) and the number of values it consumes.
+///	</summary>
+struct ArgumentFlagSpec {
+	const char * szFlag;
+	int nValues;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		A zero-allocation command line parser.  Flags are validated
+///		against a static ArgumentFlagSpec table and recorded as pointers
+///		into argv; raw arguments follow flags, as in the driver's
+///		original parser.  No heap allocation is performed:  all state
+///		lives in fixed-size arrays of argv pointers, so parsing costs
+///		nothing at startup when the tool is executed thousands of times
+///		per sweep.
+///	</summary>
+class ArgumentParser {
+
+public:
+	///	<summary>
+	///		Maximum number of distinct flags on one command line.
+	///	</summary>
+	static const size_t MaxFlags = 16;
+
+	///	<summary>
+	///		Maximum number of raw arguments on one command line.
+	///	</summary>
+	static const size_t MaxArguments = 64;
+
+public:
+	///	<summary>
+	///		Constructor.  The spec table must outlive the parser.
+	///	</summary>
+	ArgumentParser(
+		const ArgumentFlagSpec * pSpec,
+		size_t sSpecCount
+	) :
+		m_pSpec(pSpec),
+		m_sSpecCount(sSpecCount),
+		m_sFlagCount(0),
+		m_sArgumentCount(0),
+		m_szError(NULL),
+		m_szErrorDetail(NULL)
+	{ }
+
+public:
+	///	<summary>
+	///		Parse the given argv range.  Returns false on a malformed
+	///		command line, in which case GetErrorMessage() describes the
+	///		problem.
+	///	</summary>
+	bool Parse(
+		int ibegin,
+		int iend,
+		char ** argv
+	) {
+		// Flags occur before raw arguments
+		bool fReadingFlags = true;
+
+		for (int c = ibegin; c < iend; c++) {
+			_ASSERT(strlen(argv[c]) >= 1);
+
+			// Handle flags
+			if (argv[c][0] == '-') {
+				if (!fReadingFlags) {
+					return SetError("Malformed argument", argv[c]);
+				}
+				if (argv[c][1] == '\0') {
+					continue;
+				}
+				const char * szFlag = argv[c] + 1;
+
+				size_t sSpec = 0;
+				for (; sSpec < m_sSpecCount; sSpec++) {
+					if (strcmp(m_pSpec[sSpec].szFlag, szFlag) == 0) {
+						break;
+					}
+				}
+				if (sSpec == m_sSpecCount) {
+					return SetError("Invalid flag", szFlag);
+				}
+				if (FindFlag(szFlag) != MaxFlags) {
+					return SetError("Duplicated flag", szFlag);
+				}
+				if (m_sFlagCount == MaxFlags) {
+					return SetError("Too many flags", szFlag);
+				}
+
+				int nValues = m_pSpec[sSpec].nValues;
+				if (c + nValues >= iend) {
+					return SetError("Insufficient arguments for flag", szFlag);
+				}
+				for (int d = 0; d < nValues; d++) {
+					_ASSERT(strlen(argv[c+d+1]) >= 1);
+					if (argv[c+d+1][0] == '-') {
+						return SetError("Invalid arguments for flag", szFlag);
+					}
+				}
+
+				// Values are contiguous in argv; record their position
+				m_sFlagSpecIx[m_sFlagCount] = sSpec;
+				m_szFlagValues[m_sFlagCount] = argv + c + 1;
+				m_sFlagCount++;
+
+				c += nValues;
+
+			// Handle raw arguments
+			} else {
+				if (fReadingFlags) {
+					fReadingFlags = false;
+				}
+
+				if (m_sArgumentCount == MaxArguments) {
+					return SetError("Too many arguments", argv[c]);
+				}
+				m_szArguments[m_sArgumentCount] = argv[c];
+				m_sArgumentCount++;
+			}
+		}
+
+		return true;
+	}
+
+public:
+	///	<summary>
+	///		Determine if the given flag was present.
+	///	</summary>
+	bool HasFlag(const char * szFlag) const {
+		return (FindFlag(szFlag) != MaxFlags);
+	}
+
+	///	<summary>
+	///		Get the given value of the given flag, or NULL if the flag
+	///		was not present.
+	///	</summary>
+	const char * GetFlagValue(
+		const char * szFlag,
+		size_t sValue = 0
+	) const {
+		size_t sFlag = FindFlag(szFlag);
+		if (sFlag == MaxFlags) {
+			return NULL;
+		}
+		_ASSERT(sValue <
+			static_cast<size_t>(m_pSpec[m_sFlagSpecIx[sFlag]].nValues));
+		return m_szFlagValues[sFlag][sValue];
+	}
+
+	///	<summary>
+	///		Number of raw arguments.
+	///	</summary>
+	size_t GetArgumentCount() const {
+		return m_sArgumentCount;
+	}
+
+	///	<summary>
+	///		Get the given raw argument.
+	///	</summary>
+	const char * GetArgument(size_t s) const {
+		_ASSERT(s < m_sArgumentCount);
+		return m_szArguments[s];
+	}
+
+	///	<summary>
+	///		Write a description of the parse error into the given buffer.
+	///	</summary>
+	void GetErrorMessage(
+		char * szBuffer,
+		size_t sBufferSize
+	) const {
+		if (m_szError == NULL) {
+			snprintf(szBuffer, sBufferSize, "No error");
+		} else {
+			snprintf(szBuffer, sBufferSize, "Error: %s \"%s\"",
+				m_szError, m_szErrorDetail);
+		}
+	}
+
+private:
+	///	<summary>
+	///		Find the index of the given flag among parsed flags, or
+	///		MaxFlags if absent.
+	///	</summary>
+	size_t FindFlag(const char * szFlag) const {
+		for (size_t s = 0; s < m_sFlagCount; s++) {
+			if (strcmp(m_pSpec[m_sFlagSpecIx[s]].szFlag, szFlag) == 0) {
+				return s;
+			}
+		}
+		return MaxFlags;
+	}
+
+	///	<summary>
+	///		Record a parse error.  Always returns false.
+	///	</summary>
+	bool SetError(
+		const char * szError,
+		const char * szErrorDetail
+	) {
+		m_szError = szError;
+		m_szErrorDetail = szErrorDetail;
+		return false;
+	}
+
+private:
+	///	<summary>
+	///		The flag specification table.
+	///	</summary>
+	const ArgumentFlagSpec * m_pSpec;
+
+	///	<summary>
+	///		Number of entries in the flag specification table.
+	///	</summary>
+	size_t m_sSpecCount;
+
+	///	<summary>
+	///		Specification index of each parsed flag.
+	///	</summary>
+	size_t m_sFlagSpecIx[MaxFlags];
+
+	///	<summary>
+	///		Pointer to the argv position of each parsed flag's values.
+	///	</summary>
+	char ** m_szFlagValues[MaxFlags];
+
+	///	<summary>
+	///		Number of parsed flags.
+	///	</summary>
+	size_t m_sFlagCount;
+
+	///	<summary>
+	///		Pointers to raw arguments in argv.
+	///	</summary>
+	const char * m_szArguments[MaxArguments];
+
+	///	<summary>
+	///		Number of raw arguments.
+	///	</summary>
+	size_t m_sArgumentCount;
+
+	///	<summary>
+	///		Description of the parse error, if one occurred.
+	///	</summary>
+	const char * m_szError;
+
+	///	<summary>
+	///		Offending flag or argument, if a parse error occurred.
+	///	</summary>
+	const char * m_szErrorDetail;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+#endif // _ARGUMENTPARSER_H_
@@ -0,0 +1,142 @@
+///////////////////////////////////////////////////////////////////////////////
+///
+///	\file    BufferedOutputFile.h
+///	\author  Paul Ullrich
+///	\version September 1, 2026
+///
+///	<remarks>
+///		Copyright (c) 2020 Paul Ullrich
+///
+///		Distributed under the BSD 3-Clause License.
+///		(See accompanying file LICENSE)
+///	</remarks>
+
+#ifndef _BUFFEREDOUTPUTFILE_H_
+#define _BUFFEREDOUTPUTFILE_H_
+
+///////////////////////////////////////////////////////////////////////////////
+
+#include "Exception.h"
+
+#include <fstream>
+#include <string>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		An output file stream with a large explicit write buffer.  By
+///		default an ofstream drains through a small library buffer, which
+///		turns serialization of a large document into a long sequence of
+///		small write syscalls; this class installs its own buffer so output
+///		accumulates in memory and reaches the kernel in large blocks.
+///	</summary>
+class BufferedOutputFile {
+
+public:
+	///	<summary>
+	///		Default size of the write buffer, in bytes.
+	///	</summary>
+	static const size_t DefaultBufferSize = 1024 * 1024;
+
+public:
+	///	<summary>
+	///		Constructor.
+	///	</summary>
+	BufferedOutputFile(
+		size_t sBufferSize = DefaultBufferSize
+	) :
+		m_vecBuffer(sBufferSize)
+	{ }
+
+	///	<summary>
+	///		Constructor which opens the given file.
+	///	</summary>
+	BufferedOutputFile(
+		const std::string & strFilename,
+		size_t sBufferSize = DefaultBufferSize
+	) :
+		m_vecBuffer(sBufferSize)
+	{
+		Open(strFilename);
+	}
+
+	///	<summary>
+	///		Destructor.
+	///	</summary>
+	~BufferedOutputFile() {
+		Close();
+	}
+
+private:
+	///	<summary>
+	///		Copying an output file is not permitted.
+	///	</summary>
+	BufferedOutputFile(const BufferedOutputFile &);
+	BufferedOutputFile & operator= (const BufferedOutputFile &);
+
+public:
+	///	<summary>
+	///		Open the given file for writing.
+	///	</summary>
+	void Open(
+		const std::string & strFilename
+	) {
+		Close();
+
+		// The buffer must be installed before the file is opened
+		m_ofs.rdbuf()->pubsetbuf(&(m_vecBuffer[0]), m_vecBuffer.size());
+
+		m_ofs.open(strFilename.c_str(), std::ios::out);
+		if (!m_ofs.is_open()) {
+			_EXCEPTION1("Unable to open file \"%s\" for writing",
+				strFilename.c_str());
+		}
+	}
+
+	///	<summary>
+	///		Flush the buffer and close the file.
+	///	</summary>
+	void Close() {
+		if (m_ofs.is_open()) {
+			m_ofs.close();
+		}
+	}
+
+public:
+	///	<summary>
+	///		Determine if a file is currently open.
+	///	</summary>
+	bool IsOpen() const {
+		return m_ofs.is_open();
+	}
+
+	///	<summary>
+	///		The underlying output stream.
+	///	</summary>
+	std::ostream & Stream() {
+		return m_ofs;
+	}
+
+	///	<summary>
+	///		Implicit conversion to the underlying output stream.
+	///	</summary>
+	operator std::ostream & () {
+		return m_ofs;
+	}
+
+private:
+	///	<summary>
+	///		The write buffer.
+	///	</summary>
+	std::vector<char> m_vecBuffer;
+
+	///	<summary>
+	///		The underlying file stream.
+	///	</summary>
+	std::ofstream m_ofs;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+#endif // _BUFFEREDOUTPUTFILE_H_
@@ -21,6 +21,7 @@
 #include "Announce.h"
 #include "Exception.h"
 
+#include <algorithm>
 #include <vector>
 #include <string>
 #include <cstdlib>
@@ -461,6 +462,72 @@ public:
 
 ///////////////////////////////////////////////////////////////////////////////
 
+///	<summary>
+///		A sorted-table index over registered command line parameters,
+///		built once at parse start.  Each argv token is then matched by
+///		binary search over raw character pointers, so lookup cost is
+///		logarithmic in the flag count and no per-argument std::string is
+///		constructed.
+///	</summary>
+class CommandLineParameterIndex {
+
+protected:
+	///	<summary>
+	///		One index entry:  a view of the parameter name (owned by the
+	///		parameter object) and the parameter's position in the
+	///		registration order.
+	///	</summary>
+	struct IndexEntry {
+		const char * szName;
+		int iParameter;
+	};
+
+public:
+	///	<summary>
+	///		Build the index from the registered parameters.
+	///	</summary>
+	void Build(const std::vector<CommandLineParameter *> & vecParameters) {
+		m_vecEntries.resize(vecParameters.size());
+		for (size_t s = 0; s < vecParameters.size(); s++) {
+			m_vecEntries[s].szName = vecParameters[s]->m_strName.c_str();
+			m_vecEntries[s].iParameter = static_cast<int>(s);
+		}
+		std::sort(m_vecEntries.begin(), m_vecEntries.end(),
+			[](const IndexEntry & a, const IndexEntry & b) {
+				return (strcmp(a.szName, b.szName) < 0);
+			});
+	}
+
+	///	<summary>
+	///		Find the parameter with the given name.  Returns the index of
+	///		the parameter in registration order, or (-1) if absent.
+	///	</summary>
+	int Find(const char * szArg) const {
+		size_t sBegin = 0;
+		size_t sEnd = m_vecEntries.size();
+		while (sBegin < sEnd) {
+			size_t sMid = sBegin + (sEnd - sBegin) / 2;
+			int iCompare = strcmp(m_vecEntries[sMid].szName, szArg);
+			if (iCompare == 0) {
+				return m_vecEntries[sMid].iParameter;
+			} else if (iCompare < 0) {
+				sBegin = sMid + 1;
+			} else {
+				sEnd = sMid;
+			}
+		}
+		return (-1);
+	}
+
+private:
+	///	<summary>
+	///		Index entries, sorted by name.
+	///	</summary>
+	std::vector<IndexEntry> m_vecEntries;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
 ///	<summary>
 ///		Begin the definition of command line parameters.
 ///	</summary>
@@ -556,42 +623,38 @@ public:
 ///		Begin the loop for command line parameters.
 ///	</summary>
 #define ParseCommandLine(argc, argv) \
+	CommandLineParameterIndex _indexParameters; \
+	_indexParameters.Build(_vecParameters); \
     for(int _command = 1; _command < argc; _command++) { \
-		bool _found = false; \
-		for(int _p = 0; _p < _vecParameters.size(); _p++) { \
-			if (_vecParameters[_p]->m_strName == argv[_command]) { \
-				_found = true; \
-				_vecParameters[_p]->Activate(); \
-				int _z; \
-				if (_vecParameters[_p]->GetValueCount() >= argc - _command) { \
-					Announce("Error: Insufficient values for option %s", \
-						argv[_command]); \
-					_errorCommandLine = true; \
-					_command = argc; \
-					break; \
-				} \
-				for (_z = 0; _z < _vecParameters[_p]->GetValueCount(); _z++) { \
-					if ((_command + _z + 1 < argc) && \
-						(strlen(argv[_command + _z + 1]) > 2) && \
-						(argv[_command + _z + 1][0] == '-') && \
-						(argv[_command + _z + 1][1] == '-') \
-					) break; \
-					_command++; \
-					_vecParameters[_p]->SetValue(_z, argv[_command]); \
-				} \
-				if ((_vecParameters[_p]->GetValueCount() >= 0) && \
-					(_z != _vecParameters[_p]->GetValueCount()) \
-				) { \
-					Announce("Error: Insufficient values for option %s", \
-						argv[_command]); \
-					_errorCommandLine = true; \
-					_command = argc; \
-					break; \
-				} \
-			} \
-		} \
-		if (!_found) { \
+		int _p = _indexParameters.Find(argv[_command]); \
+		if (_p < 0) { \
 			Announce("Warning: Invalid parameter \"%s\"", argv[_command]); \
+			continue; \
+		} \
+		_vecParameters[_p]->Activate(); \
+		int _z; \
+		if (_vecParameters[_p]->GetValueCount() >= argc - _command) { \
+			Announce("Error: Insufficient values for option %s", \
+				argv[_command]); \
+			_errorCommandLine = true; \
+			break; \
+		} \
+		for (_z = 0; _z < _vecParameters[_p]->GetValueCount(); _z++) { \
+			if ((_command + _z + 1 < argc) && \
+				(strlen(argv[_command + _z + 1]) > 2) && \
+				(argv[_command + _z + 1][0] == '-') && \
+				(argv[_command + _z + 1][1] == '-') \
+			) break; \
+			_command++; \
+			_vecParameters[_p]->SetValue(_z, argv[_command]); \
+		} \
+		if ((_vecParameters[_p]->GetValueCount() >= 0) && \
+			(_z != _vecParameters[_p]->GetValueCount()) \
+		) { \
+			Announce("Error: Insufficient values for option %s", \
+				argv[_command]); \
+			_errorCommandLine = true; \
+			break; \
 		} \
 	}
 
@@ -0,0 +1,452 @@
+///////////////////////////////////////////////////////////////////////////////
+///
+///	\file    CompressedFile.h
+///	\author  Paul Ullrich
+///	\version September 1, 2026
+///
+///	<remarks>
+///		Copyright (c) 2020 Paul Ullrich
+///
+///		Distributed under the BSD 3-Clause License.
+///		(See accompanying file LICENSE)
+///	</remarks>
+
+#ifndef _COMPRESSEDFILE_H_
+#define _COMPRESSEDFILE_H_
+
+///////////////////////////////////////////////////////////////////////////////
+
+#include "Exception.h"
+#include "BufferedOutputFile.h"
+#include "MemoryMappedFile.h"
+
+#include <climits>
+#include <cstring>
+#include <ostream>
+#include <streambuf>
+#include <string>
+#include <vector>
+
+#include <zlib.h>
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		A read-only view of a file that transparently decompresses gzip
+///		content, detected by magic bytes.  Uncompressed files are served
+///		directly from a memory mapping; gzip files are inflated once into
+///		an in-memory buffer.  The interface mirrors MemoryMappedFile, so
+///		parse call sites work unchanged on either representation.
+///	</summary>
+class CompressedInputFile {
+
+public:
+	///	<summary>
+	///		Constructor.
+	///	</summary>
+	CompressedInputFile()
+	{ }
+
+	///	<summary>
+	///		Constructor which opens the given file.
+	///	</summary>
+	CompressedInputFile(
+		const std::string & strFilename
+	) {
+		Open(strFilename);
+	}
+
+private:
+	///	<summary>
+	///		Copying an input file is not permitted.
+	///	</summary>
+	CompressedInputFile(const CompressedInputFile &);
+	CompressedInputFile & operator= (const CompressedInputFile &);
+
+public:
+	///	<summary>
+	///		Check a buffer for the gzip magic bytes.
+	///	</summary>
+	static bool IsGZip(const char * pData, size_t sSize) {
+		return ((sSize >= 2) &&
+		        (static_cast<unsigned char>(pData[0]) == 0x1f) &&
+		        (static_cast<unsigned char>(pData[1]) == 0x8b));
+	}
+
+	///	<summary>
+	///		Open the given file, decompressing it if it is gzip.
+	///	</summary>
+	void Open(
+		const std::string & strFilename
+	) {
+		Close();
+
+		m_mmap.Open(strFilename);
+
+		if (!IsGZip(m_mmap.begin(), m_mmap.size())) {
+			return;
+		}
+
+		// Inflate the mapped contents into memory.  windowBits 16+MAX_WBITS
+		// selects gzip framing.
+		z_stream zs;
+		memset(&zs, 0, sizeof(zs));
+		if (inflateInit2(&zs, 16 + MAX_WBITS) != Z_OK) {
+			_EXCEPTION1("Unable to initialize decompression of \"%s\"",
+				strFilename.c_str());
+		}
+
+		// zlib's avail_in and avail_out counters are only 32 bits wide,
+		// so the mapped input is fed (and the output buffer exposed) in
+		// chunks of at most UINT_MAX bytes; a single up-front
+		// assignment would silently truncate files of 4 GiB or more
+		size_t sInputOffset = 0;
+
+		// Grow the output buffer geometrically from an initial guess of
+		// four times the compressed size
+		m_vecData.resize(4 * m_mmap.size() + 1024);
+		for (;;) {
+			if (zs.avail_in == 0) {
+				size_t sInputChunk = m_mmap.size() - sInputOffset;
+				if (sInputChunk > static_cast<size_t>(UINT_MAX)) {
+					sInputChunk = static_cast<size_t>(UINT_MAX);
+				}
+				zs.next_in = reinterpret_cast<Bytef *>(
+					const_cast<char *>(m_mmap.begin() + sInputOffset));
+				zs.avail_in = static_cast<uInt>(sInputChunk);
+				sInputOffset += sInputChunk;
+			}
+
+			size_t sOutputChunk = m_vecData.size() - zs.total_out;
+			if (sOutputChunk > static_cast<size_t>(UINT_MAX)) {
+				sOutputChunk = static_cast<size_t>(UINT_MAX);
+			}
+			zs.next_out =
+				reinterpret_cast<Bytef *>(&(m_vecData[zs.total_out]));
+			zs.avail_out = static_cast<uInt>(sOutputChunk);
+
+			int iResult = inflate(&zs, Z_NO_FLUSH);
+			if (iResult == Z_STREAM_END) {
+				break;
+			}
+			if ((iResult != Z_OK) && (iResult != Z_BUF_ERROR)) {
+				inflateEnd(&zs);
+				_EXCEPTION2("Corrupt gzip file \"%s\": %s",
+					strFilename.c_str(),
+					(zs.msg != NULL)?(zs.msg):("decompression error"));
+			}
+			if (zs.avail_out == 0) {
+				// The exposed window is exhausted; grow the buffer only
+				// if it is actually full (the window may have been
+				// capped below the remaining buffer space)
+				if (zs.total_out == m_vecData.size()) {
+					m_vecData.resize(2 * m_vecData.size());
+				}
+			} else if ((zs.avail_in == 0) &&
+			           (sInputOffset == m_mmap.size())
+			) {
+				inflateEnd(&zs);
+				_EXCEPTION1("Truncated gzip file \"%s\"",
+					strFilename.c_str());
+			}
+		}
+		m_vecData.resize(zs.total_out);
+		inflateEnd(&zs);
+
+		m_mmap.Close();
+	}
+
+	///	<summary>
+	///		Close the file and release its contents.
+	///	</summary>
+	void Close() {
+		m_mmap.Close();
+		std::vector<char>().swap(m_vecData);
+	}
+
+public:
+	///	<summary>
+	///		Determine if a file is currently open.
+	///	</summary>
+	bool IsOpen() const {
+		return (m_mmap.IsOpen() || (m_vecData.size() != 0));
+	}
+
+	///	<summary>
+	///		Pointer to the beginning of the (decompressed) file contents.
+	///	</summary>
+	const char * begin() const {
+		if (m_mmap.IsOpen()) {
+			return m_mmap.begin();
+		}
+		return &(m_vecData[0]);
+	}
+
+	///	<summary>
+	///		Pointer one past the end of the (decompressed) file contents.
+	///	</summary>
+	const char * end() const {
+		if (m_mmap.IsOpen()) {
+			return m_mmap.end();
+		}
+		return &(m_vecData[0]) + m_vecData.size();
+	}
+
+	///	<summary>
+	///		Size of the (decompressed) file contents, in bytes.
+	///	</summary>
+	size_t size() const {
+		if (m_mmap.IsOpen()) {
+			return m_mmap.size();
+		}
+		return m_vecData.size();
+	}
+
+private:
+	///	<summary>
+	///		Memory mapping serving uncompressed files.
+	///	</summary>
+	MemoryMappedFile m_mmap;
+
+	///	<summary>
+	///		Decompressed contents of a gzip file.
+	///	</summary>
+	std::vector<char> m_vecData;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		A stream buffer that deflates its contents to a gzip file.
+///		Output accumulates in a large buffer and reaches zlib in large
+///		blocks, mirroring the write pattern of BufferedOutputFile.
+///	</summary>
+class GZipOutputStreamBuf : public std::streambuf {
+
+public:
+	///	<summary>
+	///		Constructor.
+	///	</summary>
+	GZipOutputStreamBuf() :
+		m_gzfile(NULL)
+	{ }
+
+	///	<summary>
+	///		Destructor.  Flushes and closes the file.
+	///	</summary>
+	~GZipOutputStreamBuf() {
+		Close();
+	}
+
+public:
+	///	<summary>
+	///		Open the given file for compressed writing.
+	///	</summary>
+	void Open(
+		const std::string & strFilename,
+		size_t sBufferSize
+	) {
+		Close();
+
+		m_gzfile = gzopen(strFilename.c_str(), "wb");
+		if (m_gzfile == NULL) {
+			_EXCEPTION1("Unable to open file \"%s\" for writing",
+				strFilename.c_str());
+		}
+
+		m_vecBuffer.resize(sBufferSize);
+		setp(&(m_vecBuffer[0]), &(m_vecBuffer[0]) + m_vecBuffer.size());
+	}
+
+	///	<summary>
+	///		Flush the buffer and close the file.
+	///	</summary>
+	void Close() {
+		if (m_gzfile != NULL) {
+			FlushBuffer();
+			gzclose(m_gzfile);
+			m_gzfile = NULL;
+		}
+	}
+
+	///	<summary>
+	///		Determine if a file is currently open.
+	///	</summary>
+	bool IsOpen() const {
+		return (m_gzfile != NULL);
+	}
+
+protected:
+	///	<summary>
+	///		Deflate the buffered contents.
+	///	</summary>
+	void FlushBuffer() {
+		std::ptrdiff_t nCount = pptr() - pbase();
+		if (nCount > 0) {
+			if (gzwrite(m_gzfile, pbase(), static_cast<unsigned>(nCount))
+					!= static_cast<int>(nCount)
+			) {
+				_EXCEPTIONT("Unable to write to gzip file");
+			}
+			setp(pbase(), epptr());
+		}
+	}
+
+	virtual int_type overflow(int_type c) {
+		FlushBuffer();
+		if (c != traits_type::eof()) {
+			*pptr() = traits_type::to_char_type(c);
+			pbump(1);
+		}
+		return c;
+	}
+
+	virtual int sync() {
+		FlushBuffer();
+		return 0;
+	}
+
+private:
+	///	<summary>
+	///		The underlying gzip file.
+	///	</summary>
+	gzFile m_gzfile;
+
+	///	<summary>
+	///		The write buffer.
+	///	</summary>
+	std::vector<char> m_vecBuffer;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		An output file that transparently compresses when the filename
+///		carries a ".gz" suffix and otherwise behaves as a
+///		BufferedOutputFile.  The interface mirrors BufferedOutputFile, so
+///		serialization call sites work unchanged on either representation.
+///	</summary>
+class CompressedOutputFile {
+
+public:
+	///	<summary>
+	///		Constructor.
+	///	</summary>
+	CompressedOutputFile(
+		size_t sBufferSize = BufferedOutputFile::DefaultBufferSize
+	) :
+		m_sBufferSize(sBufferSize),
+		m_osCompressed(&m_gzbuf),
+		m_fCompressed(false)
+	{ }
+
+	///	<summary>
+	///		Constructor which opens the given file.
+	///	</summary>
+	CompressedOutputFile(
+		const std::string & strFilename,
+		size_t sBufferSize = BufferedOutputFile::DefaultBufferSize
+	) :
+		m_sBufferSize(sBufferSize),
+		m_osCompressed(&m_gzbuf),
+		m_fCompressed(false)
+	{
+		Open(strFilename);
+	}
+
+private:
+	///	<summary>
+	///		Copying an output file is not permitted.
+	///	</summary>
+	CompressedOutputFile(const CompressedOutputFile &);
+	CompressedOutputFile & operator= (const CompressedOutputFile &);
+
+public:
+	///	<summary>
+	///		Check a filename for a ".gz" suffix.
+	///	</summary>
+	static bool IsCompressedFilename(const std::string & strFilename) {
+		return ((strFilename.length() >= 3) &&
+		        (strFilename.compare(
+					strFilename.length()-3, 3, ".gz") == 0));
+	}
+
+	///	<summary>
+	///		Open the given file for writing.
+	///	</summary>
+	void Open(
+		const std::string & strFilename
+	) {
+		Close();
+
+		m_fCompressed = IsCompressedFilename(strFilename);
+		if (m_fCompressed) {
+			m_gzbuf.Open(strFilename, m_sBufferSize);
+		} else {
+			m_filePlain.Open(strFilename);
+		}
+	}
+
+	///	<summary>
+	///		Flush the buffer and close the file.
+	///	</summary>
+	void Close() {
+		m_gzbuf.Close();
+		m_filePlain.Close();
+	}
+
+public:
+	///	<summary>
+	///		Determine if a file is currently open.
+	///	</summary>
+	bool IsOpen() const {
+		return (m_gzbuf.IsOpen() || m_filePlain.IsOpen());
+	}
+
+	///	<summary>
+	///		The underlying output stream.
+	///	</summary>
+	std::ostream & Stream() {
+		if (m_fCompressed) {
+			return m_osCompressed;
+		}
+		return m_filePlain.Stream();
+	}
+
+	///	<summary>
+	///		Implicit conversion to the underlying output stream.
+	///	</summary>
+	operator std::ostream & () {
+		return Stream();
+	}
+
+private:
+	///	<summary>
+	///		Size of the write buffer, in bytes.
+	///	</summary>
+	size_t m_sBufferSize;
+
+	///	<summary>
+	///		Stream buffer deflating to a gzip file.
+	///	</summary>
+	GZipOutputStreamBuf m_gzbuf;
+
+	///	<summary>
+	///		Output stream over the gzip stream buffer.
+	///	</summary>
+	std::ostream m_osCompressed;
+
+	///	<summary>
+	///		Uncompressed output path.
+	///	</summary>
+	BufferedOutputFile m_filePlain;
+
+	///	<summary>
+	///		Set when writing through the gzip stream buffer.
+	///	</summary>
+	bool m_fCompressed;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+#endif // _COMPRESSEDFILE_H_
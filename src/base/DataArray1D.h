@@ -23,6 +23,7 @@
 
 #include <cstdlib>
 #include <cstring>
+#include <utility>
 
 template <typename T>
 class DataArray1D {
@@ -66,6 +67,19 @@ public:
 		Assign(da);
 	}
 
+	///	<summary>
+	///		Move constructor.
+	///	</summary>
+	DataArray1D(DataArray1D<T> && da) noexcept :
+		m_fOwnsData(da.m_fOwnsData),
+		m_sSize(da.m_sSize),
+		m_data(da.m_data)
+	{
+		da.m_fOwnsData = true;
+		da.m_sSize = 0;
+		da.m_data = NULL;
+	}
+
 	///	<summary>
 	///		Destructor.
 	///	</summary>
@@ -107,11 +121,13 @@ public:
 		if ((m_data == NULL) || (m_sSize != sSize)) {
 			m_sSize = sSize;
 
-			m_data = reinterpret_cast<T *>(malloc(GetByteSize()));
-
-			if (m_data == NULL) {
-				_EXCEPTION1("Failed malloc call (%lu bytes)", GetByteSize());
+			// Align to cache line boundaries for vectorized access
+			void * ptr = NULL;
+			if (posix_memalign(&ptr, 64, GetByteSize()) != 0) {
+				_EXCEPTION1("Failed posix_memalign call (%lu bytes)",
+					GetByteSize());
 			}
+			m_data = reinterpret_cast<T *>(ptr);
 		}
 
 		Zero();
@@ -155,7 +171,7 @@ public:
 	///	</summary>
 	virtual void Detach() {
 		if ((m_fOwnsData) && (m_data != NULL)) {
-			delete[] m_data;
+			free(m_data);
 		}
 		m_fOwnsData = true;
 		m_data = NULL;
@@ -232,6 +248,26 @@ public:
 		return (*this);
 	}
 
+	///	<summary>
+	///		Move assignment operator.
+	///	</summary>
+	DataArray1D<T> & operator= (DataArray1D<T> && da) noexcept {
+		if (this != &da) {
+			Detach();
+			Swap(da);
+		}
+		return (*this);
+	}
+
+	///	<summary>
+	///		Exchange contents with the given DataArray1D.
+	///	</summary>
+	void Swap(DataArray1D<T> & da) noexcept {
+		std::swap(m_fOwnsData, da.m_fOwnsData);
+		std::swap(m_sSize, da.m_sSize);
+		std::swap(m_data, da.m_data);
+	}
+
 public:
 	///	<summary>
 	///		Zero the data content of this object.
@@ -287,6 +323,107 @@ public:
 		}
 	}
 
+public:
+	///	<summary>
+	///		Sum of all data values.  Four independent accumulators are
+	///		used so the loop vectorizes without reassociating a single
+	///		serial dependency chain.
+	///	</summary>
+	T Sum() const {
+		if (!IsAttached()) {
+			_EXCEPTIONT("Attempted operation on unattached DataArray1D");
+		}
+
+		T sum0 = 0; T sum1 = 0; T sum2 = 0; T sum3 = 0;
+		size_t i = 0;
+		for (; i + 4 <= m_sSize; i += 4) {
+			sum0 += m_data[i  ];
+			sum1 += m_data[i+1];
+			sum2 += m_data[i+2];
+			sum3 += m_data[i+3];
+		}
+		for (; i < m_sSize; i++) {
+			sum0 += m_data[i];
+		}
+		return (sum0 + sum1 + sum2 + sum3);
+	}
+
+	///	<summary>
+	///		Minimum of all data values.
+	///	</summary>
+	T Min() const {
+		if (!IsAttached()) {
+			_EXCEPTIONT("Attempted operation on unattached DataArray1D");
+		}
+		if (m_sSize == 0) {
+			_EXCEPTIONT("Attempted Min() on zero-size DataArray1D");
+		}
+
+		T min = m_data[0];
+		for (size_t i = 1; i < m_sSize; i++) {
+			if (m_data[i] < min) {
+				min = m_data[i];
+			}
+		}
+		return min;
+	}
+
+	///	<summary>
+	///		Maximum of all data values.
+	///	</summary>
+	T Max() const {
+		if (!IsAttached()) {
+			_EXCEPTIONT("Attempted operation on unattached DataArray1D");
+		}
+		if (m_sSize == 0) {
+			_EXCEPTIONT("Attempted Max() on zero-size DataArray1D");
+		}
+
+		T max = m_data[0];
+		for (size_t i = 1; i < m_sSize; i++) {
+			if (m_data[i] > max) {
+				max = m_data[i];
+			}
+		}
+		return max;
+	}
+
+	///	<summary>
+	///		Weighted mean of all data values, with weights normalized by
+	///		their sum.
+	///	</summary>
+	T WeightedMean(const DataArray1D<T> & daWeight) const {
+		if (!IsAttached()) {
+			_EXCEPTIONT("Attempted operation on unattached DataArray1D");
+		}
+		if (!daWeight.IsAttached()) {
+			_EXCEPTIONT("Attempted operation on unattached DataArray1D");
+		}
+		if (daWeight.GetRows() != GetRows()) {
+			_EXCEPTIONT("Size mismatch in DataArray1D");
+		}
+
+		T sum0 = 0; T sum1 = 0;
+		T wsum0 = 0; T wsum1 = 0;
+		size_t i = 0;
+		for (; i + 2 <= m_sSize; i += 2) {
+			sum0 += daWeight.m_data[i  ] * m_data[i  ];
+			sum1 += daWeight.m_data[i+1] * m_data[i+1];
+			wsum0 += daWeight.m_data[i  ];
+			wsum1 += daWeight.m_data[i+1];
+		}
+		for (; i < m_sSize; i++) {
+			sum0 += daWeight.m_data[i] * m_data[i];
+			wsum0 += daWeight.m_data[i];
+		}
+
+		T wsum = wsum0 + wsum1;
+		if (wsum == 0) {
+			_EXCEPTIONT("Zero weight sum in WeightedMean() on DataArray1D");
+		}
+		return ((sum0 + sum1) / wsum);
+	}
+
 public:
 	///	<summary>
 	///		Implicit converstion to a pointer.
@@ -19,11 +19,13 @@
 
 ///////////////////////////////////////////////////////////////////////////////
 
+#include "DataArray1D.h"
 #include "Exception.h"
 #include "Subscript.h"
 
 #include <cstdlib>
 #include <cstring>
+#include <utility>
 
 template <typename T>
 class DataArray2D {
@@ -84,6 +86,22 @@ public:
 		}
 	}
 
+	///	<summary>
+	///		Move constructor.
+	///	</summary>
+	DataArray2D(DataArray2D<T> && da) noexcept :
+		m_fOwnsData(da.m_fOwnsData),
+		m_data1D(da.m_data1D)
+	{
+		m_sSize[0] = da.m_sSize[0];
+		m_sSize[1] = da.m_sSize[1];
+
+		da.m_fOwnsData = true;
+		da.m_sSize[0] = 0;
+		da.m_sSize[1] = 0;
+		da.m_data1D = NULL;
+	}
+
 	///	<summary>
 	///		Destructor.
 	///	</summary>
@@ -130,11 +148,13 @@ public:
 			m_sSize[0] = sSize0;
 			m_sSize[1] = sSize1;
 
-			m_data1D = reinterpret_cast<T *>(malloc(GetByteSize()));
-
-			if (m_data1D == NULL) {
-				_EXCEPTION1("Failed malloc call (%lu bytes)", GetByteSize());
+			// Align to cache line boundaries for vectorized access
+			void * ptr = NULL;
+			if (posix_memalign(&ptr, 64, GetByteSize()) != 0) {
+				_EXCEPTION1("Failed posix_memalign call (%lu bytes)",
+					GetByteSize());
 			}
+			m_data1D = reinterpret_cast<T *>(ptr);
 		}
 
 		Zero();
@@ -180,7 +200,7 @@ public:
 	///	</summary>
 	virtual void Detach() {
 		if ((m_fOwnsData) && (m_data1D != NULL)) {
-			delete[] m_data1D;
+			free(m_data1D);
 		}
 		m_fOwnsData = true;
 		m_data1D = NULL;
@@ -273,6 +293,27 @@ public:
 		return (*this);
 	}
 
+	///	<summary>
+	///		Move assignment operator.
+	///	</summary>
+	DataArray2D<T> & operator= (DataArray2D<T> && da) noexcept {
+		if (this != &da) {
+			Detach();
+			Swap(da);
+		}
+		return (*this);
+	}
+
+	///	<summary>
+	///		Exchange contents with the given DataArray2D.
+	///	</summary>
+	void Swap(DataArray2D<T> & da) noexcept {
+		std::swap(m_fOwnsData, da.m_fOwnsData);
+		std::swap(m_sSize[0], da.m_sSize[0]);
+		std::swap(m_sSize[1], da.m_sSize[1]);
+		std::swap(m_data1D, da.m_data1D);
+	}
+
 public:
 	///	<summary>
 	///		Zero the data content of this object.
@@ -335,6 +376,177 @@ public:
 		}
 	}
 
+public:
+	///	<summary>
+	///		Sum of all data values.  Four independent accumulators are
+	///		used so the loop vectorizes without reassociating a single
+	///		serial dependency chain.
+	///	</summary>
+	T Sum() const {
+		if (!IsAttached()) {
+			_EXCEPTIONT("Attempted operation on unattached DataArray2D");
+		}
+
+		size_t sTotalSize = GetTotalSize();
+
+		T sum0 = 0; T sum1 = 0; T sum2 = 0; T sum3 = 0;
+		size_t i = 0;
+		for (; i + 4 <= sTotalSize; i += 4) {
+			sum0 += m_data1D[i  ];
+			sum1 += m_data1D[i+1];
+			sum2 += m_data1D[i+2];
+			sum3 += m_data1D[i+3];
+		}
+		for (; i < sTotalSize; i++) {
+			sum0 += m_data1D[i];
+		}
+		return (sum0 + sum1 + sum2 + sum3);
+	}
+
+	///	<summary>
+	///		Minimum of all data values.
+	///	</summary>
+	T Min() const {
+		if (!IsAttached()) {
+			_EXCEPTIONT("Attempted operation on unattached DataArray2D");
+		}
+
+		size_t sTotalSize = GetTotalSize();
+		if (sTotalSize == 0) {
+			_EXCEPTIONT("Attempted Min() on zero-size DataArray2D");
+		}
+
+		T min = m_data1D[0];
+		for (size_t i = 1; i < sTotalSize; i++) {
+			if (m_data1D[i] < min) {
+				min = m_data1D[i];
+			}
+		}
+		return min;
+	}
+
+	///	<summary>
+	///		Maximum of all data values.
+	///	</summary>
+	T Max() const {
+		if (!IsAttached()) {
+			_EXCEPTIONT("Attempted operation on unattached DataArray2D");
+		}
+
+		size_t sTotalSize = GetTotalSize();
+		if (sTotalSize == 0) {
+			_EXCEPTIONT("Attempted Max() on zero-size DataArray2D");
+		}
+
+		T max = m_data1D[0];
+		for (size_t i = 1; i < sTotalSize; i++) {
+			if (m_data1D[i] > max) {
+				max = m_data1D[i];
+			}
+		}
+		return max;
+	}
+
+	///	<summary>
+	///		Weighted mean along the given dimension, with weights
+	///		normalized by their sum.  Reducing along dimension 0 produces
+	///		one mean per column; reducing along dimension 1 produces one
+	///		mean per row, accumulated with unit stride.
+	///	</summary>
+	void WeightedMean(
+		const DataArray1D<T> & daWeight,
+		size_t sDim,
+		DataArray1D<T> & daOut
+	) const {
+		if (!IsAttached()) {
+			_EXCEPTIONT("Attempted operation on unattached DataArray2D");
+		}
+		if (!daWeight.IsAttached()) {
+			_EXCEPTIONT("Attempted operation on unattached DataArray1D");
+		}
+		if (sDim >= 2) {
+			_EXCEPTIONT("Dimension index out of range in DataArray2D");
+		}
+		if (daWeight.GetRows() != m_sSize[sDim]) {
+			_EXCEPTIONT("Weight size mismatch in DataArray2D");
+		}
+
+		T wsum = daWeight.Sum();
+		if (wsum == 0) {
+			_EXCEPTIONT("Zero weight sum in WeightedMean() on DataArray2D");
+		}
+
+		// Reduce over rows:  one weighted accumulation per row, applied
+		// across the contiguous row so the inner loop has unit stride
+		if (sDim == 0) {
+			daOut.Allocate(m_sSize[1]);
+			for (size_t i = 0; i < m_sSize[0]; i++) {
+				const T * pRow = m_data1D + i * m_sSize[1];
+				const T w = daWeight[i];
+				for (size_t j = 0; j < m_sSize[1]; j++) {
+					daOut[j] += w * pRow[j];
+				}
+			}
+			daOut.Scale(static_cast<T>(1) / wsum);
+
+		// Reduce over columns:  each output element is a unit-stride
+		// dot product of a row with the weight vector
+		} else {
+			daOut.Allocate(m_sSize[0]);
+			for (size_t i = 0; i < m_sSize[0]; i++) {
+				const T * pRow = m_data1D + i * m_sSize[1];
+				T sum0 = 0; T sum1 = 0;
+				size_t j = 0;
+				for (; j + 2 <= m_sSize[1]; j += 2) {
+					sum0 += daWeight[j  ] * pRow[j  ];
+					sum1 += daWeight[j+1] * pRow[j+1];
+				}
+				for (; j < m_sSize[1]; j++) {
+					sum0 += daWeight[j] * pRow[j];
+				}
+				daOut[i] = (sum0 + sum1) / wsum;
+			}
+		}
+	}
+
+public:
+	///	<summary>
+	///		Fixed-extent view of this DataArray2D.  Extents are supplied
+	///		as template parameters and checked against the runtime sizes
+	///		once, so every subsequent access indexes through constexpr
+	///		strides and folds to a single multiply-add.
+	///	</summary>
+	template <std::ptrdiff_t SizeI, std::ptrdiff_t SizeJ>
+	FixedSizeView<T, SizeI, SizeJ> GetFixedView() {
+		if (!IsAttached()) {
+			_EXCEPTIONT("Attempted operation on unattached DataArray2D");
+		}
+		if ((static_cast<size_t>(SizeI) != m_sSize[0]) ||
+		    (static_cast<size_t>(SizeJ) != m_sSize[1])
+		) {
+			_EXCEPTIONT("Extents mismatch in GetFixedView() "
+				"on DataArray2D");
+		}
+		return FixedSizeView<T, SizeI, SizeJ>(m_data1D);
+	}
+
+	///	<summary>
+	///		Fixed-extent view of this DataArray2D.
+	///	</summary>
+	template <std::ptrdiff_t SizeI, std::ptrdiff_t SizeJ>
+	FixedSizeView<const T, SizeI, SizeJ> GetFixedView() const {
+		if (!IsAttached()) {
+			_EXCEPTIONT("Attempted operation on unattached DataArray2D");
+		}
+		if ((static_cast<size_t>(SizeI) != m_sSize[0]) ||
+		    (static_cast<size_t>(SizeJ) != m_sSize[1])
+		) {
+			_EXCEPTIONT("Extents mismatch in GetFixedView() "
+				"on DataArray2D");
+		}
+		return FixedSizeView<const T, SizeI, SizeJ>(m_data1D);
+	}
+
 public:
 	///	<summary>
 	///		Subscript DSEL operator.
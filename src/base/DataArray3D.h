@@ -19,11 +19,14 @@
 
 ///////////////////////////////////////////////////////////////////////////////
 
+#include "DataArray1D.h"
+#include "DataArray2D.h"
 #include "Exception.h"
 #include "Subscript.h"
 
 #include <cstdlib>
 #include <cstring>
+#include <utility>
 
 template <typename T>
 class DataArray3D {
@@ -89,6 +92,24 @@ public:
 		}
 	}
 
+	///	<summary>
+	///		Move constructor.
+	///	</summary>
+	DataArray3D(DataArray3D<T> && da) noexcept :
+		m_fOwnsData(da.m_fOwnsData),
+		m_data1D(da.m_data1D)
+	{
+		m_sSize[0] = da.m_sSize[0];
+		m_sSize[1] = da.m_sSize[1];
+		m_sSize[2] = da.m_sSize[2];
+
+		da.m_fOwnsData = true;
+		da.m_sSize[0] = 0;
+		da.m_sSize[1] = 0;
+		da.m_sSize[2] = 0;
+		da.m_data1D = NULL;
+	}
+
 	///	<summary>
 	///		Destructor.
 	///	</summary>
@@ -139,11 +160,13 @@ public:
 			m_sSize[1] = sSize1;
 			m_sSize[2] = sSize2;
 
-			m_data1D = reinterpret_cast<T *>(malloc(GetByteSize()));
-
-			if (m_data1D == NULL) {
-				_EXCEPTION1("Failed malloc call (%lu bytes)", GetByteSize());
+			// Align to cache line boundaries for vectorized access
+			void * ptr = NULL;
+			if (posix_memalign(&ptr, 64, GetByteSize()) != 0) {
+				_EXCEPTION1("Failed posix_memalign call (%lu bytes)",
+					GetByteSize());
 			}
+			m_data1D = reinterpret_cast<T *>(ptr);
 		}
 
 		Zero();
@@ -191,7 +214,7 @@ public:
 	///	</summary>
 	virtual void Detach() {
 		if ((m_fOwnsData) && (m_data1D != NULL)) {
-			delete[] m_data1D;
+			free(m_data1D);
 		}
 		m_fOwnsData = true;
 		m_data1D = NULL;
@@ -304,6 +327,28 @@ public:
 		return (*this);
 	}
 
+	///	<summary>
+	///		Move assignment operator.
+	///	</summary>
+	DataArray3D<T> & operator= (DataArray3D<T> && da) noexcept {
+		if (this != &da) {
+			Detach();
+			Swap(da);
+		}
+		return (*this);
+	}
+
+	///	<summary>
+	///		Exchange contents with the given DataArray3D.
+	///	</summary>
+	void Swap(DataArray3D<T> & da) noexcept {
+		std::swap(m_fOwnsData, da.m_fOwnsData);
+		std::swap(m_sSize[0], da.m_sSize[0]);
+		std::swap(m_sSize[1], da.m_sSize[1]);
+		std::swap(m_sSize[2], da.m_sSize[2]);
+		std::swap(m_data1D, da.m_data1D);
+	}
+
 public:
 	///	<summary>
 	///		Zero the data content of this object.
@@ -369,6 +414,156 @@ public:
 		}
 	}
 
+public:
+	///	<summary>
+	///		Sum of all data values.  Four independent accumulators are
+	///		used so the loop vectorizes without reassociating a single
+	///		serial dependency chain.
+	///	</summary>
+	T Sum() const {
+		if (!IsAttached()) {
+			_EXCEPTIONT("Attempted operation on unattached DataArray3D");
+		}
+
+		size_t sTotalSize = GetTotalSize();
+
+		T sum0 = 0; T sum1 = 0; T sum2 = 0; T sum3 = 0;
+		size_t i = 0;
+		for (; i + 4 <= sTotalSize; i += 4) {
+			sum0 += m_data1D[i  ];
+			sum1 += m_data1D[i+1];
+			sum2 += m_data1D[i+2];
+			sum3 += m_data1D[i+3];
+		}
+		for (; i < sTotalSize; i++) {
+			sum0 += m_data1D[i];
+		}
+		return (sum0 + sum1 + sum2 + sum3);
+	}
+
+	///	<summary>
+	///		Minimum of all data values.
+	///	</summary>
+	T Min() const {
+		if (!IsAttached()) {
+			_EXCEPTIONT("Attempted operation on unattached DataArray3D");
+		}
+
+		size_t sTotalSize = GetTotalSize();
+		if (sTotalSize == 0) {
+			_EXCEPTIONT("Attempted Min() on zero-size DataArray3D");
+		}
+
+		T min = m_data1D[0];
+		for (size_t i = 1; i < sTotalSize; i++) {
+			if (m_data1D[i] < min) {
+				min = m_data1D[i];
+			}
+		}
+		return min;
+	}
+
+	///	<summary>
+	///		Maximum of all data values.
+	///	</summary>
+	T Max() const {
+		if (!IsAttached()) {
+			_EXCEPTIONT("Attempted operation on unattached DataArray3D");
+		}
+
+		size_t sTotalSize = GetTotalSize();
+		if (sTotalSize == 0) {
+			_EXCEPTIONT("Attempted Max() on zero-size DataArray3D");
+		}
+
+		T max = m_data1D[0];
+		for (size_t i = 1; i < sTotalSize; i++) {
+			if (m_data1D[i] > max) {
+				max = m_data1D[i];
+			}
+		}
+		return max;
+	}
+
+public:
+	///	<summary>
+	///		Non-owning view of the 2D plane at the given first index,
+	///		attached directly to this array's storage.  No data is copied;
+	///		writes through the view modify this array, and the view must
+	///		not outlive the underlying storage.
+	///	</summary>
+	DataArray2D<T> Slice2D(size_t i) {
+		if (!IsAttached()) {
+			_EXCEPTIONT("Attempted Slice2D() on unattached DataArray3D");
+		}
+		if (i >= m_sSize[0]) {
+			_EXCEPTIONT("Slice2D() index out of range");
+		}
+
+		DataArray2D<T> da(m_sSize[1], m_sSize[2], false);
+		da.AttachToData(m_data1D + i * m_sSize[1] * m_sSize[2]);
+		return da;
+	}
+
+	///	<summary>
+	///		Non-owning view of the 1D column at the given first and second
+	///		indices, attached directly to this array's storage.  No data
+	///		is copied; writes through the view modify this array, and the
+	///		view must not outlive the underlying storage.
+	///	</summary>
+	DataArray1D<T> Column(size_t i, size_t j) {
+		if (!IsAttached()) {
+			_EXCEPTIONT("Attempted Column() on unattached DataArray3D");
+		}
+		if ((i >= m_sSize[0]) || (j >= m_sSize[1])) {
+			_EXCEPTIONT("Column() index out of range");
+		}
+
+		DataArray1D<T> da(m_sSize[2], false);
+		da.AttachToData(m_data1D + i * m_sSize[1] * m_sSize[2] + j * m_sSize[2]);
+		return da;
+	}
+
+public:
+	///	<summary>
+	///		Fixed-extent view of this DataArray3D.  Extents are supplied
+	///		as template parameters and checked against the runtime sizes
+	///		once, so every subsequent access indexes through constexpr
+	///		strides and fixed-extent inner loops fully unroll.
+	///	</summary>
+	template <std::ptrdiff_t SizeI, std::ptrdiff_t SizeJ, std::ptrdiff_t SizeK>
+	FixedSizeView<T, SizeI, SizeJ, SizeK> GetFixedView() {
+		if (!IsAttached()) {
+			_EXCEPTIONT("Attempted operation on unattached DataArray3D");
+		}
+		if ((static_cast<size_t>(SizeI) != m_sSize[0]) ||
+		    (static_cast<size_t>(SizeJ) != m_sSize[1]) ||
+		    (static_cast<size_t>(SizeK) != m_sSize[2])
+		) {
+			_EXCEPTIONT("Extents mismatch in GetFixedView() "
+				"on DataArray3D");
+		}
+		return FixedSizeView<T, SizeI, SizeJ, SizeK>(m_data1D);
+	}
+
+	///	<summary>
+	///		Fixed-extent view of this DataArray3D.
+	///	</summary>
+	template <std::ptrdiff_t SizeI, std::ptrdiff_t SizeJ, std::ptrdiff_t SizeK>
+	FixedSizeView<const T, SizeI, SizeJ, SizeK> GetFixedView() const {
+		if (!IsAttached()) {
+			_EXCEPTIONT("Attempted operation on unattached DataArray3D");
+		}
+		if ((static_cast<size_t>(SizeI) != m_sSize[0]) ||
+		    (static_cast<size_t>(SizeJ) != m_sSize[1]) ||
+		    (static_cast<size_t>(SizeK) != m_sSize[2])
+		) {
+			_EXCEPTIONT("Extents mismatch in GetFixedView() "
+				"on DataArray3D");
+		}
+		return FixedSizeView<const T, SizeI, SizeJ, SizeK>(m_data1D);
+	}
+
 public:
 	///	<summary>
 	///		Subscript DSEL operator.
@@ -0,0 +1,237 @@
+///////////////////////////////////////////////////////////////////////////////
+///
+///	\file    DataSlab.h
+///	\author  Paul Ullrich
+///	\version September 1, 2026
+///
+///	<remarks>
+///		Copyright (c) 2020 Paul Ullrich
+///
+///		Distributed under the BSD 3-Clause License.
+///		(See accompanying file LICENSE)
+///	</remarks>
+
+#ifndef _DATASLAB_H_
+#define _DATASLAB_H_
+
+///////////////////////////////////////////////////////////////////////////////
+
+#include "Exception.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		A slab allocator backing a family of DataArray objects with one
+///		contiguous heap reservation.  Arrays are registered with their
+///		dimension sizes already set (via SetSize), the slab is sized from
+///		their summed GetByteSize() values, and each array is attached to
+///		its region of the reservation through AttachToData.  Releasing
+///		the slab detaches every array and returns all storage in a single
+///		free, avoiding per-array allocator overhead and fragmentation
+///		when hundreds of small arrays share a lifetime.
+///	</summary>
+class DataSlab {
+
+public:
+	///	<summary>
+	///		Alignment of each region within the slab, in bytes.
+	///	</summary>
+	static const size_t ChunkAlignment = 64;
+
+private:
+	///	<summary>
+	///		Type-erased handle to a registered DataArray.  The DataArray
+	///		classes share the attachment interface but no common base, so
+	///		each registration captures it behind this one.
+	///	</summary>
+	class DataChunk {
+	public:
+		virtual ~DataChunk() { }
+		virtual size_t GetByteSize() const = 0;
+		virtual bool IsAttached() const = 0;
+		virtual void AttachToData(void * ptr) = 0;
+		virtual void Detach() = 0;
+	};
+
+	///	<summary>
+	///		Handle to a registered DataArray of a particular type.
+	///	</summary>
+	template <typename DataArray>
+	class DataChunkHandle : public DataChunk {
+	public:
+		DataChunkHandle(DataArray & da) : m_da(da) { }
+		virtual size_t GetByteSize() const {
+			return m_da.GetByteSize();
+		}
+		virtual bool IsAttached() const {
+			return m_da.IsAttached();
+		}
+		virtual void AttachToData(void * ptr) {
+			m_da.AttachToData(ptr);
+		}
+		virtual void Detach() {
+			m_da.Detach();
+		}
+	private:
+		DataArray & m_da;
+	};
+
+public:
+	///	<summary>
+	///		Constructor.
+	///	</summary>
+	DataSlab() :
+		m_pAllocatedData(NULL),
+		m_sTotalByteSize(0)
+	{ }
+
+	///	<summary>
+	///		Destructor.
+	///	</summary>
+	~DataSlab() {
+		Release();
+	}
+
+private:
+	///	<summary>
+	///		Copying a slab is not permitted.
+	///	</summary>
+	DataSlab(const DataSlab &);
+	DataSlab & operator= (const DataSlab &);
+
+public:
+	///	<summary>
+	///		Register a DataArray with this slab.  The array must have its
+	///		dimension sizes set (via SetSize) and must remain alive until
+	///		the slab is released.
+	///	</summary>
+	template <typename DataArray>
+	void Register(DataArray & da) {
+		if (m_pAllocatedData != NULL) {
+			_EXCEPTIONT("Attempting to Register() on allocated DataSlab");
+		}
+		if (da.IsAttached()) {
+			_EXCEPTIONT("Attempting to Register() an attached DataArray");
+		}
+
+		m_vecChunks.push_back(new DataChunkHandle<DataArray>(da));
+		m_sTotalByteSize += RoundedByteSize(da.GetByteSize());
+	}
+
+	///	<summary>
+	///		Allocate the slab and attach all registered arrays to their
+	///		regions of the reservation.  All storage is zeroed.
+	///	</summary>
+	void Allocate() {
+		if (m_pAllocatedData != NULL) {
+			_EXCEPTIONT("Attempting to Allocate() on allocated DataSlab");
+		}
+
+		// An array may have attached elsewhere between Register() and
+		// Allocate(); attaching it again here would leak that storage
+		for (size_t c = 0; c < m_vecChunks.size(); c++) {
+			if (m_vecChunks[c]->IsAttached()) {
+				_EXCEPTIONT("Attempting to Allocate() on DataSlab with "
+					"attached DataArray");
+			}
+		}
+
+		if (m_sTotalByteSize == 0) {
+			return;
+		}
+
+		void * ptr = NULL;
+		if (posix_memalign(&ptr, ChunkAlignment, m_sTotalByteSize) != 0) {
+			_EXCEPTION1("Failed posix_memalign call (%lu bytes)",
+				m_sTotalByteSize);
+		}
+		m_pAllocatedData = reinterpret_cast<char *>(ptr);
+
+		memset(m_pAllocatedData, 0, m_sTotalByteSize);
+
+		size_t sOffset = 0;
+		for (size_t c = 0; c < m_vecChunks.size(); c++) {
+			m_vecChunks[c]->AttachToData(m_pAllocatedData + sOffset);
+			sOffset += RoundedByteSize(m_vecChunks[c]->GetByteSize());
+		}
+	}
+
+	///	<summary>
+	///		Detach all registered arrays and release the reservation in
+	///		one bulk free.
+	///	</summary>
+	void Release() {
+		if (m_pAllocatedData != NULL) {
+			for (size_t c = 0; c < m_vecChunks.size(); c++) {
+				m_vecChunks[c]->Detach();
+			}
+			free(m_pAllocatedData);
+			m_pAllocatedData = NULL;
+		}
+
+		for (size_t c = 0; c < m_vecChunks.size(); c++) {
+			delete m_vecChunks[c];
+		}
+		m_vecChunks.clear();
+		m_sTotalByteSize = 0;
+	}
+
+public:
+	///	<summary>
+	///		Determine if the slab is currently allocated.
+	///	</summary>
+	bool IsAllocated() const {
+		return (m_pAllocatedData != NULL);
+	}
+
+	///	<summary>
+	///		Number of registered arrays.
+	///	</summary>
+	size_t GetChunkCount() const {
+		return m_vecChunks.size();
+	}
+
+	///	<summary>
+	///		Total size of the reservation, in bytes.
+	///	</summary>
+	size_t GetTotalByteSize() const {
+		return m_sTotalByteSize;
+	}
+
+private:
+	///	<summary>
+	///		Round the given byte size up to a multiple of the chunk
+	///		alignment, so each region begins on a cache line boundary.
+	///	</summary>
+	static size_t RoundedByteSize(size_t sByteSize) {
+		if (sByteSize % ChunkAlignment == 0) {
+			return sByteSize;
+		} else {
+			return (sByteSize / ChunkAlignment + 1) * ChunkAlignment;
+		}
+	}
+
+private:
+	///	<summary>
+	///		Handles to all registered arrays.
+	///	</summary>
+	std::vector<DataChunk *> m_vecChunks;
+
+	///	<summary>
+	///		Pointer to the slab reservation.
+	///	</summary>
+	char * m_pAllocatedData;
+
+	///	<summary>
+	///		Total size of the reservation, in bytes.
+	///	</summary>
+	size_t m_sTotalByteSize;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+#endif // _DATASLAB_H_
@@ -0,0 +1,335 @@
+///////////////////////////////////////////////////////////////////////////////
+///
+///	\file    LookupVectorHash.h
+///	\author  Paul Ullrich
+///	\version September 1, 2026
+///
+
+#ifndef _LOOKUPVECTORHASH_H_
+#define _LOOKUPVECTORHASH_H_
+
+#include "Exception.h"
+
+#include <vector>
+#include <utility>
+#include <functional>
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		A variant of LookupVectorHeap with an open-addressing hash index
+///		and stored objects held inline in contiguous memory.  Lookups
+///		cost one hash plus a short linear probe over a flat index array,
+///		and index-order iteration walks a single contiguous allocation,
+///		in contrast to the red-black-tree walk and per-object pointer
+///		chase of LookupVectorHeap.  Indices assigned at insertion remain
+///		stable for the lifetime of the container; pointers to stored
+///		objects are invalidated when the entry vector grows, so call
+///		reserve() up front when the entry count is known.
+///	</summary>
+template <
+	typename LookupObject,
+	typename StoredObject,
+	typename HashObject = std::hash<LookupObject>
+>
+class LookupVectorHash {
+
+public:
+	///	<summary>
+	///		Pointer to StoredObject.
+	///	</summary>
+	typedef StoredObject * StoredObjectPtr;
+
+	///	<summary>
+	///		Pointer to StoredObject.
+	///	</summary>
+	typedef const StoredObject * ConstStoredObjectPtr;
+
+	///	<summary>
+	///		An entry, pairing the key with its inline stored object.
+	///	</summary>
+	typedef std::pair<LookupObject, StoredObject> Entry;
+
+	///	<summary>
+	///		Vector of entries, in insertion (index) order.
+	///	</summary>
+	typedef std::vector<Entry> EntryVector;
+
+	///	<summary>
+	///		Iterator, traversing entries in index order.
+	///	</summary>
+	class iterator {
+		public:
+			size_t m_ix;
+			LookupVectorHash * m_pheap;
+
+		public:
+			iterator(
+				size_t ix,
+				LookupVectorHash * pheap
+			) :
+				m_ix(ix),
+				m_pheap(pheap)
+			{ }
+
+			iterator operator++() {
+				m_ix++;
+				return *this;
+			}
+
+			iterator operator++(int) {
+				m_ix++;
+				return *this;
+			}
+
+			const LookupObject & key() {
+				return m_pheap->m_vecEntries[m_ix].first;
+			}
+
+			StoredObjectPtr operator*() {
+				return &(m_pheap->m_vecEntries[m_ix].second);
+			}
+
+			bool operator==(const iterator & iter) const {
+				if ((m_ix == iter.m_ix) && (m_pheap == iter.m_pheap)) {
+					return true;
+				}
+				return false;
+			}
+
+			bool operator!=(const iterator & iter) const {
+				if ((m_ix != iter.m_ix) || (m_pheap != iter.m_pheap)) {
+					return true;
+				}
+				return false;
+			}
+	};
+
+	///	<summary>
+	///		Constant iterator, traversing entries in index order.
+	///	</summary>
+	class const_iterator {
+		public:
+			size_t m_ix;
+			const LookupVectorHash * m_pheap;
+
+		public:
+			const_iterator(
+				size_t ix,
+				const LookupVectorHash * pheap
+			) :
+				m_ix(ix),
+				m_pheap(pheap)
+			{ }
+
+			const_iterator operator++() {
+				m_ix++;
+				return *this;
+			}
+
+			const_iterator operator++(int) {
+				m_ix++;
+				return *this;
+			}
+
+			const LookupObject & key() {
+				return m_pheap->m_vecEntries[m_ix].first;
+			}
+
+			ConstStoredObjectPtr operator*() {
+				return &(m_pheap->m_vecEntries[m_ix].second);
+			}
+
+			bool operator==(const const_iterator & iter) const {
+				if ((m_ix == iter.m_ix) && (m_pheap == iter.m_pheap)) {
+					return true;
+				}
+				return false;
+			}
+
+			bool operator!=(const const_iterator & iter) const {
+				if ((m_ix != iter.m_ix) || (m_pheap != iter.m_pheap)) {
+					return true;
+				}
+				return false;
+			}
+	};
+
+public:
+	///	<summary>
+	///		Constructor.
+	///	</summary>
+	LookupVectorHash() :
+		m_vecIndex(InitialIndexSize, 0)
+	{ }
+
+	///	<summary>
+	///		Get the size of this LookupVector.
+	///	</summary>
+	size_t size() const {
+		return m_vecEntries.size();
+	}
+
+	///	<summary>
+	///		Reserve storage for the given number of entries, sizing the
+	///		hash index so no rehash occurs before that count is reached.
+	///	</summary>
+	void reserve(size_t sCount) {
+		m_vecEntries.reserve(sCount);
+
+		size_t sIndexSize = m_vecIndex.size();
+		while (sCount * MaxLoadDenom >= sIndexSize * MaxLoadNumer) {
+			sIndexSize *= 2;
+		}
+		if (sIndexSize != m_vecIndex.size()) {
+			Rehash(sIndexSize);
+		}
+	}
+
+	///	<summary>
+	///		Insert an object into this LookupVector.
+	///	</summary>
+	void insert(
+		const LookupObject & key,
+		const StoredObject & value
+	) {
+		if ((m_vecEntries.size() + 1) * MaxLoadDenom
+		    >= m_vecIndex.size() * MaxLoadNumer
+		) {
+			Rehash(m_vecIndex.size() * 2);
+		}
+
+		size_t sIndex = m_vecEntries.size();
+		m_vecEntries.push_back(Entry(key, value));
+
+		size_t sSlot = FindSlot(key);
+		if (m_vecIndex[sSlot] == 0) {
+			m_vecIndex[sSlot] = sIndex + 1;
+		}
+	}
+
+	///	<summary>
+	///		Perform a lookup by index.
+	///	</summary>
+	StoredObjectPtr operator[](size_t ix) {
+		return &(m_vecEntries[ix].second);
+	}
+
+	///	<summary>
+	///		Perform a lookup by index.
+	///	</summary>
+	ConstStoredObjectPtr operator[](size_t ix) const {
+		return &(m_vecEntries[ix].second);
+	}
+
+	///	<summary>
+	///		Perform a lookup by LookupObject.
+	///	</summary>
+	iterator find(const LookupObject & key) {
+		size_t sSlot = FindSlot(key);
+		if (m_vecIndex[sSlot] == 0) {
+			return end();
+		}
+		return iterator(m_vecIndex[sSlot] - 1, this);
+	}
+
+	///	<summary>
+	///		Perform a lookup by LookupObject.
+	///	</summary>
+	const_iterator find(const LookupObject & key) const {
+		size_t sSlot = FindSlot(key);
+		if (m_vecIndex[sSlot] == 0) {
+			return end();
+		}
+		return const_iterator(m_vecIndex[sSlot] - 1, this);
+	}
+
+	///	<summary>
+	///		Iterator to beginning of vector.
+	///	</summary>
+	iterator begin() {
+		return iterator(0, this);
+	}
+
+	///	<summary>
+	///		Const iterator to beginning of vector.
+	///	</summary>
+	const_iterator begin() const {
+		return const_iterator(0, this);
+	}
+
+	///	<summary>
+	///		Iterator to end of vector.
+	///	</summary>
+	iterator end() {
+		return iterator(m_vecEntries.size(), this);
+	}
+
+	///	<summary>
+	///		Const iterator to end of vector.
+	///	</summary>
+	const_iterator end() const {
+		return const_iterator(m_vecEntries.size(), this);
+	}
+
+protected:
+	///	<summary>
+	///		Initial size of the hash index (must be a power of two).
+	///	</summary>
+	static const size_t InitialIndexSize = 16;
+
+	///	<summary>
+	///		Maximum load factor of the hash index, as a fraction.
+	///	</summary>
+	static const size_t MaxLoadNumer = 7;
+	static const size_t MaxLoadDenom = 10;
+
+	///	<summary>
+	///		Find the index slot for the given key via linear probing:
+	///		either the slot holding the key or the first empty slot.
+	///	</summary>
+	size_t FindSlot(const LookupObject & key) const {
+		size_t sMask = m_vecIndex.size() - 1;
+		size_t sSlot = HashObject()(key) & sMask;
+
+		for (;;) {
+			if (m_vecIndex[sSlot] == 0) {
+				return sSlot;
+			}
+			if (m_vecEntries[m_vecIndex[sSlot] - 1].first == key) {
+				return sSlot;
+			}
+			sSlot = (sSlot + 1) & sMask;
+		}
+	}
+
+	///	<summary>
+	///		Grow the hash index to the given size and reinsert all keys.
+	///	</summary>
+	void Rehash(size_t sIndexSize) {
+		m_vecIndex.assign(sIndexSize, 0);
+
+		for (size_t s = 0; s < m_vecEntries.size(); s++) {
+			size_t sSlot = FindSlot(m_vecEntries[s].first);
+			if (m_vecIndex[sSlot] == 0) {
+				m_vecIndex[sSlot] = s + 1;
+			}
+		}
+	}
+
+protected:
+	///	<summary>
+	///		Open-addressing hash index, holding entry index plus one
+	///		(zero indicates an empty slot).
+	///	</summary>
+	std::vector<size_t> m_vecIndex;
+
+	///	<summary>
+	///		Vector of entries, in insertion (index) order.
+	///	</summary>
+	EntryVector m_vecEntries;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+#endif // _LOOKUPVECTORHASH_H_
@@ -8,10 +8,17 @@
 #ifndef _MATHHELPER_H_
 #define _MATHHELPER_H_
 
+#include "DataArray1D.h"
+
 #include <cmath>
+#include <cstddef>
 #include <limits>
 #include <algorithm>
 
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
 ///////////////////////////////////////////////////////////////////////////////
 
 ///	<summary>
@@ -46,6 +53,196 @@ _T Clamp(_T y, _T x1, _T x2) {
 	return (y>x2)?(x2):((y<x1)?(x1):(y));
 }
 
+///	<summary>
+///		Clamp every element of a contiguous span to be within a given
+///		range, in place.  The loop body is branch-free (ternary min/max
+///		selects) over a restrict-qualified pointer, so the compiler emits
+///		packed min/max instructions for the whole span.
+///	</summary>
+template <typename _T>
+void ClampArray(_T * __restrict__ pData, size_t sSize, _T x1, _T x2) {
+	for (size_t i = 0; i < sSize; i++) {
+		_T y = pData[i];
+		y = (y > x2)?(x2):(y);
+		y = (y < x1)?(x1):(y);
+		pData[i] = y;
+	}
+}
+
+///	<summary>
+///		Clamp every element of a DataArray1D to be within a given range,
+///		in place.
+///	</summary>
+template <typename _T>
+void ClampArray(DataArray1D<_T> & data, _T x1, _T x2) {
+	ClampArray(&(data[0]), data.GetRows(), x1, x2);
+}
+
+///	<summary>
+///		Fused clamp-and-scale over a contiguous span, in place:  each
+///		element is clamped to the given range and then multiplied by the
+///		given scale factor in a single pass, so the span is only pulled
+///		through cache once.
+///	</summary>
+template <typename _T>
+void ClampScaleArray(
+	_T * __restrict__ pData,
+	size_t sSize,
+	_T x1,
+	_T x2,
+	_T xScale
+) {
+	for (size_t i = 0; i < sSize; i++) {
+		_T y = pData[i];
+		y = (y > x2)?(x2):(y);
+		y = (y < x1)?(x1):(y);
+		pData[i] = y * xScale;
+	}
+}
+
+///	<summary>
+///		Fused clamp-and-scale over a DataArray1D, in place.
+///	</summary>
+template <typename _T>
+void ClampScaleArray(DataArray1D<_T> & data, _T x1, _T x2, _T xScale) {
+	ClampScaleArray(&(data[0]), data.GetRows(), x1, x2, xScale);
+}
+
+///	<summary>
+///		Calculate the minimum over a contiguous span.  Four independent
+///		accumulators are used so the reduction vectorizes without a
+///		single serial dependency chain.
+///	</summary>
+template <typename _T>
+_T MinArray(const _T * __restrict__ pData, size_t sSize) {
+	if (sSize == 0) {
+		_EXCEPTIONT("Attempted MinArray() on zero-size span");
+	}
+
+	_T min0 = pData[0]; _T min1 = pData[0];
+	_T min2 = pData[0]; _T min3 = pData[0];
+	size_t i = 0;
+	for (; i + 4 <= sSize; i += 4) {
+		min0 = (pData[i  ] < min0)?(pData[i  ]):(min0);
+		min1 = (pData[i+1] < min1)?(pData[i+1]):(min1);
+		min2 = (pData[i+2] < min2)?(pData[i+2]):(min2);
+		min3 = (pData[i+3] < min3)?(pData[i+3]):(min3);
+	}
+	for (; i < sSize; i++) {
+		min0 = (pData[i] < min0)?(pData[i]):(min0);
+	}
+	min0 = (min1 < min0)?(min1):(min0);
+	min2 = (min3 < min2)?(min3):(min2);
+	return (min2 < min0)?(min2):(min0);
+}
+
+#if defined(__SSE2__)
+///	<summary>
+///		Calculate the minimum over a contiguous span of doubles using
+///		packed SSE2 min instructions.  The compiler cannot vectorize the
+///		generic reduction itself without relaxed floating point
+///		semantics, since packed min differs from the scalar select in
+///		its treatment of NaN operand order; this overload keeps the
+///		select's semantics by passing the accumulator second.
+///	</summary>
+inline double MinArray(const double * __restrict__ pData, size_t sSize) {
+	if (sSize == 0) {
+		_EXCEPTIONT("Attempted MinArray() on zero-size span");
+	}
+
+	__m128d vmin0 = _mm_set1_pd(pData[0]);
+	__m128d vmin1 = vmin0;
+	size_t i = 0;
+	for (; i + 4 <= sSize; i += 4) {
+		vmin0 = _mm_min_pd(_mm_loadu_pd(pData + i    ), vmin0);
+		vmin1 = _mm_min_pd(_mm_loadu_pd(pData + i + 2), vmin1);
+	}
+	vmin0 = _mm_min_pd(vmin1, vmin0);
+
+	double dLane[2];
+	_mm_storeu_pd(dLane, vmin0);
+	double min = (dLane[1] < dLane[0])?(dLane[1]):(dLane[0]);
+	for (; i < sSize; i++) {
+		min = (pData[i] < min)?(pData[i]):(min);
+	}
+	return min;
+}
+#endif
+
+///	<summary>
+///		Calculate the minimum over a DataArray1D.
+///	</summary>
+template <typename _T>
+_T MinArray(const DataArray1D<_T> & data) {
+	return MinArray(&(data[0]), data.GetRows());
+}
+
+///	<summary>
+///		Calculate the maximum over a contiguous span.  Four independent
+///		accumulators are used so the reduction vectorizes without a
+///		single serial dependency chain.
+///	</summary>
+template <typename _T>
+_T MaxArray(const _T * __restrict__ pData, size_t sSize) {
+	if (sSize == 0) {
+		_EXCEPTIONT("Attempted MaxArray() on zero-size span");
+	}
+
+	_T max0 = pData[0]; _T max1 = pData[0];
+	_T max2 = pData[0]; _T max3 = pData[0];
+	size_t i = 0;
+	for (; i + 4 <= sSize; i += 4) {
+		max0 = (pData[i  ] > max0)?(pData[i  ]):(max0);
+		max1 = (pData[i+1] > max1)?(pData[i+1]):(max1);
+		max2 = (pData[i+2] > max2)?(pData[i+2]):(max2);
+		max3 = (pData[i+3] > max3)?(pData[i+3]):(max3);
+	}
+	for (; i < sSize; i++) {
+		max0 = (pData[i] > max0)?(pData[i]):(max0);
+	}
+	max0 = (max1 > max0)?(max1):(max0);
+	max2 = (max3 > max2)?(max3):(max2);
+	return (max2 > max0)?(max2):(max0);
+}
+
+#if defined(__SSE2__)
+///	<summary>
+///		Calculate the maximum over a contiguous span of doubles using
+///		packed SSE2 max instructions.  See MinArray() above for the NaN
+///		ordering rationale.
+///	</summary>
+inline double MaxArray(const double * __restrict__ pData, size_t sSize) {
+	if (sSize == 0) {
+		_EXCEPTIONT("Attempted MaxArray() on zero-size span");
+	}
+
+	__m128d vmax0 = _mm_set1_pd(pData[0]);
+	__m128d vmax1 = vmax0;
+	size_t i = 0;
+	for (; i + 4 <= sSize; i += 4) {
+		vmax0 = _mm_max_pd(_mm_loadu_pd(pData + i    ), vmax0);
+		vmax1 = _mm_max_pd(_mm_loadu_pd(pData + i + 2), vmax1);
+	}
+	vmax0 = _mm_max_pd(vmax1, vmax0);
+
+	double dLane[2];
+	_mm_storeu_pd(dLane, vmax0);
+	double max = (dLane[1] > dLane[0])?(dLane[1]):(dLane[0]);
+	for (; i < sSize; i++) {
+		max = (pData[i] > max)?(pData[i]):(max);
+	}
+	return max;
+}
+#endif
+
+///	<summary>
+///		Calculate the maximum over a DataArray1D.
+///	</summary>
+template <typename _T>
+_T MaxArray(const DataArray1D<_T> & data) {
+	return MaxArray(&(data[0]), data.GetRows());
+}
+
 ///	<summary>
 ///		Calculate the integer square root.
 ///	</summary>
@@ -0,0 +1,169 @@
+///////////////////////////////////////////////////////////////////////////////
+///
+///	\file    MemoryMappedFile.h
+///	\author  Paul Ullrich
+///	\version September 1, 2026
+///
+///	<remarks>
+///		Copyright (c) 2020 Paul Ullrich
+///
+///		Distributed under the BSD 3-Clause License.
+///		(See accompanying file LICENSE)
+///	</remarks>
+
+#ifndef _MEMORYMAPPEDFILE_H_
+#define _MEMORYMAPPEDFILE_H_
+
+///////////////////////////////////////////////////////////////////////////////
+
+#include "Exception.h"
+
+#include <string>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		A read-only memory mapping of a file.  The file contents are made
+///		available as a contiguous character range served directly from the
+///		page cache, avoiding per-byte copies through stdio buffers.
+///	</summary>
+class MemoryMappedFile {
+
+public:
+	///	<summary>
+	///		Constructor.
+	///	</summary>
+	MemoryMappedFile() :
+		m_data(NULL),
+		m_sSize(0)
+	{ }
+
+	///	<summary>
+	///		Constructor which opens the given file.
+	///	</summary>
+	MemoryMappedFile(
+		const std::string & strFilename
+	) :
+		m_data(NULL),
+		m_sSize(0)
+	{
+		Open(strFilename);
+	}
+
+	///	<summary>
+	///		Destructor.
+	///	</summary>
+	~MemoryMappedFile() {
+		Close();
+	}
+
+private:
+	///	<summary>
+	///		Copying a mapping is not permitted.
+	///	</summary>
+	MemoryMappedFile(const MemoryMappedFile &);
+	MemoryMappedFile & operator= (const MemoryMappedFile &);
+
+public:
+	///	<summary>
+	///		Map the given file into memory.
+	///	</summary>
+	void Open(
+		const std::string & strFilename
+	) {
+		Close();
+
+		int fd = open(strFilename.c_str(), O_RDONLY);
+		if (fd == -1) {
+			_EXCEPTION1("Unable to open \"%s\" for reading",
+				strFilename.c_str());
+		}
+
+		struct stat sb;
+		if (fstat(fd, &sb) == -1) {
+			close(fd);
+			_EXCEPTION1("Unable to stat \"%s\"", strFilename.c_str());
+		}
+
+		m_sSize = static_cast<size_t>(sb.st_size);
+
+		// An empty file has nothing to map
+		if (m_sSize == 0) {
+			close(fd);
+			return;
+		}
+
+		void * pData = mmap(NULL, m_sSize, PROT_READ, MAP_PRIVATE, fd, 0);
+
+		// The mapping remains valid after the descriptor is closed
+		close(fd);
+
+		if (pData == MAP_FAILED) {
+			m_sSize = 0;
+			_EXCEPTION1("Unable to memory map \"%s\"", strFilename.c_str());
+		}
+
+		m_data = reinterpret_cast<const char *>(pData);
+	}
+
+	///	<summary>
+	///		Unmap the file.
+	///	</summary>
+	void Close() {
+		if (m_data != NULL) {
+			munmap(const_cast<char *>(m_data), m_sSize);
+		}
+		m_data = NULL;
+		m_sSize = 0;
+	}
+
+public:
+	///	<summary>
+	///		Determine if a file is currently mapped.
+	///	</summary>
+	bool IsOpen() const {
+		return (m_data != NULL);
+	}
+
+	///	<summary>
+	///		Pointer to the beginning of the mapped file contents.
+	///	</summary>
+	const char * begin() const {
+		return m_data;
+	}
+
+	///	<summary>
+	///		Pointer one past the end of the mapped file contents.
+	///	</summary>
+	const char * end() const {
+		return (m_data + m_sSize);
+	}
+
+	///	<summary>
+	///		Size of the mapped file contents, in bytes.
+	///	</summary>
+	size_t size() const {
+		return m_sSize;
+	}
+
+private:
+	///	<summary>
+	///		Pointer to the mapped file contents.
+	///	</summary>
+	const char * m_data;
+
+	///	<summary>
+	///		Size of the mapped file contents, in bytes.
+	///	</summary>
+	size_t m_sSize;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+#endif // _MEMORYMAPPEDFILE_H_
+
@@ -0,0 +1,164 @@
+///////////////////////////////////////////////////////////////////////////////
+///
+///	\file    Profiler.h
+///	\author  Paul Ullrich
+///	\version September 1, 2026
+///
+///	<remarks>
+///		Copyright (c) 2020 Paul Ullrich
+///
+///		Distributed under the BSD 3-Clause License.
+///		(See accompanying file LICENSE)
+///	</remarks>
+
+#ifndef _PROFILER_H_
+#define _PROFILER_H_
+
+///////////////////////////////////////////////////////////////////////////////
+
+#include "Exception.h"
+
+#include <string>
+#include <vector>
+#include <utility>
+#include <chrono>
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		A lightweight accumulator of named phase timings, measured with the
+///		monotonic clock.  The profiler is disabled by default and all calls
+///		are no-ops until Enable() is called, so instrumentation can remain
+///		in place on hot paths at negligible cost.  Phases are recorded in
+///		first-use order; repeated phases accumulate.  Only intended for use
+///		from a single thread.
+///	</summary>
+class Profiler {
+
+public:
+	///	<summary>
+	///		Constructor.
+	///	</summary>
+	Profiler() :
+		m_fEnabled(false),
+		m_fPhaseActive(false)
+	{ }
+
+	///	<summary>
+	///		Enable the profiler.
+	///	</summary>
+	void Enable() {
+		m_fEnabled = true;
+	}
+
+	///	<summary>
+	///		Determine if the profiler is enabled.
+	///	</summary>
+	bool IsEnabled() const {
+		return m_fEnabled;
+	}
+
+public:
+	///	<summary>
+	///		Begin timing the named phase.  Phases may not be nested.
+	///	</summary>
+	void StartPhase(const char * szPhase) {
+		if (!m_fEnabled) {
+			return;
+		}
+		_ASSERT(!m_fPhaseActive);
+		m_fPhaseActive = true;
+		m_strActivePhase = szPhase;
+		m_timePhaseBegin = std::chrono::steady_clock::now();
+	}
+
+	///	<summary>
+	///		End timing of the active phase, accumulating its elapsed time.
+	///	</summary>
+	void EndPhase() {
+		if (!m_fEnabled) {
+			return;
+		}
+		_ASSERT(m_fPhaseActive);
+		m_fPhaseActive = false;
+
+		auto timePhaseEnd = std::chrono::steady_clock::now();
+		AddTime(m_strActivePhase,
+			std::chrono::duration<double>(
+				timePhaseEnd - m_timePhaseBegin).count());
+	}
+
+	///	<summary>
+	///		Accumulate an externally measured time into the named phase.
+	///	</summary>
+	void AddTime(
+		const std::string & strPhase,
+		double dSeconds
+	) {
+		if (!m_fEnabled) {
+			return;
+		}
+		for (size_t s = 0; s < m_vecPhases.size(); s++) {
+			if (m_vecPhases[s].first == strPhase) {
+				m_vecPhases[s].second += dSeconds;
+				return;
+			}
+		}
+		m_vecPhases.push_back(
+			std::pair<std::string, double>(strPhase, dSeconds));
+	}
+
+public:
+	///	<summary>
+	///		Number of recorded phases.
+	///	</summary>
+	size_t size() const {
+		return m_vecPhases.size();
+	}
+
+	///	<summary>
+	///		Name of the given phase, in first-use order.
+	///	</summary>
+	const std::string & GetPhaseName(size_t s) const {
+		_ASSERT(s < m_vecPhases.size());
+		return m_vecPhases[s].first;
+	}
+
+	///	<summary>
+	///		Accumulated time of the given phase (seconds).
+	///	</summary>
+	double GetPhaseTime(size_t s) const {
+		_ASSERT(s < m_vecPhases.size());
+		return m_vecPhases[s].second;
+	}
+
+protected:
+	///	<summary>
+	///		Set when the profiler is enabled.
+	///	</summary>
+	bool m_fEnabled;
+
+	///	<summary>
+	///		Set when a phase is being timed.
+	///	</summary>
+	bool m_fPhaseActive;
+
+	///	<summary>
+	///		Name of the active phase.
+	///	</summary>
+	std::string m_strActivePhase;
+
+	///	<summary>
+	///		Start time of the active phase.
+	///	</summary>
+	std::chrono::steady_clock::time_point m_timePhaseBegin;
+
+	///	<summary>
+	///		Accumulated (phase name, seconds) pairs, in first-use order.
+	///	</summary>
+	std::vector<std::pair<std::string, double> > m_vecPhases;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+#endif // _PROFILER_H_
@@ -0,0 +1,212 @@
+///////////////////////////////////////////////////////////////////////////////
+///
+///	\file    RemoveDirectoryTree.h
+///	\author  Paul Ullrich
+///	\version September 1, 2026
+///
+///	<remarks>
+///		Copyright (c) 2020 Paul Ullrich
+///
+///		Distributed under the BSD 3-Clause License.
+///		(See accompanying file LICENSE)
+///	</remarks>
+
+#ifndef _REMOVEDIRECTORYTREE_H_
+#define _REMOVEDIRECTORYTREE_H_
+
+///////////////////////////////////////////////////////////////////////////////
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Remove the contents of the directory referred to by the given open
+///		descriptor using openat/unlinkat traversal, so no path is resolved
+///		more than once.  Takes ownership of the descriptor.  Returns the
+///		number of entries that could not be removed.
+///	</summary>
+inline size_t RemoveDirectoryContentsByFd(
+	int fd
+) {
+	size_t nErrors = 0;
+
+	DIR * pDir = fdopendir(fd);
+	if (pDir == NULL) {
+		close(fd);
+		return 1;
+	}
+
+	struct dirent * pDirent;
+	while ((pDirent = readdir(pDir)) != NULL) {
+		if ((strcmp(pDirent->d_name, ".") == 0) ||
+		    (strcmp(pDirent->d_name, "..") == 0)
+		) {
+			continue;
+		}
+
+		// Non-directories unlink directly, identifying subdirectories by
+		// the unlink errno without an extra stat per entry.  Linux
+		// reports EISDIR for a directory here but POSIX specifies EPERM
+		// (which macOS/BSD return, and which a protected file can also
+		// produce), so directory-ness is confirmed by the O_DIRECTORY
+		// open below rather than by errno alone:  a genuinely
+		// EPERM-protected file fails that open and is counted as an
+		// error.
+		if (unlinkat(dirfd(pDir), pDirent->d_name, 0) == 0) {
+			continue;
+		}
+		if ((errno != EISDIR) && (errno != EPERM)) {
+			nErrors++;
+			continue;
+		}
+
+		int fdChild =
+			openat(dirfd(pDir), pDirent->d_name,
+				O_RDONLY | O_DIRECTORY | O_NOFOLLOW | O_CLOEXEC);
+		if (fdChild < 0) {
+			nErrors++;
+			continue;
+		}
+
+		nErrors += RemoveDirectoryContentsByFd(fdChild);
+
+		if (unlinkat(dirfd(pDir), pDirent->d_name, AT_REMOVEDIR) != 0) {
+			nErrors++;
+		}
+	}
+
+	closedir(pDir);
+
+	return nErrors;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Remove the directory tree rooted at the given path, distributing
+///		its immediate subtrees across a pool of worker threads.  Parallel
+///		removal substantially reduces wall time on network filesystems,
+///		where single-threaded removal of many small files is dominated by
+///		serialized metadata latency.  Passing zero workers selects a
+///		count from the hardware concurrency.  Returns the number of
+///		entries that could not be removed (zero on success).
+///	</summary>
+inline size_t RemoveDirectoryTree(
+	const std::string & strPath,
+	size_t nWorkers = 0
+) {
+	int fdRoot =
+		open(strPath.c_str(),
+			O_RDONLY | O_DIRECTORY | O_NOFOLLOW | O_CLOEXEC);
+	if (fdRoot < 0) {
+		return 1;
+	}
+
+	DIR * pRoot = fdopendir(fdRoot);
+	if (pRoot == NULL) {
+		close(fdRoot);
+		return 1;
+	}
+
+	std::atomic<size_t> sErrorCount(0);
+
+	// Unlink top-level files directly; collect top-level subdirectories
+	// as parallel work units
+	std::vector<std::string> vecSubdirNames;
+
+	struct dirent * pDirent;
+	while ((pDirent = readdir(pRoot)) != NULL) {
+		if ((strcmp(pDirent->d_name, ".") == 0) ||
+		    (strcmp(pDirent->d_name, "..") == 0)
+		) {
+			continue;
+		}
+		if (unlinkat(dirfd(pRoot), pDirent->d_name, 0) == 0) {
+			continue;
+		}
+		// EPERM is the POSIX (macOS/BSD) counterpart of EISDIR; an
+		// EPERM-protected file pushed here fails the worker's
+		// O_DIRECTORY open and is counted as an error there
+		if ((errno != EISDIR) && (errno != EPERM)) {
+			sErrorCount++;
+			continue;
+		}
+		vecSubdirNames.push_back(pDirent->d_name);
+	}
+
+	// Remove each subtree, pulled off a shared queue by the worker pool
+	std::atomic<size_t> sNextSubdir(0);
+
+	auto WorkerLoop = [&]() {
+		for (;;) {
+			size_t s = sNextSubdir.fetch_add(1);
+			if (s >= vecSubdirNames.size()) {
+				break;
+			}
+
+			int fdSubdir =
+				openat(dirfd(pRoot), vecSubdirNames[s].c_str(),
+					O_RDONLY | O_DIRECTORY | O_NOFOLLOW | O_CLOEXEC);
+			if (fdSubdir < 0) {
+				sErrorCount++;
+				continue;
+			}
+
+			sErrorCount += RemoveDirectoryContentsByFd(fdSubdir);
+
+			if (unlinkat(dirfd(pRoot), vecSubdirNames[s].c_str(),
+			             AT_REMOVEDIR) != 0
+			) {
+				sErrorCount++;
+			}
+		}
+	};
+
+	if (nWorkers == 0) {
+		nWorkers = std::thread::hardware_concurrency();
+		if (nWorkers == 0) {
+			nWorkers = 1;
+		}
+		if (nWorkers > 8) {
+			nWorkers = 8;
+		}
+	}
+	if (nWorkers > vecSubdirNames.size()) {
+		nWorkers = vecSubdirNames.size();
+	}
+
+	if (nWorkers <= 1) {
+		WorkerLoop();
+
+	} else {
+		std::vector<std::thread> vecWorkers;
+		for (size_t w = 0; w < nWorkers; w++) {
+			vecWorkers.push_back(std::thread(WorkerLoop));
+		}
+		for (size_t w = 0; w < vecWorkers.size(); w++) {
+			vecWorkers[w].join();
+		}
+	}
+
+	closedir(pRoot);
+
+	if (rmdir(strPath.c_str()) != 0) {
+		sErrorCount++;
+	}
+
+	return sErrorCount;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+#endif // _REMOVEDIRECTORYTREE_H_
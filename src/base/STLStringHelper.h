@@ -18,9 +18,14 @@
 #define _STLSTRINGHELPER_H_
 
 #include <string>
+#include <vector>
 
 #include <cstring>
 
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
 ///	<summary>
 ///		This class exposes additional functionality which can be used to
 ///		supplement the STL string class.
@@ -34,11 +39,93 @@ STLStringHelper() { }
 
 public:
 
+///	<summary>
+///		A non-owning view of a character range, as produced by Split().
+///		Stands in for std::string_view, which is unavailable in C++11.
+///		Views are only valid while the underlying string is alive and
+///		unmodified.
+///	</summary>
+struct StringView {
+	const char * szData;
+	size_t sLength;
+
+	///	<summary>
+	///		Materialize the view as a std::string.
+	///	</summary>
+	std::string str() const {
+		return std::string(szData, sLength);
+	}
+
+	///	<summary>
+	///		Compare the view against a NUL-terminated string.
+	///	</summary>
+	bool operator==(const char * sz) const {
+		return ((strncmp(szData, sz, sLength) == 0) &&
+		        (sz[sLength] == '\0'));
+	}
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Split the given string on the given delimiter into non-owning
+///		views over the string's buffer.  No per-token substr allocation
+///		is performed; the only allocation is the token vector itself,
+///		whose capacity is reused across calls.  Empty tokens are
+///		retained.
+///	</summary>
+inline static void Split(
+	const std::string & str,
+	char cDelim,
+	std::vector<StringView> & vecTokens
+) {
+	vecTokens.clear();
+
+	const char * szBegin = str.c_str();
+	const char * szEnd = szBegin + str.length();
+	const char * szToken = szBegin;
+
+	for (const char * sz = szBegin; ; sz++) {
+		if ((sz == szEnd) || (*sz == cDelim)) {
+			StringView view;
+			view.szData = szToken;
+			view.sLength = static_cast<size_t>(sz - szToken);
+			vecTokens.push_back(view);
+
+			if (sz == szEnd) {
+				break;
+			}
+			szToken = sz + 1;
+		}
+	}
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 
 inline static void ToLower(std::string &str) {
-	unsigned int i;
-	for(i = 0; i < str.length(); i++) {
+	size_t i = 0;
+#if defined(__SSE2__)
+	// Bulk path:  add 0x20 to every byte in ['A','Z'], 16 bytes at a
+	// time.  Signed compares suffice since the uppercase range is
+	// entirely below 0x80.
+	if (str.length() >= 16) {
+		char * sz = &(str[0]);
+		const __m128i vA = _mm_set1_epi8('A' - 1);
+		const __m128i vZ = _mm_set1_epi8('Z' + 1);
+		const __m128i vCase = _mm_set1_epi8(0x20);
+		for (; i + 16 <= str.length(); i += 16) {
+			__m128i v = _mm_loadu_si128(
+				reinterpret_cast<const __m128i *>(sz + i));
+			__m128i mask = _mm_and_si128(
+				_mm_cmpgt_epi8(v, vA),
+				_mm_cmpgt_epi8(vZ, v));
+			v = _mm_add_epi8(v, _mm_and_si128(mask, vCase));
+			_mm_storeu_si128(
+				reinterpret_cast<__m128i *>(sz + i), v);
+		}
+	}
+#endif
+	for(; i < str.length(); i++) {
 		str[i] = tolower(str[i]);
 	}
 }
@@ -46,8 +133,28 @@ inline static void ToLower(std::string &str) {
 ///////////////////////////////////////////////////////////////////////////////
 
 inline static void ToUpper(std::string &str) {
-	unsigned int i;
-	for(i = 0; i < str.length(); i++) {
+	size_t i = 0;
+#if defined(__SSE2__)
+	// Bulk path:  subtract 0x20 from every byte in ['a','z'], 16 bytes
+	// at a time.
+	if (str.length() >= 16) {
+		char * sz = &(str[0]);
+		const __m128i va = _mm_set1_epi8('a' - 1);
+		const __m128i vz = _mm_set1_epi8('z' + 1);
+		const __m128i vCase = _mm_set1_epi8(0x20);
+		for (; i + 16 <= str.length(); i += 16) {
+			__m128i v = _mm_loadu_si128(
+				reinterpret_cast<const __m128i *>(sz + i));
+			__m128i mask = _mm_and_si128(
+				_mm_cmpgt_epi8(v, va),
+				_mm_cmpgt_epi8(vz, v));
+			v = _mm_sub_epi8(v, _mm_and_si128(mask, vCase));
+			_mm_storeu_si128(
+				reinterpret_cast<__m128i *>(sz + i), v);
+		}
+	}
+#endif
+	for(; i < str.length(); i++) {
 		str[i] = toupper(str[i]);
 	}
 }
@@ -25,6 +25,10 @@
 #include <type_traits>
 #include <cstddef>
 
+#if defined(DEBUG_ARRAYOUTOFBOUNDS)
+#include "Exception.h"
+#endif
+
 ///////////////////////////////////////////////////////////////////////////////
 
 template <typename T, size_t size>
@@ -157,5 +161,107 @@ struct Subscript<T, 1, NumDims>
 	} 
 };
 
+///////////////////////////////////////////////////////////////////////////////
+
+// Fixed-rank, fixed-extent subscript machinery.  When extents are known at
+// compile time the flattened index is a constant expression over the
+// trailing extents, so indexing folds to a single multiply-add and
+// fixed-extent inner loops fully unroll.
+
+template <std::ptrdiff_t... Extents>
+struct FixedSubscript;
+
+template <std::ptrdiff_t Extent>
+struct FixedSubscript<Extent>
+{
+	typedef std::ptrdiff_t size_type;
+
+	enum { Rank = 1 };
+	enum { TotalSize = Extent };
+
+#if defined(__INTEL_COMPILER)
+	static constexpr size_type Index(size_type idx)
+#else
+	static constexpr size_type Index(size_type idx) noexcept
+#endif
+	{
+		return idx;
+	}
+};
+
+template <std::ptrdiff_t Extent, std::ptrdiff_t... Extents>
+struct FixedSubscript<Extent, Extents...>
+{
+	typedef std::ptrdiff_t size_type;
+
+	enum { Rank = 1 + sizeof...(Extents) };
+	enum { TotalSize = Extent * FixedSubscript<Extents...>::TotalSize };
+
+	template <typename... Indices>
+#if defined(__INTEL_COMPILER)
+	static constexpr size_type Index(size_type idx, Indices... indices)
+#else
+	static constexpr size_type Index(size_type idx, Indices... indices) noexcept
+#endif
+	{
+		// Strides derive from the trailing extents only.
+		return idx * FixedSubscript<Extents...>::TotalSize
+			+ FixedSubscript<Extents...>::Index(indices...);
+	}
+};
+
+// A non-owning view of contiguous array data with compile-time extents.
+// Obtained from the DataArray classes via GetFixedView(), which checks the
+// runtime sizes against the template extents once; thereafter every access
+// indexes through FixedSubscript with no runtime size lookups.
+
+template <typename T, std::ptrdiff_t... Extents>
+struct FixedSizeView
+{
+	typedef std::ptrdiff_t size_type;
+	typedef FixedSubscript<Extents...> subscript_type;
+
+	T* data_;
+
+#if defined(__INTEL_COMPILER)
+	explicit constexpr FixedSizeView(T* data)
+#else
+	explicit constexpr FixedSizeView(T* data) noexcept
+#endif
+	  : data_(data) {}
+
+	template <typename... Indices>
+#if defined(__INTEL_COMPILER)
+	inline T& operator()(Indices... indices) const
+#else
+	inline T& operator()(Indices... indices) const noexcept
+#endif
+	{
+		static_assert(
+			sizeof...(Indices) == subscript_type::Rank,
+			"index count must match view rank");
+#if defined(DEBUG_ARRAYOUTOFBOUNDS)
+		size_type idx = subscript_type::Index(indices...);
+		if ((idx < 0) || (idx >= subscript_type::TotalSize)) {
+			_EXCEPTIONT("Array access out of bounds");
+		}
+		return data_[idx];
+#else
+		return data_[subscript_type::Index(indices...)];
+#endif
+	}
+
+#if defined(__INTEL_COMPILER)
+	inline T* data() const
+#else
+	inline T* data() const noexcept
+#endif
+	{
+		return data_;
+	}
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
 #endif // _SUBSCRIPT_H_
 
@@ -22,6 +22,18 @@
 
 ///////////////////////////////////////////////////////////////////////////////
 
+// Integer division rounding towards negative infinity.
+template <typename T>
+static T FloorDiv(T a, T b) {
+	T q = a / b;
+	if ((a % b != 0) && ((a < 0) != (b < 0))) {
+		q--;
+	}
+	return q;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
 bool Time::operator==(const Time & time) const {
 	if ((m_eCalendarType != time.m_eCalendarType) ||
 	    (m_eTimeType     != time.m_eTimeType)     ||
@@ -201,35 +213,17 @@ void Time::NormalizeTime() {
 		}
 
 		// Add seconds
-		int nAddedSeconds = 0;
-		if (m_iMicroSecond >= 1000000) {
-			nAddedSeconds = m_iMicroSecond / 1000000;
-
-		} else if (m_iMicroSecond < 0) {
-			nAddedSeconds = - (1000000 - m_iSecond) / 1000000;
-		}
+		int nAddedSeconds = FloorDiv(m_iMicroSecond, 1000000);
 		m_iMicroSecond -= nAddedSeconds * 1000000;
 		m_iSecond += nAddedSeconds;
 
 		// Add days
-		int nAddedDays = 0;
-		if (m_iSecond >= 86400) {
-			nAddedDays = m_iSecond / 86400;
-
-		} else if (m_iSecond < 0) {
-			nAddedDays = - (86400 - m_iSecond) / 86400;
-		}
-
+		int nAddedDays = FloorDiv(m_iSecond, 86400);
 		m_iSecond -= nAddedDays * 86400;
 		m_iDay += nAddedDays;
 
 		// Add years
-		int nAddedYears = 0;
-		if (m_iMonth >= 12) {
-			nAddedYears = m_iMonth / 12;
-		} else if (m_iMonth < 0) {
-			nAddedYears = - (12 - m_iMonth) / 12;
-		}
+		int nAddedYears = FloorDiv(m_iMonth, 12);
 		m_iMonth -= nAddedYears * 12;
 		m_iYear += nAddedYears;
 
@@ -400,6 +394,204 @@ double Time::DeltaDays(const Time & time) const {
 
 ///////////////////////////////////////////////////////////////////////////////
 
+// Day offset from the start of the (March-based) computational year to the
+// start of each zero-indexed calendar month, equal to (nM * 306 + 5) / 10
+// with nM = (month + 10) % 12 (see DayNumber()), and the corresponding
+// year adjustment for months preceding March.
+static const int s_nMonthDayOffset[12] =
+	{306, 337, 0, 31, 61, 92, 122, 153, 184, 214, 245, 275};
+
+static const int s_nMonthYearAdjust[12] =
+	{1, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0};
+
+///////////////////////////////////////////////////////////////////////////////
+
+void Time::AddSecondsToTimeArray(
+	const Time & timeBase,
+	const DataArray1D<double> & dSeconds,
+	std::vector<Time> & vecTimes
+) {
+	CalendarType eCalendarType = timeBase.m_eCalendarType;
+
+	if ((eCalendarType != CalendarNoLeap) &&
+	    (eCalendarType != CalendarStandard) &&
+	    (eCalendarType != CalendarGregorian) &&
+	    (eCalendarType != Calendar360Day)
+	) {
+		_EXCEPTIONT("Not implemented");
+	}
+
+	size_t sCount = dSeconds.GetRows();
+
+	vecTimes.resize(sCount);
+
+	// Hoist the base date out of the loop:  each entry only needs the
+	// base day number and time of day
+	const int nDayNumberBase = timeBase.DayNumber();
+	const long long llMicroSecondBase =
+		static_cast<long long>(timeBase.m_iSecond) * 1000000LL
+		+ static_cast<long long>(timeBase.m_iMicroSecond);
+
+	static const long long llMicroSecondsPerDay = 86400000000LL;
+
+	for (size_t i = 0; i < sCount; i++) {
+
+		// Split the offset into whole days and time of day
+		long long llMicroSecond = llMicroSecondBase
+			+ static_cast<long long>(llround(dSeconds[i] * 1.0e6));
+
+		long long llDays = FloorDiv(llMicroSecond, llMicroSecondsPerDay);
+		llMicroSecond -= llDays * llMicroSecondsPerDay;
+
+		int nDayNumber = nDayNumberBase + static_cast<int>(llDays);
+
+		// Recover the date from the day number (inverse of DayNumber())
+		int iYear;
+		int iMonth;
+		int iDay;
+
+		if (eCalendarType == Calendar360Day) {
+			iYear = FloorDiv(nDayNumber, 360);
+			int nRemainder = nDayNumber - 360 * iYear;
+			iMonth = nRemainder / 30;
+			iDay = nRemainder % 30;
+
+		} else {
+			int nY;
+			int nDDD;
+
+			if (eCalendarType == CalendarNoLeap) {
+				nY = FloorDiv(nDayNumber, 365);
+				nDDD = nDayNumber - 365 * nY;
+
+			} else {
+				nY = static_cast<int>(FloorDiv(
+					10000LL * static_cast<long long>(nDayNumber) + 14780LL,
+					3652425LL));
+				nDDD = nDayNumber
+					- (365 * nY + nY / 4 - nY / 100 + nY / 400);
+				while (nDDD < 0) {
+					nY--;
+					nDDD = nDayNumber
+						- (365 * nY + nY / 4 - nY / 100 + nY / 400);
+				}
+			}
+
+			int nM = (100 * nDDD + 52) / 3060;
+			iMonth = (nM + 2) % 12;
+			iYear = nY + (nM + 2) / 12;
+			iDay = nDDD - (nM * 306 + 5) / 10;
+		}
+
+		vecTimes[i] = Time(
+			iYear,
+			iMonth,
+			iDay,
+			static_cast<int>(llMicroSecond / 1000000LL),
+			static_cast<int>(llMicroSecond % 1000000LL),
+			eCalendarType,
+			timeBase.m_eTimeType);
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void Time::DeltaSecondsBetweenArrays(
+	const std::vector<Time> & vecTimes1,
+	const std::vector<Time> & vecTimes2,
+	DataArray1D<double> & dDeltaSeconds
+) {
+	if (vecTimes1.size() != vecTimes2.size()) {
+		_EXCEPTIONT("Size mismatch between Time arrays");
+	}
+
+	dDeltaSeconds.Allocate(vecTimes1.size());
+
+	if (vecTimes1.size() == 0) {
+		return;
+	}
+
+	// Verify all entries share one calendar so dispatch can be hoisted
+	// out of the day number calculation
+	CalendarType eCalendarType = vecTimes1[0].m_eCalendarType;
+
+	for (size_t i = 0; i < vecTimes1.size(); i++) {
+		if ((vecTimes1[i].m_eCalendarType != eCalendarType) ||
+		    (vecTimes2[i].m_eCalendarType != eCalendarType)
+		) {
+			_EXCEPTIONT("CalendarType mismatch between Time arrays");
+		}
+	}
+
+	if (eCalendarType == CalendarNoLeap) {
+		for (size_t i = 0; i < vecTimes1.size(); i++) {
+			const Time & t1 = vecTimes1[i];
+			const Time & t2 = vecTimes2[i];
+
+			int nY1 = t1.m_iYear - s_nMonthYearAdjust[t1.m_iMonth];
+			int nY2 = t2.m_iYear - s_nMonthYearAdjust[t2.m_iMonth];
+
+			int nDayNumber1 =
+				365 * nY1 + s_nMonthDayOffset[t1.m_iMonth] + t1.m_iDay;
+			int nDayNumber2 =
+				365 * nY2 + s_nMonthDayOffset[t2.m_iMonth] + t2.m_iDay;
+
+			dDeltaSeconds[i] =
+				static_cast<double>(nDayNumber2 - nDayNumber1) * 86400.0
+				+ static_cast<double>(t2.m_iSecond - t1.m_iSecond)
+				+ static_cast<double>(
+					t2.m_iMicroSecond - t1.m_iMicroSecond) / 1.0e6;
+		}
+
+	} else if (
+		(eCalendarType == CalendarStandard) ||
+		(eCalendarType == CalendarGregorian)
+	) {
+		for (size_t i = 0; i < vecTimes1.size(); i++) {
+			const Time & t1 = vecTimes1[i];
+			const Time & t2 = vecTimes2[i];
+
+			int nY1 = t1.m_iYear - s_nMonthYearAdjust[t1.m_iMonth];
+			int nY2 = t2.m_iYear - s_nMonthYearAdjust[t2.m_iMonth];
+
+			int nDayNumber1 =
+				365 * nY1 + nY1 / 4 - nY1 / 100 + nY1 / 400
+				+ s_nMonthDayOffset[t1.m_iMonth] + t1.m_iDay;
+			int nDayNumber2 =
+				365 * nY2 + nY2 / 4 - nY2 / 100 + nY2 / 400
+				+ s_nMonthDayOffset[t2.m_iMonth] + t2.m_iDay;
+
+			dDeltaSeconds[i] =
+				static_cast<double>(nDayNumber2 - nDayNumber1) * 86400.0
+				+ static_cast<double>(t2.m_iSecond - t1.m_iSecond)
+				+ static_cast<double>(
+					t2.m_iMicroSecond - t1.m_iMicroSecond) / 1.0e6;
+		}
+
+	} else if (eCalendarType == Calendar360Day) {
+		for (size_t i = 0; i < vecTimes1.size(); i++) {
+			const Time & t1 = vecTimes1[i];
+			const Time & t2 = vecTimes2[i];
+
+			int nDayNumber1 =
+				360 * t1.m_iYear + 30 * t1.m_iMonth + t1.m_iDay;
+			int nDayNumber2 =
+				360 * t2.m_iYear + 30 * t2.m_iMonth + t2.m_iDay;
+
+			dDeltaSeconds[i] =
+				static_cast<double>(nDayNumber2 - nDayNumber1) * 86400.0
+				+ static_cast<double>(t2.m_iSecond - t1.m_iSecond)
+				+ static_cast<double>(
+					t2.m_iMicroSecond - t1.m_iMicroSecond) / 1.0e6;
+		}
+
+	} else {
+		_EXCEPTIONT("Not implemented");
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
 std::string Time::ToDateString() const {
 	char szBuffer[100];
 
@@ -828,6 +1020,341 @@ void Time::FromFormattedString(
 
 ///////////////////////////////////////////////////////////////////////////////
 
+void TimeFormat::Compile(
+	const std::string & strFormattedTime
+) {
+	m_fCompiled = false;
+	m_fFixedFormat = false;
+	m_vecTokens.clear();
+
+	// A zero-length format matches only zero-length strings
+	if (strFormattedTime.length() == 0) {
+		m_fCompiled = true;
+		m_fFixedFormat = true;
+		return;
+	}
+
+	// Fields assigned so far
+	bool fHasField[7] = {false, false, false, false, false, false, false};
+
+	// Current state (mirroring Time::FromFormattedString())
+	enum FormatState {
+		FormatState_Date,
+		FormatState_Time,
+		FormatState_Free
+	};
+
+	FormatState state = FormatState_Date;
+
+	// Assign the segment preceding the given delimiter to a field
+	auto PushToken = [&](TimeField eField, char chDelimiter) {
+		if (fHasField[eField]) {
+			_EXCEPTION1("Malformed Time string (%s): "
+				"Field appears twice",
+				strFormattedTime.c_str());
+		}
+		fHasField[eField] = true;
+
+		FormatToken token;
+		token.eField = eField;
+		token.chDelimiter = chDelimiter;
+		m_vecTokens.push_back(token);
+	};
+
+	// Loop over all characters in string
+	int i = 0;
+	int j = 0;
+	for (; i < strFormattedTime.length(); i++) {
+
+		// Digit (ignore)
+		if ((strFormattedTime[i] >= '0') &&
+			(strFormattedTime[i] <= '9')
+		) {
+			continue;
+		}
+
+		// Record in Date format (yyyy-MM-dd-sssss)
+		if ((strFormattedTime[i] == '-') ||
+		    (strFormattedTime[i] == ' ')
+		) {
+			if (state != FormatState_Date) {
+				break;
+			}
+
+			if (!fHasField[FieldYear]) {
+				PushToken(FieldYear, strFormattedTime[i]);
+
+			} else if (!fHasField[FieldMonth]) {
+				PushToken(FieldMonth, strFormattedTime[i]);
+
+			} else if (!fHasField[FieldDay]) {
+				PushToken(FieldDay, strFormattedTime[i]);
+
+			} else {
+				_EXCEPTION1("Malformed Time string (%s): "
+					"Unexpected \'-\'",
+					strFormattedTime.c_str());
+			}
+			j = i + 1;
+
+		// Record in Time format (hh:mm:ss.uuuuuu)
+		} else if (
+			(strFormattedTime[i] == ':') ||
+			(strFormattedTime[i] == '.')
+		) {
+			if (state == FormatState_Free) {
+				_EXCEPTION1(
+					"Malformed Time string (%s): "
+						"Cannot mix formatting types",
+						strFormattedTime.c_str());
+			}
+
+			state = FormatState_Time;
+
+			if (!fHasField[FieldHour]) {
+				PushToken(FieldHour, strFormattedTime[i]);
+
+			} else if (!fHasField[FieldMinute]) {
+				PushToken(FieldMinute, strFormattedTime[i]);
+
+			} else if (!fHasField[FieldSecond]) {
+				PushToken(FieldSecond, strFormattedTime[i]);
+
+			} else {
+				_EXCEPTION1(
+					"Malformed Time string (%s): "
+						"Unexpected \':\' or \'.\'",
+						strFormattedTime.c_str());
+			}
+			j = i + 1;
+
+		// Record in Free format (##y##M##d##m##s##u)
+		} else {
+			if (state == FormatState_Time) {
+				_EXCEPTION1(
+					"Malformed Time string (%s): "
+						"Cannot mix Free and Time format",
+						strFormattedTime.c_str());
+			}
+			if ((state == FormatState_Date) && (j != 0)) {
+				_EXCEPTION1(
+					"Malformed Time string (%s): "
+						"Cannot mix Free and Date format",
+						strFormattedTime.c_str());
+			}
+
+			state = FormatState_Free;
+
+			if (strFormattedTime[i] == 'y') {
+				PushToken(FieldYear, 'y');
+
+			} else if (strFormattedTime[i] == 'M') {
+				PushToken(FieldMonth, 'M');
+
+			} else if (strFormattedTime[i] == 'd') {
+				PushToken(FieldDay, 'd');
+
+			} else if (strFormattedTime[i] == 'h') {
+				PushToken(FieldHour, 'h');
+
+			} else if (strFormattedTime[i] == 'm') {
+				PushToken(FieldMinute, 'm');
+
+			} else if (strFormattedTime[i] == 's') {
+				PushToken(FieldSecond, 's');
+
+			} else if (strFormattedTime[i] == 'u') {
+				PushToken(FieldMicroSecond, 'u');
+
+			} else {
+				_EXCEPTION2("Malformed Time string (%s): "
+					"Unexpected character \'%c\'",
+					strFormattedTime.c_str(),
+					strFormattedTime[i]);
+			}
+
+			// Increment location pointer
+			j = i + 1;
+		}
+	}
+
+	// Finalize formatting
+	if (i != j) {
+
+		// Date format
+		if (state == FormatState_Date) {
+			if (!fHasField[FieldYear]) {
+				PushToken(FieldYear, '\0');
+
+			} else if (!fHasField[FieldMonth]) {
+				PushToken(FieldMonth, '\0');
+
+			} else if (!fHasField[FieldDay]) {
+				PushToken(FieldDay, '\0');
+
+			} else if (!fHasField[FieldSecond]) {
+				PushToken(FieldSecond, '\0');
+
+			} else {
+				_EXCEPTION1("Malformed time string (%s): "
+					"Extraneous value at end",
+					strFormattedTime.c_str());
+			}
+
+		// Time format
+		} else if (state == FormatState_Time) {
+			if (!fHasField[FieldMinute]) {
+				PushToken(FieldMinute, '\0');
+
+			} else if (!fHasField[FieldSecond]) {
+				PushToken(FieldSecond, '\0');
+
+			} else if (!fHasField[FieldMicroSecond]) {
+				PushToken(FieldMicroSecond, '\0');
+
+			} else {
+				_EXCEPTION1("Malformed time string (%s): "
+					"Extraneous value at end",
+					strFormattedTime.c_str());
+			}
+
+		// Free format
+		} else {
+			_EXCEPTION1("Malformed time string (%s): "
+				"Dangling values not allowed in Free formatting",
+				strFormattedTime.c_str());
+		}
+	}
+
+	if (m_vecTokens.size() == 0) {
+		_EXCEPTION1("Malformed time string (%s): "
+			"No formatting characters detected",
+			strFormattedTime.c_str());
+	}
+
+	m_fFixedFormat =
+		((state == FormatState_Date) || (state == FormatState_Time));
+
+	m_fCompiled = true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+bool TimeFormat::Apply(
+	const std::string & strFormattedTime,
+	Time & time
+) const {
+	if (!m_fCompiled) {
+		return false;
+	}
+
+	int iYear = 0;
+	int iMonth = 0;
+	int iDay = 0;
+	int iSecond = 0;
+	int iMicroSecond = 0;
+
+	// Parse one digit run per token and check its delimiter; all values
+	// accumulate in locals so a mismatch leaves the Time unmodified
+	size_t s = 0;
+	for (size_t t = 0; t < m_vecTokens.size(); t++) {
+		size_t sBegin = s;
+		int nValue = 0;
+		for (; s < strFormattedTime.length(); s++) {
+			char c = strFormattedTime[s];
+			if ((c < '0') || (c > '9')) {
+				break;
+			}
+			nValue = 10 * nValue + (c - '0');
+		}
+		if (s == sBegin) {
+			return false;
+		}
+
+		if (m_vecTokens[t].chDelimiter == '\0') {
+			if (s != strFormattedTime.length()) {
+				return false;
+			}
+		} else {
+			if ((s >= strFormattedTime.length()) ||
+			    (strFormattedTime[s] != m_vecTokens[t].chDelimiter)
+			) {
+				return false;
+			}
+			s++;
+		}
+
+		switch (m_vecTokens[t].eField) {
+			case FieldYear:
+				iYear = nValue;
+				break;
+			case FieldMonth:
+				iMonth = (m_fFixedFormat)?(nValue - 1):(nValue);
+				break;
+			case FieldDay:
+				iDay = (m_fFixedFormat)?(nValue - 1):(nValue);
+				break;
+			case FieldHour:
+				iSecond += 3600 * nValue;
+				break;
+			case FieldMinute:
+				iSecond += 60 * nValue;
+				break;
+			case FieldSecond:
+				iSecond += nValue;
+				break;
+			case FieldMicroSecond:
+				iMicroSecond = nValue;
+				break;
+		}
+	}
+	if (s != strFormattedTime.length()) {
+		return false;
+	}
+
+	time.m_iYear = iYear;
+	time.m_iMonth = iMonth;
+	time.m_iDay = iDay;
+	time.m_iSecond = iSecond;
+	time.m_iMicroSecond = iMicroSecond;
+
+	if (m_vecTokens.size() != 0) {
+		time.m_eTimeType =
+			(m_fFixedFormat)?(Time::TypeFixed):(Time::TypeDelta);
+
+		time.NormalizeTime();
+	}
+
+	return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void Time::ParseTimeArray(
+	const Time & timeTemplate,
+	const std::vector<std::string> & vecTimeStrings,
+	std::vector<Time> & vecTimes
+) {
+	vecTimes.assign(vecTimeStrings.size(), timeTemplate);
+
+	TimeFormat format;
+
+	for (size_t i = 0; i < vecTimeStrings.size(); i++) {
+		if (format.IsCompiled() &&
+		    format.Apply(vecTimeStrings[i], vecTimes[i])
+		) {
+			continue;
+		}
+
+		// First entry, or a string that departs from the cached layout:
+		// parse with the full format analysis and recompile the cache
+		vecTimes[i].FromFormattedString(vecTimeStrings[i]);
+		format.Compile(vecTimeStrings[i]);
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
 void Time::FromCFCompliantUnitsOffsetInt(
 	const std::string & strFormattedTime,
 	int nOffset
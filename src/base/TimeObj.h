@@ -17,10 +17,12 @@
 #ifndef _TIMEOBJ_H_
 #define _TIMEOBJ_H_
 
+#include "DataArray1D.h"
 #include "Exception.h"
 #include "STLStringHelper.h"
 
 #include <string>
+#include <vector>
 #include <cstdlib>
 #include <cmath>
 
@@ -30,6 +32,7 @@
 ///		A class for storing a time as year, month, day, seconds and useconds.
 ///	</summary>
 class Time {
+	friend class TimeFormat;
 
 public:
 	///	<summary>
@@ -327,6 +330,46 @@ public:
 	///	</summary>
 	double DeltaDays(const Time & time) const;
 
+public:
+	///	<summary>
+	///		Batch conversion of an array of second offsets (relative to the
+	///		given base Time) to an array of Times.  The calendar dispatch
+	///		is hoisted out of the loop and dates are recovered from day
+	///		numbers directly, so the cost per entry is constant.
+	///	</summary>
+	static void AddSecondsToTimeArray(
+		const Time & timeBase,
+		const DataArray1D<double> & dSeconds,
+		std::vector<Time> & vecTimes
+	);
+
+	///	<summary>
+	///		Batch calculation of the number of seconds from each Time in
+	///		the first array to the corresponding Time in the second array.
+	///		All Times must share one calendar, which is dispatched on once;
+	///		day numbers are computed inline from precomputed month offset
+	///		tables so the loop vectorizes.
+	///	</summary>
+	static void DeltaSecondsBetweenArrays(
+		const std::vector<Time> & vecTimes1,
+		const std::vector<Time> & vecTimes2,
+		DataArray1D<double> & dDeltaSeconds
+	);
+
+	///	<summary>
+	///		Batch conversion of an array of formatted time strings to an
+	///		array of Times, each initialized from the given template Time
+	///		(which supplies the calendar).  The format is compiled from
+	///		the first string and applied across subsequent strings in a
+	///		tight loop; a string that does not match the cached format is
+	///		parsed with FromFormattedString and the format recompiled.
+	///	</summary>
+	static void ParseTimeArray(
+		const Time & timeTemplate,
+		const std::vector<std::string> & vecTimeStrings,
+		std::vector<Time> & vecTimes
+	);
+
 public:
 	///	<summary>
 	///		Check if this object is zero.
@@ -564,5 +607,501 @@ private:
 
 ///////////////////////////////////////////////////////////////////////////////
 
+///	<summary>
+///		A formatted time string layout compiled into a token program.
+///		Compile() analyzes one sample string with the same state machine
+///		as Time::FromFormattedString() and records the sequence of fields
+///		and delimiters; Apply() then parses further strings of the same
+///		layout by scanning digit runs and checking delimiters, with none
+///		of the per-character format analysis.  Field widths may vary
+///		between strings; only the delimiter structure must match.
+///	</summary>
+class TimeFormat {
+
+public:
+	///	<summary>
+	///		Fields of a formatted time string.
+	///	</summary>
+	enum TimeField {
+		FieldYear,
+		FieldMonth,
+		FieldDay,
+		FieldHour,
+		FieldMinute,
+		FieldSecond,
+		FieldMicroSecond
+	};
+
+	///	<summary>
+	///		One token of the compiled format:  a digit run assigned to a
+	///		field, followed by the given delimiter character ('\0' at the
+	///		end of the string).
+	///	</summary>
+	struct FormatToken {
+		TimeField eField;
+		char chDelimiter;
+	};
+
+public:
+	///	<summary>
+	///		Constructor.
+	///	</summary>
+	TimeFormat() :
+		m_fCompiled(false),
+		m_fFixedFormat(false)
+	{ }
+
+	///	<summary>
+	///		Constructor which compiles the given sample string.
+	///	</summary>
+	explicit TimeFormat(const std::string & strFormattedTime) :
+		m_fCompiled(false),
+		m_fFixedFormat(false)
+	{
+		Compile(strFormattedTime);
+	}
+
+public:
+	///	<summary>
+	///		Compile the layout of the given formatted time string.
+	///	</summary>
+	void Compile(const std::string & strFormattedTime);
+
+	///	<summary>
+	///		Parse a formatted time string with the compiled layout into
+	///		the given Time, preserving its calendar.  Returns false,
+	///		leaving the Time unmodified, if the string does not match the
+	///		compiled layout.
+	///	</summary>
+	bool Apply(const std::string & strFormattedTime, Time & time) const;
+
+	///	<summary>
+	///		Determine if a format has been compiled.
+	///	</summary>
+	bool IsCompiled() const {
+		return m_fCompiled;
+	}
+
+private:
+	///	<summary>
+	///		A flag indicating a format has been compiled.
+	///	</summary>
+	bool m_fCompiled;
+
+	///	<summary>
+	///		A flag indicating the format is a fixed date/time (as opposed
+	///		to a free-format delta).
+	///	</summary>
+	bool m_fFixedFormat;
+
+	///	<summary>
+	///		The token program.
+	///	</summary>
+	std::vector<FormatToken> m_vecTokens;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Compile-time calendar traits for the no-leap (365 day) calendar.
+///		Each traits class exposes its month-length table and day number
+///		formula as constexpr functions, so CalendarTime<> arithmetic
+///		compiles down to straight-line code with no per-operation
+///		calendar dispatch.
+///	</summary>
+struct CalendarNoLeapTraits {
+	static const Time::CalendarType TypeValue = Time::CalendarNoLeap;
+
+	///	<summary>
+	///		Number of days in the given (zero-indexed) month.
+	///	</summary>
+	static constexpr int DaysInMonth(int iYear, int iMonth) {
+		return (iMonth == 1)?(28):
+			(((iMonth == 3) || (iMonth == 5) ||
+			  (iMonth == 8) || (iMonth == 10))?(30):(31));
+	}
+
+	///	<summary>
+	///		Day number of the given (zero-indexed) date.  Based on
+	///		https://alcor.concordia.ca/~gpkatch/gdate-algorithm.html
+	///		(see Time::DayNumber()).
+	///	</summary>
+	static constexpr int DayNumber(int iYear, int iMonth, int iDay) {
+		return 365 * (iYear - ((iMonth + 10) % 12) / 10)
+			+ (((iMonth + 10) % 12) * 306 + 5) / 10 + iDay;
+	}
+};
+
+///	<summary>
+///		Compile-time calendar traits for the Gregorian calendar.
+///	</summary>
+struct CalendarGregorianTraits {
+	static const Time::CalendarType TypeValue = Time::CalendarGregorian;
+
+	///	<summary>
+	///		Gregorian leap year rule.
+	///	</summary>
+	static constexpr bool IsLeapYear(int iYear) {
+		return ((iYear % 4) == 0) &&
+			(((iYear % 100) != 0) || ((iYear % 400) == 0));
+	}
+
+	///	<summary>
+	///		Number of days in the given (zero-indexed) month.
+	///	</summary>
+	static constexpr int DaysInMonth(int iYear, int iMonth) {
+		return (iMonth == 1)?((IsLeapYear(iYear))?(29):(28)):
+			(((iMonth == 3) || (iMonth == 5) ||
+			  (iMonth == 8) || (iMonth == 10))?(30):(31));
+	}
+
+	///	<summary>
+	///		Day number of the given (zero-indexed) date.
+	///	</summary>
+	static constexpr int DayNumber(int iYear, int iMonth, int iDay) {
+		return 365 * (iYear - ((iMonth + 10) % 12) / 10)
+			+ (iYear - ((iMonth + 10) % 12) / 10) / 4
+			- (iYear - ((iMonth + 10) % 12) / 10) / 100
+			+ (iYear - ((iMonth + 10) % 12) / 10) / 400
+			+ (((iMonth + 10) % 12) * 306 + 5) / 10 + iDay;
+	}
+};
+
+///	<summary>
+///		Compile-time calendar traits for the 360 day calendar.
+///	</summary>
+struct Calendar360DayTraits {
+	static const Time::CalendarType TypeValue = Time::Calendar360Day;
+
+	///	<summary>
+	///		Number of days in the given (zero-indexed) month.
+	///	</summary>
+	static constexpr int DaysInMonth(int iYear, int iMonth) {
+		return 30;
+	}
+
+	///	<summary>
+	///		Day number of the given (zero-indexed) date.
+	///	</summary>
+	static constexpr int DayNumber(int iYear, int iMonth, int iDay) {
+		return 360 * iYear + 30 * iMonth + iDay;
+	}
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		A fixed time with the calendar selected at compile time via a
+///		traits class.  Normalization and arithmetic are the same as the
+///		runtime-typed Time class but contain no calendar branches, so
+///		they inline into the innermost loop of time-axis computations.
+///		The runtime-typed Time class remains the representation at I/O
+///		boundaries; convert with FromTime()/ToTime().
+///	</summary>
+template <typename CalendarTraits>
+class CalendarTime {
+
+public:
+	///	<summary>
+	///		Constructor.
+	///	</summary>
+	CalendarTime() :
+		m_iYear(0),
+		m_iMonth(0),
+		m_iDay(0),
+		m_iSecond(0),
+		m_iMicroSecond(0)
+	{ }
+
+	///	<summary>
+	///		Constructor with zero-indexed month and day.
+	///	</summary>
+	CalendarTime(
+		int iYear,
+		int iMonth,
+		int iDay,
+		int iSecond,
+		int iMicroSecond
+	) :
+		m_iYear(iYear),
+		m_iMonth(iMonth),
+		m_iDay(iDay),
+		m_iSecond(iSecond),
+		m_iMicroSecond(iMicroSecond)
+	{
+		Normalize();
+	}
+
+	///	<summary>
+	///		Construct from a runtime-typed Time at an I/O boundary.  The
+	///		Time's calendar must match the compile-time calendar.
+	///	</summary>
+	static CalendarTime FromTime(const Time & time) {
+		if (time.GetCalendarType() != CalendarTraits::TypeValue) {
+			_EXCEPTIONT("CalendarType mismatch in CalendarTime::FromTime()");
+		}
+
+		CalendarTime caltime;
+		caltime.m_iYear = time.GetYear();
+		caltime.m_iMonth = time.GetMonth() - 1;
+		caltime.m_iDay = time.GetDay() - 1;
+		caltime.m_iSecond = time.GetSecond();
+		caltime.m_iMicroSecond = time.GetMicroSecond();
+		return caltime;
+	}
+
+	///	<summary>
+	///		Convert to a runtime-typed Time at an I/O boundary.
+	///	</summary>
+	Time ToTime() const {
+		return Time(m_iYear, m_iMonth, m_iDay, m_iSecond, m_iMicroSecond,
+			CalendarTraits::TypeValue);
+	}
+
+protected:
+	///	<summary>
+	///		Integer division rounding towards negative infinity.
+	///	</summary>
+	static int FloorDiv(int a, int b) {
+		int q = a / b;
+		if ((a % b != 0) && ((a < 0) != (b < 0))) {
+			q--;
+		}
+		return q;
+	}
+
+public:
+	///	<summary>
+	///		Normalize this time in accordance with the calendar.  Mirrors
+	///		Time::NormalizeTime() with the month lengths resolved at
+	///		compile time.
+	///	</summary>
+	void Normalize() {
+
+		// Add seconds
+		int nAddedSeconds = FloorDiv(m_iMicroSecond, 1000000);
+		m_iMicroSecond -= nAddedSeconds * 1000000;
+		m_iSecond += nAddedSeconds;
+
+		// Add days
+		int nAddedDays = FloorDiv(m_iSecond, 86400);
+		m_iSecond -= nAddedDays * 86400;
+		m_iDay += nAddedDays;
+
+		// Add years
+		int nAddedYears = FloorDiv(m_iMonth, 12);
+		m_iMonth -= nAddedYears * 12;
+		m_iYear += nAddedYears;
+
+		// Subtract months
+		while (m_iDay < 0) {
+			m_iMonth--;
+			if (m_iMonth < 0) {
+				m_iMonth = 11;
+				m_iYear--;
+			}
+			m_iDay += CalendarTraits::DaysInMonth(m_iYear, m_iMonth);
+		}
+
+		// Add months
+		while (m_iDay >= CalendarTraits::DaysInMonth(m_iYear, m_iMonth)) {
+			m_iDay -= CalendarTraits::DaysInMonth(m_iYear, m_iMonth);
+			m_iMonth++;
+			if (m_iMonth > 11) {
+				m_iMonth = 0;
+				m_iYear++;
+			}
+		}
+	}
+
+public:
+	///	<summary>
+	///		Add a number of seconds to this time.
+	///	</summary>
+	inline void AddSeconds(int nSeconds) {
+		m_iSecond += nSeconds;
+
+		Normalize();
+	}
+
+	///	<summary>
+	///		Add a number of seconds to this time.
+	///	</summary>
+	inline CalendarTime & operator+=(int nSeconds) {
+		AddSeconds(nSeconds);
+		return (*this);
+	}
+
+	///	<summary>
+	///		Add a number of days to this time.
+	///	</summary>
+	inline void AddDays(int nDays) {
+		m_iDay += nDays;
+
+		Normalize();
+	}
+
+	///	<summary>
+	///		Add a number of months to this time.
+	///	</summary>
+	inline void AddMonths(int nMonths) {
+		m_iMonth += nMonths;
+
+		Normalize();
+	}
+
+	///	<summary>
+	///		Add a number of years to this time.
+	///	</summary>
+	inline void AddYears(int nYears) {
+		m_iYear += nYears;
+
+		Normalize();
+	}
+
+public:
+	///	<summary>
+	///		Calculate the day number for this time.
+	///	</summary>
+	inline int DayNumber() const {
+		return CalendarTraits::DayNumber(m_iYear, m_iMonth, m_iDay);
+	}
+
+	///	<summary>
+	///		Determine the number of seconds from this time to the given
+	///		time.
+	///	</summary>
+	inline double DeltaSeconds(const CalendarTime & caltime) const {
+		return static_cast<double>(
+				caltime.DayNumber() - DayNumber()) * 86400.0
+			+ static_cast<double>(caltime.m_iSecond - m_iSecond)
+			+ static_cast<double>(
+				caltime.m_iMicroSecond - m_iMicroSecond) * 1.0e-6;
+	}
+
+	///	<summary>
+	///		Determine the number of seconds between two times.
+	///	</summary>
+	inline double operator-(const CalendarTime & caltime) const {
+		return -DeltaSeconds(caltime);
+	}
+
+public:
+	///	<summary>
+	///		Equality between times.
+	///	</summary>
+	inline bool operator==(const CalendarTime & caltime) const {
+		return ((m_iYear        == caltime.m_iYear) &&
+		        (m_iMonth       == caltime.m_iMonth) &&
+		        (m_iDay         == caltime.m_iDay) &&
+		        (m_iSecond      == caltime.m_iSecond) &&
+		        (m_iMicroSecond == caltime.m_iMicroSecond));
+	}
+
+	///	<summary>
+	///		Inequality between times.
+	///	</summary>
+	inline bool operator!=(const CalendarTime & caltime) const {
+		return !((*this) == caltime);
+	}
+
+	///	<summary>
+	///		Less-than between times.
+	///	</summary>
+	inline bool operator<(const CalendarTime & caltime) const {
+		if (m_iYear != caltime.m_iYear) {
+			return (m_iYear < caltime.m_iYear);
+		}
+		if (m_iMonth != caltime.m_iMonth) {
+			return (m_iMonth < caltime.m_iMonth);
+		}
+		if (m_iDay != caltime.m_iDay) {
+			return (m_iDay < caltime.m_iDay);
+		}
+		if (m_iSecond != caltime.m_iSecond) {
+			return (m_iSecond < caltime.m_iSecond);
+		}
+		return (m_iMicroSecond < caltime.m_iMicroSecond);
+	}
+
+	///	<summary>
+	///		Greater-than between times.
+	///	</summary>
+	inline bool operator>(const CalendarTime & caltime) const {
+		return (caltime < (*this));
+	}
+
+public:
+	///	<summary>
+	///		Get the (zero-indexed) year.
+	///	</summary>
+	inline int GetYear() const {
+		return m_iYear;
+	}
+
+	///	<summary>
+	///		Get the zero-indexed month.
+	///	</summary>
+	inline int GetMonth() const {
+		return m_iMonth;
+	}
+
+	///	<summary>
+	///		Get the zero-indexed day.
+	///	</summary>
+	inline int GetDay() const {
+		return m_iDay;
+	}
+
+	///	<summary>
+	///		Get the number of seconds.
+	///	</summary>
+	inline int GetSecond() const {
+		return m_iSecond;
+	}
+
+	///	<summary>
+	///		Get the number of microseconds.
+	///	</summary>
+	inline int GetMicroSecond() const {
+		return m_iMicroSecond;
+	}
+
+private:
+	///	<summary>
+	///		The year.
+	///	</summary>
+	int m_iYear;
+
+	///	<summary>
+	///		The month (zero-indexed).
+	///	</summary>
+	int m_iMonth;
+
+	///	<summary>
+	///		The day (zero-indexed).
+	///	</summary>
+	int m_iDay;
+
+	///	<summary>
+	///		The second count.
+	///	</summary>
+	int m_iSecond;
+
+	///	<summary>
+	///		The microsecond count.
+	///	</summary>
+	int m_iMicroSecond;
+};
+
+///	<summary>
+///		Compile-time calendar specializations of CalendarTime.
+///	</summary>
+typedef CalendarTime<CalendarNoLeapTraits> TimeNoLeap;
+typedef CalendarTime<CalendarGregorianTraits> TimeGregorian;
+typedef CalendarTime<Calendar360DayTraits> Time360Day;
+
+///////////////////////////////////////////////////////////////////////////////
+
 #endif
 
@@ -0,0 +1,153 @@
+///////////////////////////////////////////////////////////////////////////////
+///
+///	\file    ValidationResult.h
+///	\author  Paul Ullrich
+///	\version September 1, 2026
+///
+///	<remarks>
+///		Copyright (c) 2020 Paul Ullrich
+///
+///		Distributed under the BSD 3-Clause License.
+///		(See accompanying file LICENSE)
+///	</remarks>
+
+#ifndef _VALIDATIONRESULT_H_
+#define _VALIDATIONRESULT_H_
+
+///////////////////////////////////////////////////////////////////////////////
+
+#include <string>
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Status codes for validation paths where failure is an expected
+///		outcome.
+///	</summary>
+enum ValidationStatus {
+	ValidationStatus_OK = 0,
+	ValidationStatus_FileMissing,
+	ValidationStatus_FileUnreadable,
+	ValidationStatus_ParseError,
+	ValidationStatus_SchemaError
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		A lightweight result for validation paths where failure is an
+///		expected outcome, such as probing candidate module paths that may
+///		legitimately lack a settings file.  Unlike Exception, constructing
+///		a ValidationResult performs no message formatting:  the status
+///		code and raw context strings are stored as-is, and a message is
+///		only composed when a caller that actually reports the failure
+///		calls Format().
+///	</summary>
+class ValidationResult {
+
+public:
+	///	<summary>
+	///		Constructor.  Default construction indicates success.
+	///	</summary>
+	ValidationResult() :
+		m_eStatus(ValidationStatus_OK)
+	{ }
+
+	///	<summary>
+	///		Construct a failure result with unformatted context.
+	///	</summary>
+	static ValidationResult Error(
+		ValidationStatus eStatus,
+		const std::string & strContext,
+		const std::string & strDetail = std::string()
+	) {
+		ValidationResult result;
+		result.m_eStatus = eStatus;
+		result.m_strContext = strContext;
+		result.m_strDetail = strDetail;
+		return result;
+	}
+
+public:
+	///	<summary>
+	///		Check for success.
+	///	</summary>
+	bool IsOK() const {
+		return (m_eStatus == ValidationStatus_OK);
+	}
+
+	///	<summary>
+	///		The status code of this result.
+	///	</summary>
+	ValidationStatus GetStatus() const {
+		return m_eStatus;
+	}
+
+	///	<summary>
+	///		The primary context of the failure (typically a file path).
+	///	</summary>
+	const std::string & GetContext() const {
+		return m_strContext;
+	}
+
+	///	<summary>
+	///		Additional detail on the failure (for instance a parser
+	///		message or the schema rule violated).
+	///	</summary>
+	const std::string & GetDetail() const {
+		return m_strDetail;
+	}
+
+	///	<summary>
+	///		A short description of the status code.
+	///	</summary>
+	const char * StatusString() const {
+		switch (m_eStatus) {
+			case ValidationStatus_OK:             return "ok";
+			case ValidationStatus_FileMissing:    return "file not found";
+			case ValidationStatus_FileUnreadable: return "file unreadable";
+			case ValidationStatus_ParseError:     return "parse error";
+			case ValidationStatus_SchemaError:    return "schema violation";
+			default:                              return "unknown error";
+		}
+	}
+
+	///	<summary>
+	///		Compose the failure message.  This is the only place any
+	///		formatting occurs.
+	///	</summary>
+	std::string Format() const {
+		if (IsOK()) {
+			return std::string("ok");
+		}
+
+		std::string strMessage(StatusString());
+		if (m_strContext.length() != 0) {
+			strMessage += " \"" + m_strContext + "\"";
+		}
+		if (m_strDetail.length() != 0) {
+			strMessage += ": " + m_strDetail;
+		}
+		return strMessage;
+	}
+
+protected:
+	///	<summary>
+	///		The status code of this result.
+	///	</summary>
+	ValidationStatus m_eStatus;
+
+	///	<summary>
+	///		Primary context of the failure, captured unformatted.
+	///	</summary>
+	std::string m_strContext;
+
+	///	<summary>
+	///		Additional detail on the failure, captured unformatted.
+	///	</summary>
+	std::string m_strDetail;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+#endif // _VALIDATIONRESULT_H_
@@ -13,8 +13,23 @@
 
 #include <cstdio>
 #include <cstdlib>
+#include <cstdint>
 #include <unistd.h>
 #include <pwd.h>
+#include <dirent.h>
+#include <spawn.h>
+#include <fcntl.h>
+#include <cerrno>
+#include <csignal>
+#include <ctime>
+#include <poll.h>
+#include <sched.h>
+#include <sys/wait.h>
+#include <sys/resource.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+extern char ** environ;
 
 #include <map>
 #include <string>
@@ -23,12 +38,28 @@
 #include <iomanip>
 #include <fstream>
 #include <cctype>
+#include <cstring>
+#include <algorithm>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
 
 #include "contrib/json.hpp"
 #include "filesystem_path.h"
 
+#include "ArgumentParser.h"
+#include "CompressedFile.h"
 #include "Exception.h"
+#include "MemoryMappedFile.h"
+#include "Profiler.h"
+#include "RemoveDirectoryTree.h"
+#include "STLStringHelper.h"
 #include "Terminal.h"
+#include "ValidationResult.h"
 
 ///////////////////////////////////////////////////////////////////////////////
 
@@ -52,81 +83,197 @@ static const char * g_szCMECTOCName = "contents.json";
 ///	</summary>
 static const char * g_szCMECSettingsName = "settings.json";
 
-///////////////////////////////////////////////////////////////////////////////
+///	<summary>
+///		Name of the CMEC validation cache file.
+///	</summary>
+static const char * g_szCMECValidationCacheName = ".cmeclibrary.cache";
 
-typedef std::map<std::string, int> CommandLineFlagSpec;
+///	<summary>
+///		Name of the resolved run plan cache file.
+///	</summary>
+static const char * g_szCMECRunPlanCacheName = ".cmecrunplan.cache";
 
-typedef std::map<std::string, std::vector<std::string> > CommandLineFlagMap;
+///	<summary>
+///		Name of the Unix domain socket used in daemon mode.
+///	</summary>
+static const char * g_szCMECSocketName = ".cmec.sock";
 
-typedef std::vector<std::string> CommandLineArgVector;
+///	<summary>
+///		Name of the per-configuration run fingerprint file.
+///	</summary>
+static const char * g_szCMECFingerprintName = ".cmec_fingerprint.json";
 
-std::string ParseCommandLine(
-	int ibegin,
-	int iend,
-	char ** argv,
-	const CommandLineFlagSpec & spec,
-	CommandLineFlagMap & mapFlags,
-	CommandLineArgVector & vecArg
-) {
-	// Flags occur before raw arguments
-	bool fReadingFlags = true;
+///	<summary>
+///		Name of the run history file.
+///	</summary>
+static const char * g_szCMECRunHistoryName = ".cmecrunhistory";
 
-	// Loop through all command line arguments
-	for (int c = ibegin; c < iend; c++) {
-		_ASSERT(strlen(argv[c]) >= 1);
+///	<summary>
+///		Name of the profiling report file.
+///	</summary>
+static const char * g_szCMECProfileName = "cmec_profile.json";
 
-		// Handle flags
-		if (argv[c][0] == '-') {
-			if (!fReadingFlags) {
-				return std::string("Error: Malformed argument \"") + std::string(argv[c]) + std::string("\"");
-			}
-			if (strlen(argv[c]) == 1) {
-				continue;
-			}
-			std::string strFlag = argv[c] + 1;
+///	<summary>
+///		Name of the indexed data manifest handed to modules.
+///	</summary>
+static const char * g_szCMECDataManifestName = "cmec_data_manifest.cbor";
 
-			CommandLineFlagSpec::const_iterator iterSpec = spec.find(strFlag);
-			if (iterSpec == spec.end()) {
-				return std::string("Error: Invalid flag \"") + strFlag + std::string("\"");
-			}
+///	<summary>
+///		Name of the per-configuration module output file.
+///	</summary>
+static const char * g_szCMECOutputName = "output.json";
 
-			CommandLineFlagMap::iterator iterFlags = mapFlags.find(strFlag);
-			if (iterFlags != mapFlags.end()) {
-				return std::string("Error: Duplicated flag \"") + strFlag + std::string("\"");
-			}
+///	<summary>
+///		Name of the aggregated metrics index file.
+///	</summary>
+static const char * g_szCMECIndexName = "cmec_index.json";
 
-			int nargs = iterSpec->second;
-			if (c + nargs >= iend) {
-				return std::string("Error: Insufficient arguments for \"")
-					+ strFlag + std::string("\"");
-			}
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		A single entry of a JSON schema table:  a "::"-delimited key path
+///		and the JSON type expected at that path.
+///	</summary>
+struct JSONSchemaEntry {
+	///	<summary>
+	///		"::"-delimited key path from the document root.
+	///	</summary>
+	const char * szKeyPath;
+
+	///	<summary>
+	///		Expected JSON type at this key path.
+	///	</summary>
+	nlohmann::json::value_t jtype;
+};
+
+///	<summary>
+///		A table-driven JSON schema validator.  The schema table is compiled
+///		into split key paths once at construction; Validate() then applies
+///		all entries in a single traversal, resolving each parent object
+///		only once across consecutive entries that share a prefix.
+///	</summary>
+class JSONSchemaValidator {
+
+protected:
+	///	<summary>
+	///		A schema entry with its key path pre-split into components.
+	///	</summary>
+	struct CompiledEntry {
+		std::string strKeyPath;
+		std::vector<std::string> vecKeys;
+		nlohmann::json::value_t jtype;
+	};
+
+public:
+	///	<summary>
+	///		Constructor.  Compile the given schema table.
+	///	</summary>
+	JSONSchemaValidator(
+		const JSONSchemaEntry * pSchema,
+		size_t nEntries
+	) {
+		m_vecEntries.resize(nEntries);
+		for (size_t s = 0; s < nEntries; s++) {
+			CompiledEntry & entry = m_vecEntries[s];
+			entry.strKeyPath = pSchema[s].szKeyPath;
+			entry.jtype = pSchema[s].jtype;
 
-			std::vector<std::string> vecFlagArg;
-			for (int d = 0; d < nargs; d++) {
-				_ASSERT(strlen(argv[c+d]) >= 1);
-				if (argv[c+d+1][0] == '-') {
-					return std::string("Error: Invalid arguments for \"")
-						+ strFlag + std::string("\"");
+			size_t iBegin = 0;
+			for (;;) {
+				size_t iEnd = entry.strKeyPath.find("::", iBegin);
+				if (iEnd == std::string::npos) {
+					entry.vecKeys.push_back(
+						entry.strKeyPath.substr(iBegin));
+					break;
 				}
-				vecFlagArg.push_back(argv[c+d+1]);
+				entry.vecKeys.push_back(
+					entry.strKeyPath.substr(iBegin, iEnd - iBegin));
+				iBegin = iEnd + 2;
 			}
+		}
+	}
 
-			mapFlags.insert(CommandLineFlagMap::value_type(strFlag, vecFlagArg));
-
-			c += nargs;
+	///	<summary>
+	///		Validate the given JSON document against the schema table.
+	///		On failure strError is set to a description of the first
+	///		violation and false is returned.
+	///	</summary>
+	bool Validate(
+		const nlohmann::json & jdoc,
+		std::string & strError
+	) const {
+		// Resolved ancestor nodes, shared across consecutive entries
+		// with a common key path prefix
+		std::vector<std::pair<std::string, const nlohmann::json *> > vecResolved;
+
+		for (size_t s = 0; s < m_vecEntries.size(); s++) {
+			const CompiledEntry & entry = m_vecEntries[s];
+
+			// Reuse the longest already-resolved prefix
+			size_t nShared = 0;
+			while ((nShared < vecResolved.size()) &&
+			       (nShared + 1 < entry.vecKeys.size()) &&
+			       (vecResolved[nShared].first == entry.vecKeys[nShared])
+			) {
+				nShared++;
+			}
+			vecResolved.resize(nShared);
+
+			const nlohmann::json * pNode =
+				(nShared == 0)?(&jdoc):(vecResolved[nShared-1].second);
+
+			// Resolve the remaining components
+			bool fMissing = false;
+			for (size_t c = nShared; c < entry.vecKeys.size(); c++) {
+				auto it = pNode->find(entry.vecKeys[c]);
+				if (it == pNode->end()) {
+					strError = "missing key \"" + entry.strKeyPath + "\"";
+					fMissing = true;
+					break;
+				}
+				pNode = &(*it);
+				vecResolved.push_back(
+					std::pair<std::string, const nlohmann::json *>(
+						entry.vecKeys[c], pNode));
+			}
+			if (fMissing) {
+				return false;
+			}
 
-		// Handle raw arguments
-		} else {
-			if (fReadingFlags) {
-				fReadingFlags = false;
+			// Check the type of the resolved node
+			if (pNode->type() != entry.jtype) {
+				strError = "\"" + entry.strKeyPath + "\" is not of type "
+					+ TypeName(entry.jtype);
+				return false;
 			}
+		}
+
+		return true;
+	}
 
-			vecArg.push_back(argv[c]);
+protected:
+	///	<summary>
+	///		Human-readable name of the given JSON type, as used in
+	///		validation error messages.
+	///	</summary>
+	static const char * TypeName(
+		nlohmann::json::value_t jtype
+	) {
+		switch (jtype) {
+			case nlohmann::json::value_t::object:  return "object";
+			case nlohmann::json::value_t::array:   return "array";
+			case nlohmann::json::value_t::string:  return "string";
+			case nlohmann::json::value_t::boolean: return "boolean";
+			default: return "the expected type";
 		}
 	}
 
-	return std::string("");
-}
+protected:
+	///	<summary>
+	///		The compiled schema table.
+	///	</summary>
+	std::vector<CompiledEntry> m_vecEntries;
+};
 
 ///////////////////////////////////////////////////////////////////////////////
 
@@ -150,8 +297,9 @@ public:
 	///	<summary>
 	///		Constructor.
 	///	</summary>
-	CMECLibrary() {
-	}
+	CMECLibrary() :
+		m_fDirty(false)
+	{ }
 
 	///	<summary>
 	///		Clear the library.
@@ -160,6 +308,7 @@ public:
 		m_path = filesystem::path();
 		m_mapModulePaths.clear();
 		m_jlib.clear();
+		m_fDirty = false;
 	}
 
 	///	<summary>
@@ -193,11 +342,14 @@ public:
 		m_path = pathNamelist/filesystem::path(g_szCMECLibraryName);
 	}
 
+protected:
 	///	<summary>
-	///		Load the library from a file, or intiialize an empty library
-	///		if the library file doesn't exist.
+	///		Load the library file into the JSON representation, creating an
+	///		empty library if the library file doesn't exist, and validate
+	///		its top-level structure.  Individual module entries are not
+	///		validated here.
 	///	</summary>
-	void Read() {
+	void ReadLibraryFile() {
 
 		// Clear the library
 		Clear();
@@ -205,116 +357,193 @@ public:
 		// Initialize the path
 		InitializePath();
 
-		// Load the library
-		std::ifstream iflib(m_path.str());
-		if (!iflib.is_open()) {
-
-			// Create the CMEC library
-			printf("CMEC library not found; creating new library\n");
+		// If the library does not exist, create it
+		if (!m_path.exists()) {
 
-			// If the library does not exist, create it
-			std::ofstream oflib(m_path.str());
-			if (!oflib.is_open()) {
-				_EXCEPTION1("Unable to open \"%s\" for writing",
-					m_path.str().c_str());
-			}
-			nlohmann::json jlib;
-			jlib["version"] = g_szVersion;
-			jlib["cmec-driver"] = nlohmann::json::value_t::object;
-			jlib["modules"] = nlohmann::json::value_t::object;
-			oflib << jlib;
+			// Create the CMEC library.  This notice goes to stderr so
+			// machine-readable modes keep stdout to their document.
+			fprintf(stderr, "CMEC library not found; creating new library\n");
 
-			oflib.close();
+			m_jlib["version"] = g_szVersion;
+			m_jlib["cmec-driver"] = nlohmann::json::value_t::object;
+			m_jlib["modules"] = nlohmann::json::value_t::object;
 
-			iflib.open(m_path.str());
-			if (!iflib.is_open()) {
-				_EXCEPTION1("Unable to reopen \"%s\" for reading after creation",
-					m_path.str().c_str());
-			}
+			m_fDirty = true;
+			Write();
 		}
 
+		// Whether the library was read from the legacy JSON format
+		bool fLegacyJSONFormat = false;
 
-		// Parse the library
+		// Parse the library from a read-only memory mapping.  The library
+		// is stored in CBOR; libraries written by older versions of the
+		// driver are JSON text and are detected by their leading '{'.
 		{
+			MemoryMappedFile mmaplib(m_path.str());
 			try {
-				m_jlib = nlohmann::json::parse(iflib);
+				if ((mmaplib.size() != 0) && (*(mmaplib.begin()) == '{')) {
+					fLegacyJSONFormat = true;
+					m_jlib = nlohmann::json::parse(mmaplib.begin(), mmaplib.end());
+				} else {
+					m_jlib = nlohmann::json::from_cbor(mmaplib.begin(), mmaplib.end());
+				}
 			} catch (nlohmann::json::parse_error& e) {
 				_EXCEPTION3("Malformed CMEC library file "
 					"%s (%i) at byte position %i",
 					e.what(), e.id, e.byte);
 			}
 
-			auto itd = m_jlib.find("cmec-driver");
-			if (itd == m_jlib.end()) {
-				_EXCEPTIONT("Malformed CMEC library file missing key \"cmec-driver\"");
-			}
-			if (!itd->is_object()) {
-				_EXCEPTIONT("Malformed CMEC library file: \"cmec-driver\" is not of type object");
-			}
-
-			auto itv = m_jlib.find("version");
-			if (itv == m_jlib.end()) {
-				_EXCEPTIONT("Malformed CMEC library file missing key \"version\"");
-			}
-			if (!itv->is_string()) {
-				_EXCEPTIONT("Malformed CMEC library file: \"version\" is not of type string");
-			}
-
-			auto itm = m_jlib.find("modules");
-			if (itm == m_jlib.end()) {
-				_EXCEPTIONT("Malformed CMEC library file missing key \"modules\"");
-			}
-			if (!itm->is_object()) {
-				_EXCEPTIONT("Malformed CMEC library file: \"modules\" is not of type object");
+			static const JSONSchemaEntry s_schema[] = {
+				{"cmec-driver", nlohmann::json::value_t::object},
+				{"version", nlohmann::json::value_t::string},
+				{"modules", nlohmann::json::value_t::object}
+			};
+			static const JSONSchemaValidator s_validator(
+				s_schema, sizeof(s_schema) / sizeof(s_schema[0]));
+
+			std::string strSchemaError;
+			if (!s_validator.Validate(m_jlib, strSchemaError)) {
+				_EXCEPTION1("Malformed CMEC library file: %s",
+					strSchemaError.c_str());
 			}
 
-			std::string strLibVersion = *itv;
+			std::string strLibVersion = m_jlib["version"];
 			std::string strDriverVersion = g_szVersion;
 			if (strDriverVersion < strLibVersion) {
 				_EXCEPTION2("CMEC library file version \"%s\" is greater than driver version \"%s\"",
 					strLibVersion.c_str(), g_szVersion);
 			}
+		}
 
-			// Load modules
-			nlohmann::json jmodules = *itm;
-			for (auto itmod = jmodules.begin(); itmod != jmodules.end(); itmod++) {
-				if (!itmod->is_string()) {
-					_EXCEPTIONT("Malformed CMEC library file: an entry of the \"modules\" array is not of type string");
-				}
+		// Migrate legacy JSON libraries to the binary format
+		if (fLegacyJSONFormat) {
+			printf("Migrating CMEC library to binary format\n");
+			m_fDirty = true;
+			Write();
+		}
+	}
+
+public:
+	///	<summary>
+	///		Load the library from a file, or intiialize an empty library
+	///		if the library file doesn't exist.
+	///	</summary>
+	void Read() {
 
-				std::string strModuleName(itmod.key());
-				filesystem::path path(itmod.value());
+		// Load and validate the library file
+		ReadLibraryFile();
 
-				// Verify module doesn't exist already in map
-				if (m_mapModulePaths.find(strModuleName) != m_mapModulePaths.end()) {
-					_EXCEPTION1("Malformed CMEC library file: Repeated module name \"%s\"",
-						strModuleName.c_str());
-				}
+		// Load modules
+		const nlohmann::json & jmodules = m_jlib["modules"];
+		for (auto itmod = jmodules.begin(); itmod != jmodules.end(); itmod++) {
+			if (!itmod->is_string()) {
+				_EXCEPTIONT("Malformed CMEC library file: an entry of the \"modules\" array is not of type string");
+			}
 
-				m_mapModulePaths.insert(
-					std::pair<std::string, filesystem::path>(
-						strModuleName, path));
+			std::string strModuleName(itmod.key());
+			filesystem::path path(itmod.value());
+
+			// Verify module doesn't exist already in map
+			if (m_mapModulePaths.find(strModuleName) != m_mapModulePaths.end()) {
+				_EXCEPTION1("Malformed CMEC library file: Repeated module name \"%s\"",
+					strModuleName.c_str());
 			}
+
+			m_mapModulePaths.insert(
+				std::pair<std::string, filesystem::path>(
+					strModuleName, path));
+		}
+	}
+
+	///	<summary>
+	///		Load the library from a file without validating module entries
+	///		or building the full module map.  Individual modules are then
+	///		resolved on demand via FindModulePath().
+	///	</summary>
+	void ReadLazy() {
+		ReadLibraryFile();
+	}
+
+	///	<summary>
+	///		Resolve the path of a single module by name, validating only
+	///		that module's library entry.  Returns false if the module is
+	///		not present in the library.
+	///	</summary>
+	bool FindModulePath(
+		const std::string & strModuleName,
+		filesystem::path & pathModule
+	) const {
+		// If the full module map has been built, use it directly
+		ModuleNamePathMap::const_iterator it = m_mapModulePaths.find(strModuleName);
+		if (it != m_mapModulePaths.end()) {
+			pathModule = it->second;
+			return true;
+		}
+
+		const nlohmann::json & jmodules = m_jlib["modules"];
+		auto itmod = jmodules.find(strModuleName);
+		if (itmod == jmodules.end()) {
+			return false;
 		}
+		if (!itmod->is_string()) {
+			_EXCEPTION1("Malformed CMEC library file: entry \"%s\" of the \"modules\" array is not of type string",
+				strModuleName.c_str());
+		}
+
+		pathModule = filesystem::path(itmod.value());
+		return true;
 	}
 
 	///	<summary>
-	///		Write the library to a file.
+	///		Write the library to a file, in CBOR binary format, if it has
+	///		been modified.  The library is first written to a temporary file
+	///		and then renamed into place, so an interrupted write can never
+	///		leave a truncated library behind and concurrent invocations
+	///		always observe a complete file.
 	///	</summary>
 	void Write() {
 
+		// Unmodified libraries are never rewritten
+		if (!m_fDirty) {
+			return;
+		}
+
 		// Initialize the path
 		InitializePath();
 
-		// Open output stream
-		std::ofstream oflib(m_path.str());
-		if (!oflib.is_open()) {
-			_EXCEPTION1("Unable to open \"%s\" for writing",
-				m_path.str().c_str());
+		// Write to a process-unique temporary file alongside the library
+		std::string strTempPath =
+			m_path.str() + ".tmp." + std::to_string(getpid());
+
+		{
+			std::ofstream oflib(strTempPath, std::ios::out | std::ios::binary);
+			if (!oflib.is_open()) {
+				_EXCEPTION1("Unable to open \"%s\" for writing",
+					strTempPath.c_str());
+			}
+
+			// Output the CBOR encoding of the library to the file
+			std::vector<std::uint8_t> vecCBOR = nlohmann::json::to_cbor(m_jlib);
+			oflib.write(
+				reinterpret_cast<const char *>(&(vecCBOR[0])),
+				vecCBOR.size());
+
+			if (!oflib.good()) {
+				oflib.close();
+				unlink(strTempPath.c_str());
+				_EXCEPTION1("Error writing to \"%s\"",
+					strTempPath.c_str());
+			}
 		}
 
-		// Output the JSON structure to the file
-		oflib << m_jlib;
+		// Atomically replace the library with the temporary file
+		if (rename(strTempPath.c_str(), m_path.str().c_str()) != 0) {
+			unlink(strTempPath.c_str());
+			_EXCEPTION2("Unable to rename \"%s\" to \"%s\"",
+				strTempPath.c_str(), m_path.str().c_str());
+		}
+
+		m_fDirty = false;
 	}
 
 	///	<summary>
@@ -340,6 +569,8 @@ public:
 
 		m_jlib["modules"][strModuleName] = path.str();
 
+		m_fDirty = true;
+
 		return true;
 	}
 
@@ -366,6 +597,8 @@ public:
 		m_mapModulePaths.erase(it);
 		jmodules.erase(itmod);
 
+		m_fDirty = true;
+
 		return true;
 	}
 
@@ -400,6 +633,13 @@ public:
 		return m_mapModulePaths.find(strModule);
 	}
 
+	///	<summary>
+	///		Path to the library file on disk.
+	///	</summary>
+	const filesystem::path & GetLibraryFilePath() const {
+		return m_path;
+	}
+
 protected:
 	///	<summary>
 	///		Path to the CMEC library.
@@ -415,473 +655,5054 @@ protected:
 	///		JSON file representation of the CMEC library.
 	///	</summary>
 	nlohmann::json m_jlib;
+
+	///	<summary>
+	///		Flag indicating the library has been modified since it was
+	///		last read or written.
+	///	</summary>
+	bool m_fDirty;
 };
 
 ///////////////////////////////////////////////////////////////////////////////
 
 ///	<summary>
-///		A class representing the settings.json file.
+///		A persistent cache of validated module metadata, keyed on file
+///		path, modification time and size.  Unchanged settings.json and
+///		contents.json files are never reparsed; the cache entry is
+///		invalidated automatically when the underlying file changes.
 ///	</summary>
-class CMECModuleSettings {
+class CMECValidationCache {
 
 public:
 	///	<summary>
-	///		Check for the existence of a contents file.
+	///		Constructor.
 	///	</summary>
-	static bool ExistsInModulePath(
-		const filesystem::path & pathModule
-	) {
-		filesystem::path pathSettings = pathModule / filesystem::path(g_szCMECSettingsName);
-		return pathSettings.exists();
-	}
+	CMECValidationCache() :
+		m_fLoaded(false),
+		m_fDirty(false)
+	{ }
 
-public:
 	///	<summary>
-	///		Clear the CMEC module contents.
+	///		Destructor.  Flushes any new cache entries to disk.
 	///	</summary>
-	void Clear() {
-		m_path = filesystem::path();
-		m_jsettings.clear();
+	~CMECValidationCache() {
+		try {
+			Write();
+		} catch(...) {
+		}
 	}
 
 	///	<summary>
-	///		Read the CMEC module contents file.
+	///		Initialize the validation cache path.
 	///	</summary>
-	bool ReadFromFile(
-		const filesystem::path & pathSettings
-	) {
-		// Clear the module contents
-		Clear();
+	void InitializePath() {
+		char * homedir = getenv("HOME");
 
-		// Store the settings.json file path
-		m_path = pathSettings;
+		if (homedir != NULL) {
+			filesystem::path pathNamelist(homedir);
+			if (!pathNamelist.exists()) {
+				_EXCEPTIONT("Environment variable $HOME points to an invalid home directory path\n");
+			}
+			m_path = pathNamelist/filesystem::path(g_szCMECValidationCacheName);
+			return;
+		}
 
-		// Get the path
-		filesystem::path pathCMECjson = pathSettings;
-		std::ifstream ifCMECjson(pathCMECjson.str());
-		if (!ifCMECjson.is_open()) {
-			_EXCEPTION1("Unable to open \"%s\"", pathSettings.str().c_str());
+		uid_t uid = getuid();
+		struct passwd *pw = getpwuid(uid);
+
+		if (pw == NULL) {
+			_EXCEPTIONT("Unable to identify path for .cmeclibrary.cache");
 		}
 
-		// Parse the CMEC settings json
-		try {
-			m_jsettings = nlohmann::json::parse(ifCMECjson);
-		} catch (nlohmann::json::parse_error& e) {
-			_EXCEPTION3("Malformed CMEC settings file "
-				"%s (%i) at byte position %i",
-				e.what(), e.id, e.byte);
+		filesystem::path pathNamelist(pw->pw_dir);
+		if (!pathNamelist.exists()) {
+			_EXCEPTIONT("pwd points to an invalid home directory path");
 		}
+		m_path = pathNamelist/filesystem::path(g_szCMECValidationCacheName);
+	}
 
-		// Validate the CMEC settings json
+	///	<summary>
+	///		Load the cache from disk, if it has not been loaded already.
+	///		A missing or corrupt cache file simply yields an empty cache.
+	///	</summary>
+	void Read() {
+		std::lock_guard<std::recursive_mutex> lock(m_mutex);
 
-		// settings key
-		auto its = m_jsettings.find("settings");
-		if (its == m_jsettings.end()) {
-			printf("ERROR: Malformed CMEC settings file \"%s\": missing key \"settings\"\n",
-				pathSettings.str().c_str());
-			return false;
-		}
-		if (!its->is_object()) {
-			printf("ERROR: Malformed CMEC settings file \"%s\": \"settings\" is not of type object\n",
-				pathSettings.str().c_str());
-			return false;
+		if (m_fLoaded) {
+			return;
 		}
+		m_fLoaded = true;
 
-		auto itsn = its->find("name");
-		if (itsn == its->end()) {
-			printf("ERROR: Malformed CMEC settings file \"%s\": missing key \"settings::name\"\n",
-				pathSettings.str().c_str());
-			return false;
+		InitializePath();
+
+		if (m_path.exists()) {
+			MemoryMappedFile mmapcache(m_path.str());
+			try {
+				m_jcache = nlohmann::json::from_cbor(mmapcache.begin(), mmapcache.end());
+			} catch (nlohmann::json::parse_error& e) {
+				m_jcache.clear();
+			}
 		}
-		if (!itsn->is_string()) {
-			printf("ERROR: Malformed CMEC settings file \"%s\": \"settings::name\" is not of type string\n",
-				pathSettings.str().c_str());
-			return false;
+
+		if ((!m_jcache.is_object()) ||
+		    (m_jcache.find("settings") == m_jcache.end()) ||
+		    (m_jcache.find("contents") == m_jcache.end())
+		) {
+			m_jcache.clear();
+			m_jcache["settings"] = nlohmann::json::value_t::object;
+			m_jcache["contents"] = nlohmann::json::value_t::object;
 		}
+	}
 
-		auto itsln = its->find("long_name");
-		if (itsln == its->end()) {
-			printf("ERROR: Malformed CMEC settings file \"%s\": missing key \"settings::long_name\"\n",
-				pathSettings.str().c_str());
-			return false;
+	///	<summary>
+	///		Write the cache to disk, if it has been modified.
+	///	</summary>
+	void Write() {
+		std::lock_guard<std::recursive_mutex> lock(m_mutex);
+
+		if (!m_fDirty) {
+			return;
 		}
-		if (!itsln->is_string()) {
-			printf("ERROR: Malformed CMEC settings file \"%s\": \"settings::long_name\" is not of type string\n",
-				pathSettings.str().c_str());
-			return false;
+
+		InitializePath();
+
+		std::ofstream ofcache(m_path.str(), std::ios::out | std::ios::binary);
+		if (!ofcache.is_open()) {
+			_EXCEPTION1("Unable to open \"%s\" for writing",
+				m_path.str().c_str());
 		}
 
-		auto itsd = its->find("driver");
-		if (itsd == its->end()) {
-			printf("ERROR: Malformed CMEC settings file \"%s\": missing key \"settings::driver\"\n",
-				pathSettings.str().c_str());
+		std::vector<std::uint8_t> vecCBOR = nlohmann::json::to_cbor(m_jcache);
+		ofcache.write(
+			reinterpret_cast<const char *>(&(vecCBOR[0])),
+			vecCBOR.size());
+
+		m_fDirty = false;
+	}
+
+public:
+	///	<summary>
+	///		Obtain the modification time and size of the given file.
+	///	</summary>
+	static bool GetFileStamp(
+		const filesystem::path & path,
+		intmax_t & iMTime,
+		intmax_t & iSize
+	) {
+		struct stat sb;
+		if (stat(path.str().c_str(), &sb) != 0) {
 			return false;
 		}
-		if (!itsd->is_string()) {
-			printf("ERROR: Malformed CMEC settings file \"%s\": \"settings::driver\" is not of type string\n",
-				pathSettings.str().c_str());
+		iMTime = static_cast<intmax_t>(sb.st_mtime);
+		iSize = static_cast<intmax_t>(sb.st_size);
+		return true;
+	}
+
+	///	<summary>
+	///		Look up cached metadata for a settings.json file.  Returns
+	///		false if the file is absent from the cache or has changed.
+	///	</summary>
+	bool LookupSettings(
+		const filesystem::path & pathSettings,
+		std::string & strName,
+		std::string & strLongName,
+		std::string & strDriver,
+		std::vector<std::string> & vecDependencies
+	) {
+		std::lock_guard<std::recursive_mutex> lock(m_mutex);
+
+		Read();
+
+		intmax_t iMTime;
+		intmax_t iSize;
+		if (!GetFileStamp(pathSettings, iMTime, iSize)) {
 			return false;
 		}
 
-		// varlist key
-		auto itv = m_jsettings.find("varlist");
-		if (itv == m_jsettings.end()) {
-			printf("ERROR: Malformed CMEC settings file \"%s\": missing key \"varlist\"\n",
-				pathSettings.str().c_str());
+		nlohmann::json & jsettings = m_jcache["settings"];
+		auto it = jsettings.find(pathSettings.str());
+		if (it == jsettings.end()) {
 			return false;
 		}
-		if (!itv->is_object()) {
-			printf("ERROR: Malformed CMEC settings file \"%s\": \"varlist\" is not of type object\n",
-				pathSettings.str().c_str());
+		if (((*it)["mtime"] != iMTime) || ((*it)["size"] != iSize)) {
 			return false;
 		}
 
-		// obslist key
-		auto ito = m_jsettings.find("obslist");
-		if (ito == m_jsettings.end()) {
-			printf("ERROR: Malformed CMEC settings file \"%s\": missing key \"obslist\"\n",
-				pathSettings.str().c_str());
-			return false;
-		}
-		if (!ito->is_object()) {
-			printf("ERROR: Malformed CMEC settings file \"%s\": \"obslist\" is not of type object\n",
-				pathSettings.str().c_str());
+		// Entries recorded before dependency metadata existed are treated
+		// as misses so the file is revalidated once
+		auto itdeps = it->find("dependencies");
+		if (itdeps == it->end()) {
 			return false;
 		}
 
+		strName = (*it)["name"];
+		strLongName = (*it)["long_name"];
+		strDriver = (*it)["driver"];
+		vecDependencies.clear();
+		for (auto itdep = itdeps->begin(); itdep != itdeps->end(); itdep++) {
+			vecDependencies.push_back(itdep->get<std::string>());
+		}
 		return true;
 	}
 
-public:
-	///	<summary>
-	///		Name of the module.
 	///	<summary>
-	std::string GetName() const {
-		return m_jsettings["settings"]["name"];
-	}
-
+	///		Record validated metadata for a settings.json file.
+	///	</summary>
+	void InsertSettings(
+		const filesystem::path & pathSettings,
+		const std::string & strName,
+		const std::string & strLongName,
+		const std::string & strDriver,
+		const std::vector<std::string> & vecDependencies
+	) {
+		std::lock_guard<std::recursive_mutex> lock(m_mutex);
+
+		Read();
+
+		intmax_t iMTime;
+		intmax_t iSize;
+		if (!GetFileStamp(pathSettings, iMTime, iSize)) {
+			return;
+		}
+
+		nlohmann::json & jentry = m_jcache["settings"][pathSettings.str()];
+		jentry["mtime"] = iMTime;
+		jentry["size"] = iSize;
+		jentry["name"] = strName;
+		jentry["long_name"] = strLongName;
+		jentry["driver"] = strDriver;
+		jentry["dependencies"] = vecDependencies;
+
+		m_fDirty = true;
+	}
+
 	///	<summary>
-	///		Long name of the module.
+	///		Look up cached metadata for a contents.json file.  Returns
+	///		false if the file is absent from the cache or has changed.
 	///	</summary>
-	std::string GetLongName() const {
-		return m_jsettings["settings"]["long_name"];
+	bool LookupTOC(
+		const filesystem::path & pathContents,
+		std::string & strName,
+		std::string & strLongName,
+		std::map<std::string, std::string> & mapConfigs
+	) {
+		std::lock_guard<std::recursive_mutex> lock(m_mutex);
+
+		Read();
+
+		intmax_t iMTime;
+		intmax_t iSize;
+		if (!GetFileStamp(pathContents, iMTime, iSize)) {
+			return false;
+		}
+
+		nlohmann::json & jcontents = m_jcache["contents"];
+		auto it = jcontents.find(pathContents.str());
+		if (it == jcontents.end()) {
+			return false;
+		}
+		if (((*it)["mtime"] != iMTime) || ((*it)["size"] != iSize)) {
+			return false;
+		}
+
+		strName = (*it)["name"];
+		strLongName = (*it)["long_name"];
+
+		mapConfigs.clear();
+		nlohmann::json & jconfigs = (*it)["configs"];
+		for (auto itconfig = jconfigs.begin(); itconfig != jconfigs.end(); itconfig++) {
+			mapConfigs.insert(
+				std::pair<std::string, std::string>(
+					itconfig.key(), itconfig.value()));
+		}
+		return true;
 	}
 
 	///	<summary>
-	///		Driver script.
+	///		Record validated metadata for a contents.json file.
 	///	</summary>
-	std::string GetDriverScript() const {
-		return m_jsettings["settings"]["driver"];
+	void InsertTOC(
+		const filesystem::path & pathContents,
+		const std::string & strName,
+		const std::string & strLongName,
+		const std::map<std::string, filesystem::path> & mapConfigs
+	) {
+		std::lock_guard<std::recursive_mutex> lock(m_mutex);
+
+		Read();
+
+		intmax_t iMTime;
+		intmax_t iSize;
+		if (!GetFileStamp(pathContents, iMTime, iSize)) {
+			return;
+		}
+
+		nlohmann::json & jentry = m_jcache["contents"][pathContents.str()];
+		jentry["mtime"] = iMTime;
+		jentry["size"] = iSize;
+		jentry["name"] = strName;
+		jentry["long_name"] = strLongName;
+		jentry["configs"] = nlohmann::json::value_t::object;
+		for (auto itconfig = mapConfigs.begin(); itconfig != mapConfigs.end(); itconfig++) {
+			jentry["configs"][itconfig->first] = itconfig->second.str();
+		}
+
+		m_fDirty = true;
 	}
 
 protected:
 	///	<summary>
-	///		Path to the CMEC module.
+	///		Path to the validation cache.
 	///	</summary>
 	filesystem::path m_path;
 
 	///	<summary>
-	///		JSON file representation of the CMEC TOC file.
+	///		Set when the cache has been loaded from disk.
 	///	</summary>
-	nlohmann::json m_jsettings;
-};
-
-///////////////////////////////////////////////////////////////////////////////
-
-///	<summary>
-///		A class representing the contents of a specific CMEC module.
-///	</summary>
-class CMECModuleTOC {
+	bool m_fLoaded;
 
-public:
 	///	<summary>
-	///		A map from module configurations to paths.
+	///		Set when the cache contains entries not yet written to disk.
 	///	</summary>
-	typedef std::map<std::string, filesystem::path> ModuleConfigMap;
+	bool m_fDirty;
 
 	///	<summary>
-	///		A const_iterator into the map.
+	///		JSON representation of the cache.
 	///	</summary>
-	typedef ModuleConfigMap::const_iterator const_iterator;
+	nlohmann::json m_jcache;
 
-public:
 	///	<summary>
-	///		Check for the existence of a contents file.
+	///		Mutex protecting concurrent access to the cache.
 	///	</summary>
-	static bool ExistsInModulePath(
-		const filesystem::path & pathModule
-	) {
-		filesystem::path pathContents = pathModule / filesystem::path(g_szCMECTOCName);
-		return pathContents.exists();
-	}
+	std::recursive_mutex m_mutex;
+};
+
+///	<summary>
+///		Global validation cache instance.
+///	</summary>
+static CMECValidationCache g_ValidationCache;
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		A persistent cache of resolved run plans, keyed on the module
+///		arguments of a run.  A plan records the resolved module, driver
+///		script, working directory and settings paths for each
+///		configuration, along with stamps of every file consulted during
+///		resolution (the library file plus each module's settings.json and
+///		contents.json).  When a later run presents the same module
+///		arguments and all recorded stamps still match, the plan is loaded
+///		directly and the whole resolution pipeline is skipped.  The cache
+///		is advisory:  a missing or corrupt cache file simply yields an
+///		empty cache.  The cache is only accessed from the main thread.
+///	</summary>
+class CMECRunPlanCache {
 
 public:
 	///	<summary>
-	///		Clear the CMEC module contents.
+	///		Constructor.
 	///	</summary>
-	void Clear() {
-		m_path = filesystem::path();
-		m_mapConfigs.clear();
-		m_jcmec.clear();
-	}
+	CMECRunPlanCache() :
+		m_fLoaded(false),
+		m_fDirty(false)
+	{ }
 
 	///	<summary>
-	///		Read the CMEC module contents file.
+	///		Initialize the run plan cache path.
 	///	</summary>
-	bool ReadFromModulePath(
-		const filesystem::path & pathModule
-	) {
-		// Clear the module contents
-		Clear();
+	void InitializePath() {
+		char * homedir = getenv("HOME");
 
-		// Get the path
-		m_path = pathModule / filesystem::path(g_szCMECTOCName);
-		std::ifstream ifCMECjson(m_path.str());
-		if (!ifCMECjson.is_open()) {
-			_EXCEPTION1("Unable to open \"%s\"", m_path.str().c_str());
+		if (homedir != NULL) {
+			filesystem::path pathNamelist(homedir);
+			if (!pathNamelist.exists()) {
+				_EXCEPTIONT("Environment variable $HOME points to an invalid home directory path\n");
+			}
+			m_path = pathNamelist/filesystem::path(g_szCMECRunPlanCacheName);
+			return;
 		}
 
-		// Parse the CMEC json
-		try {
-			m_jcmec = nlohmann::json::parse(ifCMECjson);
-		} catch (nlohmann::json::parse_error& e) {
-			_EXCEPTION3("Malformed CMEC config file "
-				"%s (%i) at byte position %i",
-				e.what(), e.id, e.byte);
-		}
+		uid_t uid = getuid();
+		struct passwd *pw = getpwuid(uid);
 
-		// Validate the file
-		auto itm = m_jcmec.find("module");
-		if (itm == m_jcmec.end()) {
-			printf("ERROR: Malformed CMEC contents file \"%s\": missing key \"module\"\n",
-				m_path.str().c_str());
-			return false;
-		}
-		if (!itm->is_object()) {
-			printf("ERROR: Malformed CMEC contents file \"%s\": \"module\" is not of type object\n",
-				m_path.str().c_str());
-			return false;
+		if (pw == NULL) {
+			_EXCEPTIONT("Unable to identify path for .cmecrunplan.cache");
 		}
 
-		nlohmann::json jmodule = *itm;
-		auto itmn = jmodule.find("name");
-		if (itmn == jmodule.end()) {
-			printf("ERROR: Malformed CMEC contents file \"%s\": missing key \"module::name\"\n",
-				m_path.str().c_str());
-			return false;
+		filesystem::path pathNamelist(pw->pw_dir);
+		if (!pathNamelist.exists()) {
+			_EXCEPTIONT("pwd points to an invalid home directory path");
 		}
-		if (!itmn->is_string()) {
-			printf("ERROR: Malformed CMEC contents file \"%s\": \"module::name\" is not of type string\n",
-				m_path.str().c_str());
-			return false;
+		m_path = pathNamelist/filesystem::path(g_szCMECRunPlanCacheName);
+	}
+
+	///	<summary>
+	///		Load the cache from disk, if it has not been loaded already.
+	///		A missing or corrupt cache file simply yields an empty cache.
+	///	</summary>
+	void Read() {
+		if (m_fLoaded) {
+			return;
 		}
+		m_fLoaded = true;
 
-		std::string strName = jmodule["name"];
-		for (int i = 0; i < strName.length(); i++) {
-			if (!isalnum(strName[i]) && (strName[i] != '_') && (strName[i] != '/')) {
-				printf("ERROR: Malformed CMEC contents file \"%s\": \"module::name\" entry \"%s\" must only contain alphanumeric characters\n",
-					m_path.str().c_str(),
-					strName.c_str());
-				return false;
+		InitializePath();
+
+		if (m_path.exists()) {
+			MemoryMappedFile mmapcache(m_path.str());
+			try {
+				m_jcache = nlohmann::json::from_cbor(mmapcache.begin(), mmapcache.end());
+			} catch (nlohmann::json::parse_error& e) {
+				m_jcache.clear();
 			}
 		}
 
-		auto itml = jmodule.find("long_name");
-		if (itml == jmodule.end()) {
-			printf("ERROR: Malformed CMEC contents file \"%s\": missing key \"module::long_name\"\n",
-				m_path.str().c_str());
-			return false;
+		if ((!m_jcache.is_object()) ||
+		    (m_jcache.find("plans") == m_jcache.end())
+		) {
+			m_jcache.clear();
+			m_jcache["plans"] = nlohmann::json::value_t::object;
 		}
-		if (!itml->is_string()) {
-			printf("ERROR: Malformed CMEC contents file \"%s\": \"module::long_name\" is not of type string\n",
-				m_path.str().c_str());
-			return false;
+	}
 
+	///	<summary>
+	///		Write the cache to disk, if it has been modified.
+	///	</summary>
+	void Write() {
+		if (!m_fDirty) {
+			return;
 		}
 
-		auto itc = m_jcmec.find("contents");
-		if (itc == m_jcmec.end()) {
-			printf("ERROR: Malformed CMEC contents file \"%s\": missing key \"contents\"\n",
-				m_path.str().c_str());
-			return false;
-		}
-		if (!itc->is_array()) {
-			printf("ERROR: Malformed CMEC contents file \"%s\": \"contents\" is not of type array\n",
+		InitializePath();
+
+		std::ofstream ofcache(m_path.str(), std::ios::out | std::ios::binary);
+		if (!ofcache.is_open()) {
+			_EXCEPTION1("Unable to open \"%s\" for writing",
 				m_path.str().c_str());
-			return false;
 		}
 
-		// Load configurations
-		nlohmann::json jcontents = *itc;
-		for (auto itconfig = jcontents.begin(); itconfig != jcontents.end(); itconfig++) {
-			if (!itconfig->is_string()) {
-				_EXCEPTIONT("Malformed CMEC library file: an entry of the \"contents\" array is not of type string\n");
-			}
+		std::vector<std::uint8_t> vecCBOR = nlohmann::json::to_cbor(m_jcache);
+		ofcache.write(
+			reinterpret_cast<const char *>(&(vecCBOR[0])),
+			vecCBOR.size());
 
-			filesystem::path pathSettings = pathModule / std::string(*itconfig);
+		m_fDirty = false;
+	}
 
-			CMECModuleSettings cmecsettings;
-			bool fSuccess = cmecsettings.ReadFromFile(pathSettings);
-			if (fSuccess) {
-				m_mapConfigs.insert(
-					std::pair<std::string, filesystem::path>(
-						cmecsettings.GetName(), pathSettings));
-			}
+public:
+	///	<summary>
+	///		Append a stamp of the given file to the given stamp array.  A
+	///		missing file is recorded with mtime and size -1, so a plan is
+	///		also invalidated when a file appears that would have changed
+	///		the resolution branch taken.
+	///	</summary>
+	static void StampFile(
+		const filesystem::path & path,
+		nlohmann::json & jstamps
+	) {
+		intmax_t iMTime = 0;
+		intmax_t iSize = 0;
+		if (!CMECValidationCache::GetFileStamp(path, iMTime, iSize)) {
+			iMTime = -1;
+			iSize = -1;
 		}
 
-		return true;
+		nlohmann::json jstamp;
+		jstamp["path"] = path.str();
+		jstamp["mtime"] = iMTime;
+		jstamp["size"] = iSize;
+		jstamps.push_back(jstamp);
 	}
 
 	///	<summary>
-	///		Insert a new path into the TOC.
+	///		Look up the cached plan for the given key.  Returns false if
+	///		the key is absent from the cache or any of the plan's recorded
+	///		file stamps no longer match.
 	///	</summary>
-	bool Insert(
-		const std::string & strConfigName,
-		const filesystem::path & path
+	bool LookupPlan(
+		const std::string & strKey,
+		nlohmann::json & jplan
 	) {
-		// Verify config doesn't exist already
-		if (m_mapConfigs.find(strConfigName) != m_mapConfigs.end()) {
-			printf("\033[1mERROR:\033[0m Repeated configuration name \"%s\"\n",
-				strConfigName.c_str());
+		Read();
 
+		nlohmann::json & jplans = m_jcache["plans"];
+		auto it = jplans.find(strKey);
+		if (it == jplans.end()) {
 			return false;
 		}
 
-		// Insert module
-		m_mapConfigs.insert(
-			std::pair<std::string, filesystem::path>(
-				strConfigName, path));
-
-		m_jcmec["contents"][strConfigName] = path.str();
+		try {
+			const nlohmann::json & jstamps = (*it)["stamps"];
+			for (auto itstamp = jstamps.begin(); itstamp != jstamps.end(); itstamp++) {
+				std::string strPath = (*itstamp)["path"];
+
+				intmax_t iMTime = 0;
+				intmax_t iSize = 0;
+				if (!CMECValidationCache::GetFileStamp(
+						filesystem::path(strPath), iMTime, iSize)
+				) {
+					iMTime = -1;
+					iSize = -1;
+				}
+				if (((*itstamp)["mtime"] != iMTime) ||
+				    ((*itstamp)["size"] != iSize)
+				) {
+					return false;
+				}
+			}
 
-		return true;
-	}
+			jplan = (*it);
 
-public:
-	///	<summary>
-	///		Name of the module.
-	///	<summary>
-	std::string GetName() const {
-		return m_jcmec["module"]["name"];
-	}
+		} catch (std::exception & e) {
+			// A malformed plan entry is treated as a miss
+			return false;
+		}
 
-	///	<summary>
-	///		Long name of the module.
-	///	</summary>
-	std::string GetLongName() const {
-		return m_jcmec["module"]["long_name"];
+		return true;
 	}
 
-public:
 	///	<summary>
-	///		Number of modules in this library.
+	///		Record the resolved plan for the given key.
 	///	</summary>
-	size_t size() const {
-		return m_mapConfigs.size();
-	}
+	void InsertPlan(
+		const std::string & strKey,
+		const nlohmann::json & jplan
+	) {
+		Read();
 
-	///	<summary>
-	///		Constant iterator into module map.
-	///	</summary>
-	ModuleConfigMap::const_iterator begin() const {
-		return m_mapConfigs.begin();
-	}
+		m_jcache["plans"][strKey] = jplan;
 
-	///	<summary>
-	///		Constant iterator into module map.
-	///	</summary>
-	ModuleConfigMap::const_iterator end() const {
-		return m_mapConfigs.end();
+		m_fDirty = true;
 	}
 
 protected:
 	///	<summary>
-	///		Path to the CMEC module.
+	///		Path to the run plan cache.
 	///	</summary>
 	filesystem::path m_path;
 
 	///	<summary>
-	///		Map of configuration names to settings.json files.
+	///		Set when the cache has been loaded from disk.
 	///	</summary>
-	ModuleConfigMap m_mapConfigs;
+	bool m_fLoaded;
 
 	///	<summary>
-	///		JSON file representation of the CMEC TOC file.
+	///		Set when the cache contains entries not yet written to disk.
 	///	</summary>
-	nlohmann::json m_jcmec;
+	bool m_fDirty;
 
+	///	<summary>
+	///		JSON representation of the cache.
+	///	</summary>
+	nlohmann::json m_jcache;
 };
 
 ///////////////////////////////////////////////////////////////////////////////
 
 ///	<summary>
-///		Register the specified module directory.
+///		A persistent history of per-configuration run costs (wall time and
+///		peak resident set size), stored alongside the CMEC library.  Wall
+///		times are smoothed across runs with an exponential moving average
+///		and drive longest-processing-time-first dispatch in the parallel
+///		executor.  The history is advisory:  a missing or corrupt history
+///		file simply yields an empty history.  The history is only accessed
+///		from the main thread.
 ///	</summary>
-int cmec_register(
-	const std::string & strDirectory
-) {
-	printf("Registering \"%s\"", strDirectory.c_str());
+class CMECRunHistory {
 
-	// Check path for cmec.json
-	filesystem::path pathModule(strDirectory);
+public:
+	///	<summary>
+	///		Constructor.
+	///	</summary>
+	CMECRunHistory() :
+		m_fLoaded(false),
+		m_fDirty(false)
+	{ }
 
-	// Module name
-	std::string strName;
+	///	<summary>
+	///		Initialize the run history path.
+	///	</summary>
+	void InitializePath() {
+		char * homedir = getenv("HOME");
 
-	// Check if module contains a settings file
-	if (CMECModuleSettings::ExistsInModulePath(pathModule)) {
-		printf("Validating %s\n", g_szCMECSettingsName);
+		if (homedir != NULL) {
+			filesystem::path pathNamelist(homedir);
+			if (!pathNamelist.exists()) {
+				_EXCEPTIONT("Environment variable $HOME points to an invalid home directory path\n");
+			}
+			m_path = pathNamelist/filesystem::path(g_szCMECRunHistoryName);
+			return;
+		}
 
-		CMECModuleSettings cmecsettings;
-		filesystem::path pathSettings = pathModule / filesystem::path(g_szCMECSettingsName);
-		cmecsettings.ReadFromFile(pathSettings);
+		uid_t uid = getuid();
+		struct passwd *pw = getpwuid(uid);
+
+		if (pw == NULL) {
+			_EXCEPTIONT("Unable to identify path for .cmecrunhistory");
+		}
+
+		filesystem::path pathNamelist(pw->pw_dir);
+		if (!pathNamelist.exists()) {
+			_EXCEPTIONT("pwd points to an invalid home directory path");
+		}
+		m_path = pathNamelist/filesystem::path(g_szCMECRunHistoryName);
+	}
+
+	///	<summary>
+	///		Load the history from disk, if it has not been loaded already.
+	///		A missing or corrupt history file simply yields an empty history.
+	///	</summary>
+	void Read() {
+		if (m_fLoaded) {
+			return;
+		}
+		m_fLoaded = true;
+
+		InitializePath();
+
+		if (m_path.exists()) {
+			MemoryMappedFile mmaphist(m_path.str());
+			try {
+				m_jhistory = nlohmann::json::from_cbor(mmaphist.begin(), mmaphist.end());
+			} catch (nlohmann::json::parse_error& e) {
+				m_jhistory.clear();
+			}
+		}
+
+		if ((!m_jhistory.is_object()) ||
+		    (m_jhistory.find("modules") == m_jhistory.end()) ||
+		    (!m_jhistory["modules"].is_object())
+		) {
+			m_jhistory.clear();
+			m_jhistory["version"] = g_szVersion;
+			m_jhistory["cmec-driver"] = nlohmann::json::value_t::object;
+			m_jhistory["modules"] = nlohmann::json::value_t::object;
+		}
+	}
+
+	///	<summary>
+	///		Write the history to disk, if it has been modified.
+	///	</summary>
+	void Write() {
+		if (!m_fDirty) {
+			return;
+		}
+
+		InitializePath();
+
+		std::ofstream ofhist(m_path.str(), std::ios::out | std::ios::binary);
+		if (!ofhist.is_open()) {
+			_EXCEPTION1("Unable to open \"%s\" for writing",
+				m_path.str().c_str());
+		}
+
+		std::vector<std::uint8_t> vecCBOR = nlohmann::json::to_cbor(m_jhistory);
+		ofhist.write(
+			reinterpret_cast<const char *>(&(vecCBOR[0])),
+			vecCBOR.size());
+
+		m_fDirty = false;
+	}
+
+public:
+	///	<summary>
+	///		Obtain the estimated wall time (seconds) of the given module
+	///		configuration.  Returns false if no history has been recorded.
+	///	</summary>
+	bool GetWallTimeEstimate(
+		const std::string & strModuleName,
+		double & dWallTimeSeconds
+	) {
+		Read();
+
+		nlohmann::json & jmodules = m_jhistory["modules"];
+		auto it = jmodules.find(strModuleName);
+		if (it == jmodules.end()) {
+			return false;
+		}
+
+		dWallTimeSeconds = (*it)["walltime"];
+		return true;
+	}
+
+	///	<summary>
+	///		Record the wall time and peak resident set size of a completed
+	///		run of the given module configuration.  Wall times are smoothed
+	///		with an exponential moving average so a single anomalous run
+	///		does not dominate the estimate.  Alongside the estimate a
+	///		bounded window of recent (timestamp, walltime, rss) samples is
+	///		retained for the stats command.
+	///	</summary>
+	void Record(
+		const std::string & strModuleName,
+		double dWallTimeSeconds,
+		intmax_t iMaxRSSKB
+	) {
+		Read();
+
+		nlohmann::json & jmodules = m_jhistory["modules"];
+		auto it = jmodules.find(strModuleName);
+		if (it == jmodules.end()) {
+			nlohmann::json & jentry = jmodules[strModuleName];
+			jentry["walltime"] = dWallTimeSeconds;
+			jentry["max_rss_kb"] = iMaxRSSKB;
+			jentry["count"] = 1;
+			AppendSample(jentry, dWallTimeSeconds, iMaxRSSKB);
+
+		} else {
+			double dWallTimeAverage = (*it)["walltime"];
+			dWallTimeAverage =
+				0.5 * dWallTimeAverage + 0.5 * dWallTimeSeconds;
+			(*it)["walltime"] = dWallTimeAverage;
+
+			intmax_t iMaxRSSKBPrev = (*it)["max_rss_kb"];
+			if (iMaxRSSKB > iMaxRSSKBPrev) {
+				(*it)["max_rss_kb"] = iMaxRSSKB;
+			}
+
+			int nCount = (*it)["count"];
+			(*it)["count"] = nCount + 1;
+			AppendSample(*it, dWallTimeSeconds, iMaxRSSKB);
+		}
+
+		m_fDirty = true;
+	}
+
+	///	<summary>
+	///		The per-module history records.
+	///	</summary>
+	const nlohmann::json & GetModules() {
+		Read();
+		return m_jhistory["modules"];
+	}
+
+protected:
+	///	<summary>
+	///		Maximum number of recent samples retained per configuration.
+	///	</summary>
+	static const size_t MaxRecentSamples = 16;
+
+	///	<summary>
+	///		Append a (timestamp, walltime, rss) sample to the entry's
+	///		recent-sample window, discarding the oldest beyond the bound.
+	///	</summary>
+	static void AppendSample(
+		nlohmann::json & jentry,
+		double dWallTimeSeconds,
+		intmax_t iMaxRSSKB
+	) {
+		nlohmann::json & jrecent = jentry["recent"];
+		if (!jrecent.is_array()) {
+			jrecent = nlohmann::json::value_t::array;
+		}
+
+		nlohmann::json jsample = nlohmann::json::value_t::array;
+		jsample.push_back(static_cast<intmax_t>(time(NULL)));
+		jsample.push_back(dWallTimeSeconds);
+		jsample.push_back(iMaxRSSKB);
+		jrecent.push_back(jsample);
+
+		while (jrecent.size() > MaxRecentSamples) {
+			jrecent.erase(jrecent.begin());
+		}
+	}
+
+protected:
+	///	<summary>
+	///		Path to the run history.
+	///	</summary>
+	filesystem::path m_path;
+
+	///	<summary>
+	///		Set when the history has been loaded from disk.
+	///	</summary>
+	bool m_fLoaded;
+
+	///	<summary>
+	///		Set when the history contains entries not yet written to disk.
+	///	</summary>
+	bool m_fDirty;
+
+	///	<summary>
+	///		JSON representation of the run history.
+	///	</summary>
+	nlohmann::json m_jhistory;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		A class representing the settings.json file.
+///	</summary>
+class CMECModuleSettings {
+
+public:
+	///	<summary>
+	///		Check for the existence of a contents file.
+	///	</summary>
+	static bool ExistsInModulePath(
+		const filesystem::path & pathModule
+	) {
+		filesystem::path pathSettings = pathModule / filesystem::path(g_szCMECSettingsName);
+		return pathSettings.exists();
+	}
+
+public:
+	///	<summary>
+	///		Clear the CMEC module contents.
+	///	</summary>
+	void Clear() {
+		m_path = filesystem::path();
+		m_jsettings.clear();
+	}
+
+	///	<summary>
+	///		Read and validate the CMEC module contents file, treating an
+	///		absent or malformed file as an expected outcome rather than an
+	///		exceptional one.  No message is formatted unless the caller
+	///		reports the returned result.
+	///	</summary>
+	ValidationResult TryReadFromFile(
+		const filesystem::path & pathSettings
+	) {
+		// Clear the module contents
+		Clear();
+
+		// Store the settings.json file path
+		m_path = pathSettings;
+
+		// Check the validation cache; if the file is unchanged since it
+		// was last validated no reparse is needed
+		{
+			std::string strName;
+			std::string strLongName;
+			std::string strDriver;
+			std::vector<std::string> vecDependencies;
+			if (g_ValidationCache.LookupSettings(
+				pathSettings, strName, strLongName, strDriver,
+				vecDependencies)
+			) {
+				m_jsettings["settings"]["name"] = strName;
+				m_jsettings["settings"]["long_name"] = strLongName;
+				m_jsettings["settings"]["driver"] = strDriver;
+				if (vecDependencies.size() != 0) {
+					m_jsettings["settings"]["dependencies"] = vecDependencies;
+				}
+				return ValidationResult();
+			}
+		}
+
+		// Absent settings files are common when probing candidate module
+		// paths; report them without engaging the exception machinery
+		if (!pathSettings.exists()) {
+			return ValidationResult::Error(
+				ValidationStatus_FileMissing, pathSettings.str());
+		}
+
+		// Parse the CMEC settings json, decompressing gzip content
+		CompressedInputFile mmapCMECjson(pathSettings.str());
+		try {
+			m_jsettings = nlohmann::json::parse(mmapCMECjson.begin(), mmapCMECjson.end());
+		} catch (nlohmann::json::parse_error& e) {
+			return ValidationResult::Error(
+				ValidationStatus_ParseError,
+				pathSettings.str(),
+				e.what());
+		}
+
+		// Validate the CMEC settings json
+		static const JSONSchemaEntry s_schema[] = {
+			{"settings", nlohmann::json::value_t::object},
+			{"settings::name", nlohmann::json::value_t::string},
+			{"settings::long_name", nlohmann::json::value_t::string},
+			{"settings::driver", nlohmann::json::value_t::string},
+			{"varlist", nlohmann::json::value_t::object},
+			{"obslist", nlohmann::json::value_t::object}
+		};
+		static const JSONSchemaValidator s_validator(
+			s_schema, sizeof(s_schema) / sizeof(s_schema[0]));
+
+		std::string strSchemaError;
+		if (!s_validator.Validate(m_jsettings, strSchemaError)) {
+			return ValidationResult::Error(
+				ValidationStatus_SchemaError,
+				pathSettings.str(),
+				strSchemaError);
+		}
+
+		// Validate the optional dependency list, which names sibling
+		// configurations that must complete before this one executes
+		auto itdeps = m_jsettings["settings"].find("dependencies");
+		if (itdeps != m_jsettings["settings"].end()) {
+			if (!itdeps->is_array()) {
+				return ValidationResult::Error(
+					ValidationStatus_SchemaError,
+					pathSettings.str(),
+					"key \"settings::dependencies\" must be of type array");
+			}
+			for (auto itdep = itdeps->begin(); itdep != itdeps->end(); itdep++) {
+				if (!itdep->is_string()) {
+					return ValidationResult::Error(
+						ValidationStatus_SchemaError,
+						pathSettings.str(),
+						"entries of \"settings::dependencies\" must be of type string");
+				}
+			}
+		}
+
+		// Record the validated metadata in the validation cache
+		g_ValidationCache.InsertSettings(
+			pathSettings, GetName(), GetLongName(), GetDriverScript(),
+			GetDependencies());
+
+		return ValidationResult();
+	}
+
+	///	<summary>
+	///		Read the CMEC module contents file, reporting any failure to
+	///		the console.
+	///	</summary>
+	bool ReadFromFile(
+		const filesystem::path & pathSettings
+	) {
+		ValidationResult result = TryReadFromFile(pathSettings);
+		if (!result.IsOK()) {
+			if (result.GetStatus() == ValidationStatus_SchemaError) {
+				printf("ERROR: Malformed CMEC settings file \"%s\": %s\n",
+					pathSettings.str().c_str(),
+					result.GetDetail().c_str());
+			} else {
+				printf("ERROR: CMEC settings file %s\n",
+					result.Format().c_str());
+			}
+			return false;
+		}
+		return true;
+	}
+
+public:
+	///	<summary>
+	///		Name of the module.
+	///	<summary>
+	std::string GetName() const {
+		return m_jsettings["settings"]["name"];
+	}
+
+	///	<summary>
+	///		Long name of the module.
+	///	</summary>
+	std::string GetLongName() const {
+		return m_jsettings["settings"]["long_name"];
+	}
+
+	///	<summary>
+	///		Driver script.
+	///	</summary>
+	std::string GetDriverScript() const {
+		return m_jsettings["settings"]["driver"];
+	}
+
+	///	<summary>
+	///		Names of configurations that must complete before this one
+	///		executes.  Empty if the settings file declares no dependencies.
+	///	</summary>
+	std::vector<std::string> GetDependencies() const {
+		std::vector<std::string> vecDependencies;
+		auto itdeps = m_jsettings["settings"].find("dependencies");
+		if (itdeps != m_jsettings["settings"].end()) {
+			for (auto itdep = itdeps->begin(); itdep != itdeps->end(); itdep++) {
+				vecDependencies.push_back(itdep->get<std::string>());
+			}
+		}
+		return vecDependencies;
+	}
+
+protected:
+	///	<summary>
+	///		Path to the CMEC module.
+	///	</summary>
+	filesystem::path m_path;
+
+	///	<summary>
+	///		JSON file representation of the CMEC TOC file.
+	///	</summary>
+	nlohmann::json m_jsettings;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		A class representing the contents of a specific CMEC module.
+///	</summary>
+class CMECModuleTOC {
+
+public:
+	///	<summary>
+	///		A map from module configurations to paths.
+	///	</summary>
+	typedef std::map<std::string, filesystem::path> ModuleConfigMap;
+
+	///	<summary>
+	///		A const_iterator into the map.
+	///	</summary>
+	typedef ModuleConfigMap::const_iterator const_iterator;
+
+public:
+	///	<summary>
+	///		Check for the existence of a contents file.
+	///	</summary>
+	static bool ExistsInModulePath(
+		const filesystem::path & pathModule
+	) {
+		filesystem::path pathContents = pathModule / filesystem::path(g_szCMECTOCName);
+		return pathContents.exists();
+	}
+
+public:
+	///	<summary>
+	///		Clear the CMEC module contents.
+	///	</summary>
+	void Clear() {
+		m_path = filesystem::path();
+		m_mapConfigs.clear();
+		m_jcmec.clear();
+	}
+
+	///	<summary>
+	///		Read the CMEC module contents file.
+	///	</summary>
+	bool ReadFromModulePath(
+		const filesystem::path & pathModule
+	) {
+		// Clear the module contents
+		Clear();
+
+		// Get the path
+		m_path = pathModule / filesystem::path(g_szCMECTOCName);
+
+		// Check the validation cache; the cached entry is only used if
+		// every referenced settings.json is also validated and unchanged
+		{
+			std::string strName;
+			std::string strLongName;
+			std::map<std::string, std::string> mapConfigs;
+			if (g_ValidationCache.LookupTOC(
+				m_path, strName, strLongName, mapConfigs)
+			) {
+				bool fAllCached = true;
+				for (auto itconfig = mapConfigs.begin(); itconfig != mapConfigs.end(); itconfig++) {
+					std::string strConfigName;
+					std::string strConfigLongName;
+					std::string strConfigDriver;
+					std::vector<std::string> vecConfigDependencies;
+					if (!g_ValidationCache.LookupSettings(
+						filesystem::path(itconfig->second),
+						strConfigName,
+						strConfigLongName,
+						strConfigDriver,
+						vecConfigDependencies)
+					) {
+						fAllCached = false;
+						break;
+					}
+				}
+
+				if (fAllCached) {
+					m_jcmec["module"]["name"] = strName;
+					m_jcmec["module"]["long_name"] = strLongName;
+					for (auto itconfig = mapConfigs.begin(); itconfig != mapConfigs.end(); itconfig++) {
+						m_mapConfigs.insert(
+							std::pair<std::string, filesystem::path>(
+								itconfig->first,
+								filesystem::path(itconfig->second)));
+					}
+					return true;
+				}
+			}
+		}
+
+		// Parse the CMEC json, decompressing gzip content
+		CompressedInputFile mmapCMECjson(m_path.str());
+		try {
+			m_jcmec = nlohmann::json::parse(mmapCMECjson.begin(), mmapCMECjson.end());
+		} catch (nlohmann::json::parse_error& e) {
+			_EXCEPTION3("Malformed CMEC config file "
+				"%s (%i) at byte position %i",
+				e.what(), e.id, e.byte);
+		}
+
+		// Validate the file
+		static const JSONSchemaEntry s_schema[] = {
+			{"module", nlohmann::json::value_t::object},
+			{"module::name", nlohmann::json::value_t::string},
+			{"module::long_name", nlohmann::json::value_t::string},
+			{"contents", nlohmann::json::value_t::array}
+		};
+		static const JSONSchemaValidator s_validator(
+			s_schema, sizeof(s_schema) / sizeof(s_schema[0]));
+
+		std::string strSchemaError;
+		if (!s_validator.Validate(m_jcmec, strSchemaError)) {
+			printf("ERROR: Malformed CMEC contents file \"%s\": %s\n",
+				m_path.str().c_str(),
+				strSchemaError.c_str());
+			return false;
+		}
+
+		std::string strName = m_jcmec["module"]["name"];
+		for (int i = 0; i < strName.length(); i++) {
+			if (!isalnum(strName[i]) && (strName[i] != '_') && (strName[i] != '/')) {
+				printf("ERROR: Malformed CMEC contents file \"%s\": \"module::name\" entry \"%s\" must only contain alphanumeric characters\n",
+					m_path.str().c_str(),
+					strName.c_str());
+				return false;
+			}
+		}
+
+		// Load configurations
+		const nlohmann::json & jcontents = m_jcmec["contents"];
+		for (auto itconfig = jcontents.begin(); itconfig != jcontents.end(); itconfig++) {
+			if (!itconfig->is_string()) {
+				_EXCEPTIONT("Malformed CMEC library file: an entry of the \"contents\" array is not of type string\n");
+			}
+
+			filesystem::path pathSettings = pathModule / std::string(*itconfig);
+
+			CMECModuleSettings cmecsettings;
+			bool fSuccess = cmecsettings.ReadFromFile(pathSettings);
+			if (fSuccess) {
+				m_mapConfigs.insert(
+					std::pair<std::string, filesystem::path>(
+						cmecsettings.GetName(), pathSettings));
+			}
+		}
+
+		// Record the validated metadata in the validation cache
+		g_ValidationCache.InsertTOC(
+			m_path, GetName(), GetLongName(), m_mapConfigs);
+
+		return true;
+	}
+
+	///	<summary>
+	///		Insert a new path into the TOC.
+	///	</summary>
+	bool Insert(
+		const std::string & strConfigName,
+		const filesystem::path & path
+	) {
+		// Verify config doesn't exist already
+		if (m_mapConfigs.find(strConfigName) != m_mapConfigs.end()) {
+			printf("\033[1mERROR:\033[0m Repeated configuration name \"%s\"\n",
+				strConfigName.c_str());
+
+			return false;
+		}
+
+		// Insert module
+		m_mapConfigs.insert(
+			std::pair<std::string, filesystem::path>(
+				strConfigName, path));
+
+		m_jcmec["contents"][strConfigName] = path.str();
+
+		return true;
+	}
+
+public:
+	///	<summary>
+	///		Name of the module.
+	///	<summary>
+	std::string GetName() const {
+		return m_jcmec["module"]["name"];
+	}
+
+	///	<summary>
+	///		Long name of the module.
+	///	</summary>
+	std::string GetLongName() const {
+		return m_jcmec["module"]["long_name"];
+	}
+
+public:
+	///	<summary>
+	///		Number of modules in this library.
+	///	</summary>
+	size_t size() const {
+		return m_mapConfigs.size();
+	}
+
+	///	<summary>
+	///		Constant iterator into module map.
+	///	</summary>
+	ModuleConfigMap::const_iterator begin() const {
+		return m_mapConfigs.begin();
+	}
+
+	///	<summary>
+	///		Constant iterator into module map.
+	///	</summary>
+	ModuleConfigMap::const_iterator end() const {
+		return m_mapConfigs.end();
+	}
+
+protected:
+	///	<summary>
+	///		Path to the CMEC module.
+	///	</summary>
+	filesystem::path m_path;
+
+	///	<summary>
+	///		Map of configuration names to settings.json files.
+	///	</summary>
+	ModuleConfigMap m_mapConfigs;
+
+	///	<summary>
+	///		JSON file representation of the CMEC TOC file.
+	///	</summary>
+	nlohmann::json m_jcmec;
+
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		An interning pool for filesystem paths.  Paths are stored as
+///		immutable nodes sharing parent prefixes and identified by a cheap
+///		integer Handle, so the per-configuration path vectors of a large
+///		sweep cost one word per entry and each module prefix is stored
+///		exactly once.  Full path strings and make_absolute() resolutions
+///		are computed at most once per distinct node and cached.
+///	</summary>
+class PathInternPool {
+
+public:
+	///	<summary>
+	///		Handle to an interned path.
+	///	</summary>
+	typedef size_t Handle;
+
+	///	<summary>
+	///		Handle value indicating no node.
+	///	</summary>
+	static const Handle InvalidHandle = static_cast<Handle>(-1);
+
+public:
+	///	<summary>
+	///		Intern a path string, sharing any already-interned prefix.
+	///	</summary>
+	Handle Intern(const std::string & strPath) {
+		_ASSERT(strPath.length() != 0);
+		return InternRelative(InvalidHandle, strPath);
+	}
+
+	///	<summary>
+	///		Intern a path relative to an already-interned parent.
+	///	</summary>
+	Handle Intern(
+		Handle hParent,
+		const std::string & strRelPath
+	) {
+		_ASSERT(hParent < m_vecNodes.size());
+		return InternRelative(hParent, strRelPath);
+	}
+
+	///	<summary>
+	///		The full path string of the given handle, built at most once.
+	///	</summary>
+	const std::string & Str(Handle h) {
+		_ASSERT(h < m_vecNodes.size());
+		if (m_vecNodes[h].strFullPath.length() == 0) {
+			if (m_vecNodes[h].hParent == InvalidHandle) {
+				m_vecNodes[h].strFullPath = m_vecNodes[h].strComponent;
+
+			} else {
+				const std::string & strParent = Str(m_vecNodes[h].hParent);
+				if (strParent == "/") {
+					m_vecNodes[h].strFullPath =
+						strParent + m_vecNodes[h].strComponent;
+				} else {
+					m_vecNodes[h].strFullPath =
+						strParent + "/" + m_vecNodes[h].strComponent;
+				}
+			}
+		}
+		return m_vecNodes[h].strFullPath;
+	}
+
+	///	<summary>
+	///		The given handle as a filesystem path.
+	///	</summary>
+	filesystem::path GetPath(Handle h) {
+		return filesystem::path(Str(h));
+	}
+
+	///	<summary>
+	///		The absolute form of the given path, resolved at most once per
+	///		distinct node.  Paths that do not exist are returned unchanged,
+	///		since realpath requires an existing file.
+	///	</summary>
+	Handle MakeAbsolute(Handle h) {
+		_ASSERT(h < m_vecNodes.size());
+		if (m_vecNodes[h].hAbsolute != InvalidHandle) {
+			return m_vecNodes[h].hAbsolute;
+		}
+
+		filesystem::path path(Str(h));
+		Handle hAbsolute = h;
+		if (path.exists()) {
+			hAbsolute = Intern(path.make_absolute().str());
+		}
+		m_vecNodes[h].hAbsolute = hAbsolute;
+		return hAbsolute;
+	}
+
+protected:
+	///	<summary>
+	///		One immutable path component, linked to its parent prefix.
+	///	</summary>
+	struct PathNode {
+		Handle hParent;
+		std::string strComponent;
+		std::string strFullPath;
+		Handle hAbsolute;
+		std::map<std::string, Handle> mapChildren;
+	};
+
+	///	<summary>
+	///		Find or create the child of hParent with the given component.
+	///	</summary>
+	Handle FindOrAddChild(
+		Handle hParent,
+		const std::string & strComponent
+	) {
+		{
+			const std::map<std::string, Handle> & mapChildren =
+				(hParent == InvalidHandle)
+					? (m_mapRoots)
+					: (m_vecNodes[hParent].mapChildren);
+			auto it = mapChildren.find(strComponent);
+			if (it != mapChildren.end()) {
+				return it->second;
+			}
+		}
+
+		PathNode node;
+		node.hParent = hParent;
+		node.strComponent = strComponent;
+		node.hAbsolute = InvalidHandle;
+
+		Handle h = m_vecNodes.size();
+		m_vecNodes.push_back(node);
+
+		if (hParent == InvalidHandle) {
+			m_mapRoots.insert(
+				std::pair<std::string, Handle>(strComponent, h));
+		} else {
+			m_vecNodes[hParent].mapChildren.insert(
+				std::pair<std::string, Handle>(strComponent, h));
+		}
+		return h;
+	}
+
+	///	<summary>
+	///		Intern the components of strPath beneath hParent.
+	///	</summary>
+	Handle InternRelative(
+		Handle hParent,
+		const std::string & strPath
+	) {
+		Handle h = hParent;
+		if ((hParent == InvalidHandle) && (strPath[0] == '/')) {
+			h = FindOrAddChild(InvalidHandle, "/");
+		}
+
+		size_t iBegin = 0;
+		while (iBegin < strPath.length()) {
+			size_t iEnd = strPath.find('/', iBegin);
+			if (iEnd == std::string::npos) {
+				iEnd = strPath.length();
+			}
+			if (iEnd != iBegin) {
+				h = FindOrAddChild(h,
+					strPath.substr(iBegin, iEnd - iBegin));
+			}
+			iBegin = iEnd + 1;
+		}
+
+		_ASSERT(h != InvalidHandle);
+		return h;
+	}
+
+protected:
+	///	<summary>
+	///		All interned path nodes.
+	///	</summary>
+	std::vector<PathNode> m_vecNodes;
+
+	///	<summary>
+	///		Map of top-level components to their nodes.
+	///	</summary>
+	std::map<std::string, Handle> m_mapRoots;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Create the given relative directory path beneath an open directory
+///		descriptor, one component at a time via mkdirat, so the parent
+///		prefix is never re-resolved.  Components that already exist are
+///		not an error, so sibling configurations sharing a parent may be
+///		created concurrently.  Returns false if a component could not be
+///		created.
+///	</summary>
+bool CreateDirectoriesAt(
+	int fdParent,
+	const std::string & strRelPath
+) {
+	size_t iBegin = 0;
+	while (iBegin < strRelPath.length()) {
+		size_t iEnd = strRelPath.find('/', iBegin);
+		if (iEnd == std::string::npos) {
+			iEnd = strRelPath.length();
+		}
+		if (iEnd != iBegin) {
+			std::string strPrefix = strRelPath.substr(0, iEnd);
+			if ((mkdirat(fdParent, strPrefix.c_str(), S_IRWXU) != 0) &&
+			    (errno != EEXIST)
+			) {
+				return false;
+			}
+		}
+		iBegin = iEnd + 1;
+	}
+	return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Outcome of a single module driver execution.
+///	</summary>
+struct ModuleRunResult {
+
+	///	<summary>
+	///		Name of the module configuration (working directory name).
+	///	</summary>
+	std::string strModuleName;
+
+	///	<summary>
+	///		Return code from the driver script.
+	///	</summary>
+	int iReturnCode;
+
+	///	<summary>
+	///		Wall time of the driver script (seconds).
+	///	</summary>
+	double dWallTimeSeconds;
+
+	///	<summary>
+	///		Peak resident set size of the driver script (kilobytes).
+	///	</summary>
+	intmax_t iMaxRSSKB;
+
+	///	<summary>
+	///		Set if the driver was never launched because one of its
+	///		dependencies failed.
+	///	</summary>
+	bool fSkipped;
+
+	///	<summary>
+	///		Set if the driver exceeded its wall-clock timeout and was
+	///		killed.
+	///	</summary>
+	bool fTimedOut;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Global profiler instance, enabled by the --profile flag.
+///	</summary>
+static Profiler g_Profiler;
+
+///	<summary>
+///		Write the profiling report to the given directory, if profiling is
+///		enabled.  Per-module wall times and peak RSS are included when
+///		driver execution results are available.
+///	</summary>
+void WriteProfileReport(
+	const std::string & strCommand,
+	const filesystem::path & pathDir,
+	const std::vector<ModuleRunResult> * pvecResults = NULL
+) {
+	if (!g_Profiler.IsEnabled()) {
+		return;
+	}
+
+	nlohmann::json jreport;
+	jreport["version"] = g_szVersion;
+	jreport["command"] = strCommand;
+	jreport["phases"] = nlohmann::json::value_t::object;
+	for (size_t s = 0; s < g_Profiler.size(); s++) {
+		jreport["phases"][g_Profiler.GetPhaseName(s)] =
+			g_Profiler.GetPhaseTime(s);
+	}
+	if (pvecResults != NULL) {
+		jreport["modules"] = nlohmann::json::value_t::object;
+		for (size_t d = 0; d < pvecResults->size(); d++) {
+			nlohmann::json & jmodule =
+				jreport["modules"][(*pvecResults)[d].strModuleName];
+			jmodule["walltime"] = (*pvecResults)[d].dWallTimeSeconds;
+			jmodule["max_rss_kb"] = (*pvecResults)[d].iMaxRSSKB;
+		}
+	}
+
+	filesystem::path pathReport =
+		pathDir / filesystem::path(g_szCMECProfileName);
+
+	std::ofstream ofreport(pathReport.str());
+	if (!ofreport.is_open()) {
+		printf("WARNING: Unable to write profiling report \"%s\"\n",
+			pathReport.str().c_str());
+		return;
+	}
+	ofreport << jreport.dump(4) << std::endl;
+	printf("Profiling report written to \"%s\"\n", pathReport.str().c_str());
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Register the specified module directory.
+///	</summary>
+int cmec_register(
+	const std::string & strDirectory
+) {
+	printf("Registering \"%s\"", strDirectory.c_str());
+
+	// Check path for cmec.json
+	filesystem::path pathModule(strDirectory);
+
+	// Module name
+	std::string strName;
+
+	// Check if module contains a settings file
+	if (CMECModuleSettings::ExistsInModulePath(pathModule)) {
+		printf("Validating %s\n", g_szCMECSettingsName);
+
+		g_Profiler.StartPhase("module/validate");
+		CMECModuleSettings cmecsettings;
+		filesystem::path pathSettings = pathModule / filesystem::path(g_szCMECSettingsName);
+		cmecsettings.ReadFromFile(pathSettings);
+		g_Profiler.EndPhase();
+
+		strName = cmecsettings.GetName();
+
+	// Check if module contains a contents file
+	} else if (CMECModuleTOC::ExistsInModulePath(pathModule)) {
+		printf("Validating %s\n", g_szCMECTOCName);
+
+		g_Profiler.StartPhase("module/validate");
+		CMECModuleTOC cmectoc;
+		cmectoc.ReadFromModulePath(pathModule);
+		g_Profiler.EndPhase();
+
+		// Output metadata
+		strName = cmectoc.GetName();
+		std::string strLongName = cmectoc.GetLongName();
+		printf("Module \033[1m%s\033[0m (\033[1m%s\033[0m)\n", strName.c_str(), strLongName.c_str());
+
+		// Check number of configurations
+		printf("Contains \033[1m%lu configurations\033[0m:\n", cmectoc.size());
+		printf("------------------------------------------------------------\n");
+		for (auto itconfig = cmectoc.begin(); itconfig != cmectoc.end(); itconfig++) {
+			printf("  %s/%s\n", strName.c_str(), itconfig->first.c_str());
+		}
+		printf("------------------------------------------------------------\n");
+
+	// Both files missing; throw error
+	} else {
+		printf("ERROR: Module path must contain \"%s\" or \"%s\"\n",
+			g_szCMECTOCName,
+			g_szCMECSettingsName);
+
+		return (-1);
+	}
+
+	// Load the CMEC library
+	printf("Reading CMEC library\n");
+	g_Profiler.StartPhase("library/read");
+	CMECLibrary lib;
+	lib.Read();
+	g_Profiler.EndPhase();
+
+	// Add this path to the library
+	printf("Adding new module to library\n");
+	bool fSuccess = lib.Insert(strName, pathModule);
+	if (!fSuccess) {
+		return (-1);
+	}
+
+	// Write CMEC library
+	printf("Writing CMEC library\n");
+	g_Profiler.StartPhase("library/write");
+	lib.Write();
+	g_Profiler.EndPhase();
+
+	WriteProfileReport("register", filesystem::path("."));
+
+	return 0;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Scan a directory tree for modules and register all discovered
+///		modules with a single library read-modify-write.  The tree walk
+///		and per-module validation are distributed across a worker pool;
+///		a directory containing a settings or contents file is treated as
+///		a module root and is not descended into further.
+///	</summary>
+int cmec_register_scan(
+	const std::string & strRootDir
+) {
+	printf("Scanning \"%s\" for modules\n", strRootDir.c_str());
+
+	filesystem::path pathRoot(strRootDir);
+	if (!pathRoot.exists()) {
+		printf("ERROR: Cannot access path \"%s\"\n", strRootDir.c_str());
+		return (-1);
+	}
+	pathRoot = pathRoot.make_absolute();
+	if (!pathRoot.is_directory()) {
+		printf("ERROR: \"%s\" is not a directory\n", strRootDir.c_str());
+		return (-1);
+	}
+
+	// A module discovered by the tree walk, validated by the worker that
+	// found it
+	struct DiscoveredModule {
+		std::string strName;
+		filesystem::path path;
+		bool fValid;
+	};
+	std::vector<DiscoveredModule> vecDiscovered;
+
+	// Walk the tree with a shared work queue of pending directories.
+	// Workers pop a directory, probe it for module markers, and either
+	// validate it as a module or push its subdirectories back on the
+	// queue.  nInFlight tracks directories currently being processed so
+	// workers only exit once the queue is empty and no worker can still
+	// produce new entries.
+	g_Profiler.StartPhase("scan/walk");
+	{
+		std::mutex mutexWork;
+		std::condition_variable cvWork;
+		std::vector<filesystem::path> vecPending;
+		size_t nInFlight = 0;
+
+		vecPending.push_back(pathRoot);
+
+		std::mutex mutexDiscovered;
+
+		auto WorkerLoop = [&]() {
+			std::unique_lock<std::mutex> lock(mutexWork);
+			for (;;) {
+				if (vecPending.empty()) {
+					if (nInFlight == 0) {
+						break;
+					}
+					cvWork.wait(lock);
+					continue;
+				}
+
+				filesystem::path pathDir = vecPending.back();
+				vecPending.pop_back();
+				nInFlight++;
+				lock.unlock();
+
+				bool fIsModule =
+					CMECModuleSettings::ExistsInModulePath(pathDir) ||
+					CMECModuleTOC::ExistsInModulePath(pathDir);
+
+				std::vector<filesystem::path> vecSubDirs;
+
+				if (fIsModule) {
+					DiscoveredModule discovered;
+					discovered.path = pathDir;
+					discovered.fValid = false;
+
+					if (CMECModuleSettings::ExistsInModulePath(pathDir)) {
+						CMECModuleSettings cmecsettings;
+						if (cmecsettings.ReadFromFile(
+								pathDir / filesystem::path(g_szCMECSettingsName))
+						) {
+							discovered.strName = cmecsettings.GetName();
+							discovered.fValid = true;
+						}
+
+					} else {
+						CMECModuleTOC cmectoc;
+						if (cmectoc.ReadFromModulePath(pathDir)) {
+							discovered.strName = cmectoc.GetName();
+							discovered.fValid = true;
+						}
+					}
+
+					{
+						std::lock_guard<std::mutex> lockDiscovered(mutexDiscovered);
+						vecDiscovered.push_back(discovered);
+					}
+
+				} else {
+					DIR * pDir = opendir(pathDir.str().c_str());
+					if (pDir != NULL) {
+						struct dirent * pDirent;
+						while ((pDirent = readdir(pDir)) != NULL) {
+							std::string strEntry(pDirent->d_name);
+							if ((strEntry.length() == 0) || (strEntry[0] == '.')) {
+								continue;
+							}
+							filesystem::path pathEntry =
+								pathDir / filesystem::path(strEntry);
+							if (pathEntry.is_directory()) {
+								vecSubDirs.push_back(pathEntry);
+							}
+						}
+						closedir(pDir);
+					}
+				}
+
+				lock.lock();
+				for (size_t s = 0; s < vecSubDirs.size(); s++) {
+					vecPending.push_back(vecSubDirs[s]);
+				}
+				nInFlight--;
+				if ((!vecPending.empty()) || (nInFlight == 0)) {
+					cvWork.notify_all();
+				}
+			}
+		};
+
+		size_t nWorkers = std::thread::hardware_concurrency();
+		if (nWorkers == 0) {
+			nWorkers = 1;
+		}
+		if (nWorkers > 8) {
+			nWorkers = 8;
+		}
+
+		std::vector<std::thread> vecWorkers;
+		for (size_t w = 0; w < nWorkers; w++) {
+			vecWorkers.push_back(std::thread(WorkerLoop));
+		}
+		for (size_t w = 0; w < vecWorkers.size(); w++) {
+			vecWorkers[w].join();
+		}
+	}
+	g_Profiler.EndPhase();
+
+	// Check for zero modules
+	if (vecDiscovered.size() == 0) {
+		printf("No modules found under \"%s\"\n", pathRoot.str().c_str());
+		WriteProfileReport("register", filesystem::path("."));
+		return 0;
+	}
+
+	// Sort by path so output and insertion order are deterministic
+	std::sort(
+		vecDiscovered.begin(),
+		vecDiscovered.end(),
+		[](const DiscoveredModule & a, const DiscoveredModule & b) {
+			return (a.path.str() < b.path.str());
+		});
+
+	printf("Discovered %lu module(s):\n", vecDiscovered.size());
+	printf("------------------------------------------------------------\n");
+	for (size_t d = 0; d < vecDiscovered.size(); d++) {
+		if (vecDiscovered[d].fValid) {
+			printf("  %s (%s)\n",
+				vecDiscovered[d].strName.c_str(),
+				vecDiscovered[d].path.str().c_str());
+		} else {
+			printf("  INVALID (%s)\n",
+				vecDiscovered[d].path.str().c_str());
+		}
+	}
+	printf("------------------------------------------------------------\n");
+
+	// Load the CMEC library once and commit all discovered modules in a
+	// single read-modify-write
+	printf("Reading CMEC library\n");
+	g_Profiler.StartPhase("library/read");
+	CMECLibrary lib;
+	lib.Read();
+	g_Profiler.EndPhase();
+
+	printf("Adding new modules to library\n");
+	size_t nRegistered = 0;
+	for (size_t d = 0; d < vecDiscovered.size(); d++) {
+		if (!vecDiscovered[d].fValid) {
+			continue;
+		}
+		if (lib.Insert(vecDiscovered[d].strName, vecDiscovered[d].path)) {
+			nRegistered++;
+		}
+	}
+
+	printf("Writing CMEC library\n");
+	g_Profiler.StartPhase("library/write");
+	lib.Write();
+	g_Profiler.EndPhase();
+
+	printf("Registered %lu of %lu discovered module(s)\n",
+		nRegistered, vecDiscovered.size());
+
+	WriteProfileReport("register", filesystem::path("."));
+
+	return 0;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Unregister the specified module.
+///	</summary>
+int cmec_unregister(
+	const std::string & strModuleName
+) {
+	printf("Unregistering \"%s\"\n", strModuleName.c_str());
+
+	// Load the CMEC library
+	printf("Reading CMEC library\n");
+	CMECLibrary lib;
+	lib.Read();
+
+	// Remove module
+	printf("Removing module\n");
+	bool fSuccess = lib.Remove(strModuleName);
+	if (!fSuccess) {
+		return (-1);
+	}
+
+	// Write CMEC library
+	printf("Writing CMEC library\n");
+	lib.Write();
+
+	return 0;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		List available modules and configurations from an already-loaded
+///		library.  In JSON mode the entire library state is serialized
+///		into one document and written to stdout with a single buffered
+///		write, for direct consumption by tooling.
+///	</summary>
+int cmec_list(
+	bool fListAll,
+	const CMECLibrary & lib,
+	bool fJSON = false
+) {
+	// Check for size zero library
+	if (lib.size() == 0) {
+		if (fJSON) {
+			nlohmann::json jdoc;
+			jdoc["module_count"] = 0;
+			jdoc["modules"] = nlohmann::json::array();
+
+			std::string strOutput = jdoc.dump();
+			strOutput += "\n";
+			fwrite(strOutput.c_str(), 1, strOutput.length(), stdout);
+
+		} else {
+			printf("CMEC library contains no modules\n");
+		}
+		WriteProfileReport("list", filesystem::path("."));
+		return 0;
+	}
+
+	// Flatten the module map so entries can be processed concurrently
+	std::vector<std::string> vecModuleNames;
+	std::vector<filesystem::path> vecModulePaths;
+	for (auto it = lib.begin(); it != lib.end(); it++) {
+		vecModuleNames.push_back(it->first);
+		vecModulePaths.push_back(it->second);
+	}
+
+	// Per-module listing information, gathered by the worker pool
+	struct ModuleListEntry {
+		bool fHasTOC;
+		std::vector<std::string> vecConfigNames;
+	};
+	std::vector<ModuleListEntry> vecEntries(vecModuleNames.size());
+
+	// Read TOCs concurrently across modules; each TOC read opens and
+	// parses every configuration's settings.json, so on network
+	// filesystems this loop is dominated by serialized I/O latency.
+	{
+		g_Profiler.StartPhase("toc/read");
+		std::atomic<size_t> sNextModule(0);
+
+		auto WorkerLoop = [&]() {
+			for (;;) {
+				size_t m = sNextModule.fetch_add(1);
+				if (m >= vecModulePaths.size()) {
+					break;
+				}
+
+				vecEntries[m].fHasTOC =
+					CMECModuleTOC::ExistsInModulePath(vecModulePaths[m]);
+				if (vecEntries[m].fHasTOC) {
+					CMECModuleTOC cmectoc;
+					cmectoc.ReadFromModulePath(vecModulePaths[m]);
+					for (auto itconfig = cmectoc.begin(); itconfig != cmectoc.end(); itconfig++) {
+						vecEntries[m].vecConfigNames.push_back(itconfig->first);
+					}
+				}
+			}
+		};
+
+		size_t nWorkers = std::thread::hardware_concurrency();
+		if (nWorkers == 0) {
+			nWorkers = 1;
+		}
+		if (nWorkers > 8) {
+			nWorkers = 8;
+		}
+		if (nWorkers > vecModulePaths.size()) {
+			nWorkers = vecModulePaths.size();
+		}
+
+		std::vector<std::thread> vecWorkers;
+		for (size_t w = 0; w < nWorkers; w++) {
+			vecWorkers.push_back(std::thread(WorkerLoop));
+		}
+		for (size_t w = 0; w < vecWorkers.size(); w++) {
+			vecWorkers[w].join();
+		}
+		g_Profiler.EndPhase();
+	}
+
+	// Serialize the entire library state as one JSON document.  The
+	// single buffered write avoids the per-line printf cost that
+	// dominates "list all" over an SSH pty with a large library.
+	if (fJSON) {
+		nlohmann::json jdoc;
+		jdoc["module_count"] = vecModuleNames.size();
+
+		nlohmann::json & jmodules = jdoc["modules"];
+		jmodules = nlohmann::json::array();
+		for (size_t m = 0; m < vecModuleNames.size(); m++) {
+			nlohmann::json jmodule;
+			jmodule["name"] = vecModuleNames[m];
+			jmodule["path"] = vecModulePaths[m].str();
+			jmodule["has_contents"] = vecEntries[m].fHasTOC;
+			if (vecEntries[m].fHasTOC) {
+				jmodule["configuration_count"] =
+					vecEntries[m].vecConfigNames.size();
+
+				nlohmann::json & jconfigs = jmodule["configurations"];
+				jconfigs = nlohmann::json::array();
+				for (size_t c = 0; c < vecEntries[m].vecConfigNames.size(); c++) {
+					jconfigs.push_back(vecEntries[m].vecConfigNames[c]);
+				}
+			}
+			jmodules.push_back(jmodule);
+		}
+
+		std::string strOutput = jdoc.dump();
+		strOutput += "\n";
+		fwrite(strOutput.c_str(), 1, strOutput.length(), stdout);
+
+		WriteProfileReport("list", filesystem::path("."));
+
+		return 0;
+	}
+
+	// List modules in deterministic order
+	printf("CMEC library contains %lu modules:\n", lib.size());
+	printf("------------------------------------------------------------\n");
+	for (size_t m = 0; m < vecModuleNames.size(); m++) {
+		if (vecEntries[m].fHasTOC) {
+			printf("  %s [%lu configurations]\n",
+				vecModuleNames[m].c_str(),
+				vecEntries[m].vecConfigNames.size());
+			if (fListAll) {
+				for (size_t c = 0; c < vecEntries[m].vecConfigNames.size(); c++) {
+					printf("    %s/%s\n",
+						vecModuleNames[m].c_str(),
+						vecEntries[m].vecConfigNames[c].c_str());
+				}
+			}
+
+		} else {
+			printf("  %s\n", vecModuleNames[m].c_str());
+		}
+	}
+	printf("------------------------------------------------------------\n");
+
+	WriteProfileReport("list", filesystem::path("."));
+
+	return 0;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		List available modules and configurations, loading the library
+///		from disk.
+///	</summary>
+int cmec_list(
+	bool fListAll,
+	bool fJSON = false
+) {
+	// Load the CMEC library (in JSON mode keep stdout to the document)
+	if (!fJSON) {
+		printf("Reading CMEC library\n");
+	}
+	g_Profiler.StartPhase("library/read");
+	CMECLibrary lib;
+	lib.Read();
+	g_Profiler.EndPhase();
+
+	return cmec_list(fListAll, lib, fJSON);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		A single module driver launch:  the driver script and the CMEC
+///		environment it should execute under.
+///	</summary>
+struct ModuleRunCommand {
+
+	///	<summary>
+	///		Path to the module driver script.
+	///	</summary>
+	filesystem::path pathDriverScript;
+
+	///	<summary>
+	///		Path to the module code directory (CMEC_CODE_DIR).
+	///	</summary>
+	filesystem::path pathCodeDir;
+
+	///	<summary>
+	///		Path to the module working directory (CMEC_WK_DIR).
+	///	</summary>
+	filesystem::path pathWorkingDir;
+
+	///	<summary>
+	///		Name of the module configuration (working directory name).
+	///	</summary>
+	std::string strModuleName;
+
+	///	<summary>
+	///		Indices of commands in the same command vector that must
+	///		complete successfully before this command executes.
+	///	</summary>
+	std::vector<size_t> vecDependencies;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Resource limits applied to each spawned module driver.  A zero
+///		value leaves the corresponding resource unlimited.
+///	</summary>
+struct DriverResourceLimits {
+
+	///	<summary>
+	///		Grace period between SIGTERM and SIGKILL when a timed-out
+	///		driver's process group is torn down (seconds).
+	///	</summary>
+	static const int KillGraceSeconds = 5;
+
+	///	<summary>
+	///		Wall-clock timeout per driver (seconds).
+	///	</summary>
+	double dTimeoutSeconds;
+
+	///	<summary>
+	///		Address space cap per driver process (megabytes), applied as
+	///		RLIMIT_AS in the child before exec.
+	///	</summary>
+	intmax_t iMaxMemoryMB;
+
+	///	<summary>
+	///		CPU time cap per driver process (seconds), applied as
+	///		RLIMIT_CPU in the child before exec.
+	///	</summary>
+	intmax_t iMaxCPUSeconds;
+
+	///	<summary>
+	///		Constructor (all resources unlimited).
+	///	</summary>
+	DriverResourceLimits() :
+		dTimeoutSeconds(0.0),
+		iMaxMemoryMB(0),
+		iMaxCPUSeconds(0)
+	{ }
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Launch a module driver directly, building the CMEC environment in
+///		the child's envp rather than generating an intermediate
+///		cmec_run.bash script.  If strDataManifest is nonempty it is
+///		exported as CMEC_DATA_MANIFEST so conforming modules can read the
+///		indexed data listing instead of walking the data directories
+///		themselves.  If iStdoutFd is nonnegative the child's stdout and
+///		stderr are redirected to that descriptor (typically the write end
+///		of a log capture pipe); otherwise the child inherits the console.
+///		The child is forked rather than posix_spawn'd so RLIMIT_AS and
+///		RLIMIT_CPU caps from limits can be installed before exec, and is
+///		placed in its own process group so a wall-clock timeout tears
+///		down the driver together with everything it spawned (SIGTERM,
+///		then SIGKILL after a grace period).  fTimedOut is set if the
+///		timeout fired.  The peak resident set size of the driver
+///		(kilobytes) is returned in iMaxRSSKB.  Returns the driver's exit
+///		status.
+///	</summary>
+int SpawnDriverScript(
+	const ModuleRunCommand & cmd,
+	const filesystem::path & pathObsDir,
+	const filesystem::path & pathModelDir,
+	const std::string & strDataManifest,
+	int iStdoutFd,
+	const DriverResourceLimits & limits,
+	intmax_t & iMaxRSSKB,
+	bool & fTimedOut
+) {
+	iMaxRSSKB = 0;
+	fTimedOut = false;
+
+	// Build the child environment:  the parent environment plus the CMEC
+	// environment variables.
+	std::vector<std::string> vecEnv;
+	for (char ** p = environ; *p != NULL; p++) {
+		vecEnv.push_back(*p);
+	}
+	vecEnv.push_back(std::string("CMEC_CODE_DIR=") + cmd.pathCodeDir.str());
+	vecEnv.push_back(std::string("CMEC_OBS_DATA=") + pathObsDir.str());
+	vecEnv.push_back(std::string("CMEC_MODEL_DATA=") + pathModelDir.str());
+	vecEnv.push_back(std::string("CMEC_WK_DIR=") + cmd.pathWorkingDir.str());
+	if (strDataManifest.length() != 0) {
+		vecEnv.push_back(std::string("CMEC_DATA_MANIFEST=") + strDataManifest);
+	}
+
+	std::vector<char *> vecEnvp;
+	for (size_t i = 0; i < vecEnv.size(); i++) {
+		vecEnvp.push_back(const_cast<char *>(vecEnv[i].c_str()));
+	}
+	vecEnvp.push_back(NULL);
+
+	std::string strDriverScript = cmd.pathDriverScript.str();
+
+	// Exec the driver directly; scripts with a shebang line are handled
+	// by the kernel.  If the script is not directly executable fall back
+	// to launching it through /bin/sh.
+	char * szArgvDirect[] = {
+		const_cast<char *>(strDriverScript.c_str()),
+		NULL};
+
+	char * szArgvShell[] = {
+		const_cast<char *>("/bin/sh"),
+		const_cast<char *>(strDriverScript.c_str()),
+		NULL};
+
+	// Exec failures in the child are reported back through this pipe;
+	// on a successful exec both close-on-exec ends vanish and the
+	// parent's read simply sees end of file.
+	int iErrPipe[2];
+	if (pipe2(iErrPipe, O_CLOEXEC) != 0) {
+		printf("ERROR: Unable to create exec status pipe for driver "
+			"\"%s\" (%s)\n",
+			strDriverScript.c_str(),
+			strerror(errno));
+		return (-1);
+	}
+
+	pid_t pid = fork();
+	if (pid == -1) {
+		printf("ERROR: Unable to fork for driver \"%s\" (%s)\n",
+			strDriverScript.c_str(),
+			strerror(errno));
+		close(iErrPipe[0]);
+		close(iErrPipe[1]);
+		return (-1);
+	}
+
+	if (pid == 0) {
+		// Child:  own process group (so a timeout can signal the whole
+		// driver tree), output redirection, resource caps, then exec.
+		// Only async-signal-safe calls are permitted here.
+		setpgid(0, 0);
+
+		if (iStdoutFd >= 0) {
+			dup2(iStdoutFd, STDOUT_FILENO);
+			dup2(STDOUT_FILENO, STDERR_FILENO);
+		}
+
+		if (limits.iMaxMemoryMB > 0) {
+			struct rlimit rlim;
+			rlim.rlim_cur = static_cast<rlim_t>(limits.iMaxMemoryMB)
+				* 1024 * 1024;
+			rlim.rlim_max = rlim.rlim_cur;
+			setrlimit(RLIMIT_AS, &rlim);
+		}
+		if (limits.iMaxCPUSeconds > 0) {
+			struct rlimit rlim;
+			rlim.rlim_cur = static_cast<rlim_t>(limits.iMaxCPUSeconds);
+			rlim.rlim_max = rlim.rlim_cur;
+			setrlimit(RLIMIT_CPU, &rlim);
+		}
+
+		execve(strDriverScript.c_str(), szArgvDirect, &(vecEnvp[0]));
+		if ((errno == ENOEXEC) || (errno == EACCES)) {
+			execve("/bin/sh", szArgvShell, &(vecEnvp[0]));
+		}
+
+		int iExecErrno = errno;
+		ssize_t nWritten =
+			write(iErrPipe[1], &iExecErrno, sizeof(iExecErrno));
+		(void)nWritten;
+		_exit(127);
+	}
+
+	// Mirror the child's setpgid so the group exists before any signal
+	// is sent, whichever side runs first (fails harmlessly after exec)
+	setpgid(pid, pid);
+
+	close(iErrPipe[1]);
+	int iExecErrno = 0;
+	if (read(iErrPipe[0], &iExecErrno, sizeof(iExecErrno))
+		== static_cast<ssize_t>(sizeof(iExecErrno))
+	) {
+		close(iErrPipe[0]);
+		printf("ERROR: Unable to launch driver \"%s\" (%s)\n",
+			strDriverScript.c_str(),
+			strerror(iExecErrno));
+		int iStatus = 0;
+		waitpid(pid, &iStatus, 0);
+		return (-1);
+	}
+	close(iErrPipe[0]);
+
+	// Wait for the driver to complete, collecting its resource usage.
+	// Under a timeout the wait is a polling loop so an overdue driver's
+	// process group can be signalled:  SIGTERM at the deadline, SIGKILL
+	// once the grace period expires.
+	int iStatus = 0;
+	struct rusage usage;
+
+	if (limits.dTimeoutSeconds <= 0.0) {
+		if (wait4(pid, &iStatus, 0, &usage) == -1) {
+			printf("ERROR: wait4 failed for driver \"%s\" (%s)\n",
+				strDriverScript.c_str(),
+				strerror(errno));
+			return (-1);
+		}
+
+	} else {
+		auto timeDeadline =
+			std::chrono::steady_clock::now()
+			+ std::chrono::duration_cast<
+				std::chrono::steady_clock::duration>(
+					std::chrono::duration<double>(
+						limits.dTimeoutSeconds));
+		auto timeKillAt = timeDeadline
+			+ std::chrono::seconds(
+				DriverResourceLimits::KillGraceSeconds);
+		bool fTermSent = false;
+		bool fKillSent = false;
+
+		for (;;) {
+			pid_t pidWait = wait4(pid, &iStatus, WNOHANG, &usage);
+			if (pidWait == pid) {
+				break;
+			}
+			if (pidWait == -1) {
+				printf("ERROR: wait4 failed for driver \"%s\" (%s)\n",
+					strDriverScript.c_str(),
+					strerror(errno));
+				return (-1);
+			}
+
+			auto timeNow = std::chrono::steady_clock::now();
+			if ((!fTermSent) && (timeNow >= timeDeadline)) {
+				fTimedOut = true;
+				fTermSent = true;
+				kill(-pid, SIGTERM);
+			} else if (fTermSent && (!fKillSent) && (timeNow >= timeKillAt)) {
+				fKillSent = true;
+				kill(-pid, SIGKILL);
+			}
+
+			struct timespec tsPoll;
+			tsPoll.tv_sec = 0;
+			tsPoll.tv_nsec = 100 * 1000 * 1000;
+			nanosleep(&tsPoll, NULL);
+		}
+	}
+
+	iMaxRSSKB = static_cast<intmax_t>(usage.ru_maxrss);
+	if (WIFEXITED(iStatus)) {
+		return WEXITSTATUS(iStatus);
+	}
+	if (WIFSIGNALED(iStatus)) {
+		return 128 + WTERMSIG(iStatus);
+	}
+	return iStatus;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Collects module driver output from per-driver pipes on a single
+///		collector thread, multiplexed with poll().  Each driver's output
+///		is written to its own log file as it arrives, so a chatty module
+///		is never throttled by console I/O, and when the console is a
+///		terminal a compact live status line is shown in place of raw
+///		interleaved output.
+///	</summary>
+class ModuleLogCollector {
+
+public:
+	///	<summary>
+	///		Poll timeout, which bounds the status line refresh interval
+	///		(milliseconds).
+	///	</summary>
+	static const int PollTimeoutMS = 200;
+
+public:
+	///	<summary>
+	///		Constructor.  The console mutex is shared with the worker pool
+	///		so status line updates and completion messages interleave
+	///		cleanly.
+	///	</summary>
+	ModuleLogCollector(
+		std::mutex & mutexConsole
+	) :
+		m_mutexConsole(mutexConsole),
+		m_fStop(false),
+		m_nClosedChannels(0),
+		m_fStatusLine(isatty(STDOUT_FILENO) != 0)
+	{
+		if (pipe2(m_iWakePipe, O_CLOEXEC) != 0) {
+			_EXCEPTION1("Unable to create collector wake pipe (%s)",
+				strerror(errno));
+		}
+	}
+
+	///	<summary>
+	///		Destructor.
+	///	</summary>
+	~ModuleLogCollector() {
+		Stop();
+		close(m_iWakePipe[0]);
+		close(m_iWakePipe[1]);
+	}
+
+	///	<summary>
+	///		Launch the collector thread.
+	///	</summary>
+	void Start() {
+		m_thread = std::thread(&ModuleLogCollector::CollectorLoop, this);
+	}
+
+	///	<summary>
+	///		Register the read end of a driver's output pipe.  The collector
+	///		takes ownership of the descriptor and writes the driver's
+	///		output to the given log file until the pipe reaches end of
+	///		file.
+	///	</summary>
+	void Register(
+		int fd,
+		const std::string & strLogFile,
+		const std::string & strModuleName
+	) {
+		FILE * fp = fopen(strLogFile.c_str(), "w");
+		if (fp == NULL) {
+			std::lock_guard<std::mutex> lockconsole(m_mutexConsole);
+			ClearStatusLine();
+			printf("WARNING: Unable to open log file \"%s\"; "
+				"output of \"%s\" will be discarded\n",
+				strLogFile.c_str(), strModuleName.c_str());
+		}
+
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			LogChannel chan;
+			chan.fd = fd;
+			chan.fp = fp;
+			chan.strModuleName = strModuleName;
+			chan.sBytes = 0;
+			m_vecChannels.push_back(chan);
+		}
+		Wake();
+	}
+
+	///	<summary>
+	///		Drain all remaining output and stop the collector thread.
+	///	</summary>
+	void Stop() {
+		if (!m_thread.joinable()) {
+			return;
+		}
+		m_fStop = true;
+		Wake();
+		m_thread.join();
+	}
+
+	///	<summary>
+	///		Erase the live status line ahead of a console message.  The
+	///		caller must hold the console mutex.
+	///	</summary>
+	void ClearStatusLine() {
+		if (m_fStatusLine) {
+			printf("\r\033[K");
+		}
+	}
+
+protected:
+	///	<summary>
+	///		One registered driver output pipe.
+	///	</summary>
+	struct LogChannel {
+		int fd;
+		FILE * fp;
+		std::string strModuleName;
+		size_t sBytes;
+	};
+
+	///	<summary>
+	///		Wake the collector thread out of poll().
+	///	</summary>
+	void Wake() {
+		char c = 0;
+		ssize_t sWritten = write(m_iWakePipe[1], &c, 1);
+		if (sWritten == -1) {
+			// The wake pipe being full already guarantees a wakeup
+		}
+	}
+
+	///	<summary>
+	///		Collector thread:  poll all registered pipes, appending
+	///		arriving output to the per-module log files and refreshing
+	///		the status line.
+	///	</summary>
+	void CollectorLoop() {
+		std::vector<struct pollfd> vecPollFds;
+		char szBuffer[65536];
+
+		for (;;) {
+			// Build the poll set:  the wake pipe plus all open channels
+			vecPollFds.clear();
+
+			struct pollfd pfdWake;
+			pfdWake.fd = m_iWakePipe[0];
+			pfdWake.events = POLLIN;
+			pfdWake.revents = 0;
+			vecPollFds.push_back(pfdWake);
+
+			size_t sOpenChannels = 0;
+			{
+				std::lock_guard<std::mutex> lock(m_mutex);
+				for (size_t s = 0; s < m_vecChannels.size(); s++) {
+					if (m_vecChannels[s].fd < 0) {
+						continue;
+					}
+					struct pollfd pfd;
+					pfd.fd = m_vecChannels[s].fd;
+					pfd.events = POLLIN;
+					pfd.revents = 0;
+					vecPollFds.push_back(pfd);
+					sOpenChannels++;
+				}
+			}
+
+			if (m_fStop && (sOpenChannels == 0)) {
+				break;
+			}
+
+			int iReady = poll(&(vecPollFds[0]), vecPollFds.size(), PollTimeoutMS);
+			if (iReady == -1) {
+				if (errno == EINTR) {
+					continue;
+				}
+				break;
+			}
+
+			// Drain the wake pipe
+			if (vecPollFds[0].revents & POLLIN) {
+				ssize_t sRead = read(m_iWakePipe[0], szBuffer, sizeof(szBuffer));
+				if (sRead == -1) {
+					// Spurious wakeups are harmless
+				}
+			}
+
+			// Drain ready channels
+			for (size_t p = 1; p < vecPollFds.size(); p++) {
+				if ((vecPollFds[p].revents & (POLLIN | POLLHUP)) == 0) {
+					continue;
+				}
+
+				std::lock_guard<std::mutex> lock(m_mutex);
+				for (size_t s = 0; s < m_vecChannels.size(); s++) {
+					if (m_vecChannels[s].fd != vecPollFds[p].fd) {
+						continue;
+					}
+
+					ssize_t sRead =
+						read(m_vecChannels[s].fd, szBuffer, sizeof(szBuffer));
+					if (sRead > 0) {
+						if (m_vecChannels[s].fp != NULL) {
+							fwrite(szBuffer, 1, sRead, m_vecChannels[s].fp);
+						}
+						m_vecChannels[s].sBytes +=
+							static_cast<size_t>(sRead);
+
+					} else {
+						// End of file:  the driver has exited and all
+						// write ends of the pipe are closed
+						close(m_vecChannels[s].fd);
+						m_vecChannels[s].fd = -1;
+						if (m_vecChannels[s].fp != NULL) {
+							fclose(m_vecChannels[s].fp);
+							m_vecChannels[s].fp = NULL;
+						}
+						m_nClosedChannels++;
+					}
+					break;
+				}
+			}
+
+			RefreshStatusLine();
+		}
+
+		// Erase the status line on shutdown
+		if (m_fStatusLine) {
+			std::lock_guard<std::mutex> lockconsole(m_mutexConsole);
+			ClearStatusLine();
+			fflush(stdout);
+		}
+	}
+
+	///	<summary>
+	///		Redraw the live status line showing active modules and their
+	///		accumulated log sizes.
+	///	</summary>
+	void RefreshStatusLine() {
+		if (!m_fStatusLine) {
+			return;
+		}
+
+		char szStatus[128];
+		size_t sLen = 0;
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			sLen += snprintf(szStatus + sLen, sizeof(szStatus) - sLen,
+				"[%lu running, %lu done]",
+				m_vecChannels.size() - m_nClosedChannels,
+				m_nClosedChannels);
+			for (size_t s = 0; s < m_vecChannels.size(); s++) {
+				if (m_vecChannels[s].fd < 0) {
+					continue;
+				}
+				if (sLen >= sizeof(szStatus) - 8) {
+					break;
+				}
+				sLen += snprintf(szStatus + sLen, sizeof(szStatus) - sLen,
+					" %s (%luKB)",
+					m_vecChannels[s].strModuleName.c_str(),
+					m_vecChannels[s].sBytes / 1024);
+			}
+		}
+
+		std::lock_guard<std::mutex> lockconsole(m_mutexConsole);
+		printf("\r\033[K%.79s", szStatus);
+		fflush(stdout);
+	}
+
+protected:
+	///	<summary>
+	///		Mutex protecting console output, shared with the worker pool.
+	///	</summary>
+	std::mutex & m_mutexConsole;
+
+	///	<summary>
+	///		Mutex protecting the channel list.
+	///	</summary>
+	std::mutex m_mutex;
+
+	///	<summary>
+	///		Set when the collector should stop once all channels drain.
+	///	</summary>
+	std::atomic<bool> m_fStop;
+
+	///	<summary>
+	///		Registered channels.  Closed channels have fd -1.
+	///	</summary>
+	std::vector<LogChannel> m_vecChannels;
+
+	///	<summary>
+	///		Number of channels that have reached end of file.
+	///	</summary>
+	size_t m_nClosedChannels;
+
+	///	<summary>
+	///		Set when stdout is a terminal and the status line is shown.
+	///	</summary>
+	bool m_fStatusLine;
+
+	///	<summary>
+	///		Self-pipe used to wake the collector out of poll().
+	///	</summary>
+	int m_iWakePipe[2];
+
+	///	<summary>
+	///		The collector thread.
+	///	</summary>
+	std::thread m_thread;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Compute a topological order of the given commands with respect to
+///		their dependency edges, preserving the input order among commands
+///		with no ordering constraint between them.  Returns false if the
+///		dependency graph contains a cycle.
+///	</summary>
+bool TopologicalSortCommands(
+	const std::vector<ModuleRunCommand> & vecCommands,
+	std::vector<size_t> & vecOrder
+) {
+	vecOrder.clear();
+	vecOrder.reserve(vecCommands.size());
+
+	// Unsatisfied dependency counts and reverse edges
+	std::vector<size_t> vecRemaining(vecCommands.size(), 0);
+	std::vector<std::vector<size_t> > vecDependents(vecCommands.size());
+	for (size_t d = 0; d < vecCommands.size(); d++) {
+		vecRemaining[d] = vecCommands[d].vecDependencies.size();
+		for (size_t e = 0; e < vecCommands[d].vecDependencies.size(); e++) {
+			vecDependents[vecCommands[d].vecDependencies[e]].push_back(d);
+		}
+	}
+
+	for (size_t d = 0; d < vecCommands.size(); d++) {
+		if (vecRemaining[d] == 0) {
+			vecOrder.push_back(d);
+		}
+	}
+	for (size_t q = 0; q < vecOrder.size(); q++) {
+		size_t d = vecOrder[q];
+		for (size_t e = 0; e < vecDependents[d].size(); e++) {
+			if (--vecRemaining[vecDependents[d][e]] == 0) {
+				vecOrder.push_back(vecDependents[d][e]);
+			}
+		}
+	}
+
+	return (vecOrder.size() == vecCommands.size());
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Execute the given module run commands across a pool of worker
+///		threads, respecting the dependency edges recorded in each
+///		command.  A command becomes ready as soon as all of its
+///		dependencies have completed successfully, so independent branches
+///		of the dependency graph overlap; if a dependency fails, its
+///		dependents (direct and transitive) are skipped rather than
+///		launched.  Among ready commands dispatch follows descending
+///		estimated wall time (longest-processing-time-first), with
+///		commands lacking an estimate dispatched before all others so an
+///		unknown long pole cannot be scheduled last.
+///		Each driver's output is captured through a dedicated pipe by the
+///		log collector and written to a "cmec_run.log" file in its working
+///		directory so parallel output doesn't interleave, and each
+///		module's exit status, wall time and peak RSS is recorded in
+///		vecResults.  If nCPUsPerModule is nonzero each worker slot is
+///		pinned to its own contiguous slice of nCPUsPerModule CPUs, which
+///		the spawned drivers inherit, so a multi-threaded driver cannot
+///		migrate across sockets or steal the caches of a concurrently
+///		running sibling.  The dependency graph must be acyclic; callers
+///		are expected to have run TopologicalSortCommands beforehand.
+///	</summary>
+void ExecuteDriversParallel(
+	size_t nConcurrency,
+	const std::vector<ModuleRunCommand> & vecCommands,
+	const filesystem::path & pathObsDir,
+	const filesystem::path & pathModelDir,
+	const std::string & strDataManifest,
+	const std::vector<double> & vecWallTimeEstimates,
+	std::vector<ModuleRunResult> & vecResults,
+	size_t nCPUsPerModule = 0,
+	const DriverResourceLimits & limits = DriverResourceLimits()
+) {
+	_ASSERT(vecWallTimeEstimates.size() == vecCommands.size());
+
+	vecResults.resize(vecCommands.size());
+
+	// Dependency state, guarded by mutexQueue:  remaining dependency
+	// counts, reverse edges, the ready set, and poison marks on commands
+	// whose dependencies have failed
+	std::mutex mutexQueue;
+	std::condition_variable cvQueue;
+
+	std::vector<size_t> vecRemaining(vecCommands.size(), 0);
+	std::vector<std::vector<size_t> > vecDependents(vecCommands.size());
+	std::vector<bool> vecPoisoned(vecCommands.size(), false);
+	std::vector<size_t> vecReady;
+	size_t sFinishedCount = 0;
+
+	for (size_t d = 0; d < vecCommands.size(); d++) {
+		vecRemaining[d] = vecCommands[d].vecDependencies.size();
+		for (size_t e = 0; e < vecCommands[d].vecDependencies.size(); e++) {
+			vecDependents[vecCommands[d].vecDependencies[e]].push_back(d);
+		}
+		if (vecRemaining[d] == 0) {
+			vecReady.push_back(d);
+		}
+	}
+
+	// Among ready commands prefer those with no estimate (negative),
+	// then descending estimated wall time
+	auto SchedulesBefore = [&](size_t a, size_t b) {
+		if ((vecWallTimeEstimates[a] < 0.0) !=
+		    (vecWallTimeEstimates[b] < 0.0)
+		) {
+			return (vecWallTimeEstimates[a] < 0.0);
+		}
+		return (vecWallTimeEstimates[a] > vecWallTimeEstimates[b]);
+	};
+
+	// Number of commands completed
+	std::atomic<size_t> sCompletedCount(0);
+
+	// Mutex protecting console output
+	std::mutex mutexConsole;
+
+	// Log collector, draining every driver's output pipe
+	ModuleLogCollector collector(mutexConsole);
+	collector.Start();
+
+	// Number of online CPUs, for affinity placement
+	long lOnlineCPUs = sysconf(_SC_NPROCESSORS_ONLN);
+	if (lOnlineCPUs < 1) {
+		lOnlineCPUs = 1;
+	}
+
+	// Mark a command finished:  propagate its outcome to dependents,
+	// moving any that became ready onto the ready set, and wake waiting
+	// workers.  A failed or skipped command poisons its dependents.
+	auto FinishCommand = [&](size_t d, bool fSuccess) {
+		std::lock_guard<std::mutex> lock(mutexQueue);
+		sFinishedCount++;
+		for (size_t e = 0; e < vecDependents[d].size(); e++) {
+			size_t dNext = vecDependents[d][e];
+			if (!fSuccess) {
+				vecPoisoned[dNext] = true;
+			}
+			if (--vecRemaining[dNext] == 0) {
+				vecReady.push_back(dNext);
+			}
+		}
+		cvQueue.notify_all();
+	};
+
+	// Worker loop:  Pin this worker slot to its CPU slice (inherited by
+	// every driver it spawns), then pull the best ready command off the
+	// queue and run it with output captured through a pipe to the
+	// module's log file.
+	auto WorkerLoop = [&](size_t w) {
+		if (nCPUsPerModule > 0) {
+			// Contiguous CPU slices keep each driver on one NUMA node
+			// on systems where CPUs are numbered node-contiguously
+			cpu_set_t cpuset;
+			CPU_ZERO(&cpuset);
+			for (size_t c = 0; c < nCPUsPerModule; c++) {
+				CPU_SET(
+					(w * nCPUsPerModule + c)
+						% static_cast<size_t>(lOnlineCPUs),
+					&cpuset);
+			}
+			if (sched_setaffinity(0, sizeof(cpuset), &cpuset) != 0) {
+				std::lock_guard<std::mutex> lock(mutexConsole);
+				collector.ClearStatusLine();
+				printf("WARNING: Unable to set CPU affinity for "
+					"worker %lu (%s)\n",
+					w, strerror(errno));
+			}
+		}
+
+		for (;;) {
+			size_t d;
+			bool fPoisoned;
+			{
+				std::unique_lock<std::mutex> lock(mutexQueue);
+				cvQueue.wait(lock, [&]() {
+					return ((!vecReady.empty()) ||
+					        (sFinishedCount == vecCommands.size()));
+				});
+				if (vecReady.empty()) {
+					break;
+				}
+
+				size_t qBest = 0;
+				for (size_t q = 1; q < vecReady.size(); q++) {
+					if (SchedulesBefore(vecReady[q], vecReady[qBest])) {
+						qBest = q;
+					}
+				}
+				d = vecReady[qBest];
+				vecReady.erase(vecReady.begin() + qBest);
+				fPoisoned = vecPoisoned[d];
+			}
+
+			// A poisoned command is recorded as skipped without being
+			// launched, and poisons its own dependents in turn
+			if (fPoisoned) {
+				vecResults[d].strModuleName = vecCommands[d].strModuleName;
+				vecResults[d].iReturnCode = -1;
+				vecResults[d].dWallTimeSeconds = 0.0;
+				vecResults[d].iMaxRSSKB = 0;
+				vecResults[d].fSkipped = true;
+				vecResults[d].fTimedOut = false;
+
+				{
+					std::lock_guard<std::mutex> lock(mutexConsole);
+					collector.ClearStatusLine();
+					printf("[%lu/%lu] \033[1m%s\033[0m skipped (dependency failed)\n",
+						sCompletedCount.fetch_add(1) + 1,
+						vecCommands.size(),
+						vecCommands[d].strModuleName.c_str());
+				}
+
+				FinishCommand(d, false);
+				continue;
+			}
+
+			filesystem::path pathLog =
+				vecCommands[d].pathWorkingDir / "cmec_run.log";
+
+			vecResults[d].strModuleName = vecCommands[d].strModuleName;
+
+			// Both pipe ends are close-on-exec:  the child only receives
+			// the write end dup2'd onto stdout/stderr, so a concurrently
+			// spawned sibling cannot hold this pipe open past its exit.
+			int iPipeFd[2];
+			if (pipe2(iPipeFd, O_CLOEXEC) != 0) {
+				std::lock_guard<std::mutex> lock(mutexConsole);
+				collector.ClearStatusLine();
+				printf("ERROR: Unable to create log pipe for \"%s\" (%s)\n",
+					vecCommands[d].strModuleName.c_str(),
+					strerror(errno));
+				vecResults[d].iReturnCode = -1;
+				vecResults[d].dWallTimeSeconds = 0.0;
+				vecResults[d].iMaxRSSKB = 0;
+				vecResults[d].fTimedOut = false;
+				FinishCommand(d, false);
+				continue;
+			}
+
+			collector.Register(
+				iPipeFd[0],
+				pathLog.str(),
+				vecCommands[d].strModuleName);
+
+			intmax_t iMaxRSSKB = 0;
+			bool fTimedOut = false;
+			auto timeBegin = std::chrono::steady_clock::now();
+			int iReturn =
+				SpawnDriverScript(
+					vecCommands[d],
+					pathObsDir,
+					pathModelDir,
+					strDataManifest,
+					iPipeFd[1],
+					limits,
+					iMaxRSSKB,
+					fTimedOut);
+			auto timeEnd = std::chrono::steady_clock::now();
+
+			close(iPipeFd[1]);
+
+			vecResults[d].iReturnCode = iReturn;
+			vecResults[d].dWallTimeSeconds =
+				std::chrono::duration<double>(timeEnd - timeBegin).count();
+			vecResults[d].iMaxRSSKB = iMaxRSSKB;
+			vecResults[d].fTimedOut = fTimedOut;
+
+			{
+				std::lock_guard<std::mutex> lock(mutexConsole);
+				collector.ClearStatusLine();
+				printf("[%lu/%lu] \033[1m%s\033[0m %s (%.1fs)\n",
+					sCompletedCount.fetch_add(1) + 1,
+					vecCommands.size(),
+					vecCommands[d].strModuleName.c_str(),
+					(iReturn == 0)?("completed"):
+					(fTimedOut)?("TIMED OUT"):("FAILED"),
+					vecResults[d].dWallTimeSeconds);
+			}
+
+			FinishCommand(d, iReturn == 0);
+		}
+	};
+
+	// Launch workers
+	std::vector<std::thread> vecWorkers;
+	for (size_t w = 0; w < nConcurrency; w++) {
+		vecWorkers.push_back(std::thread(WorkerLoop, w));
+	}
+	for (size_t w = 0; w < vecWorkers.size(); w++) {
+		vecWorkers[w].join();
+	}
+
+	// Drain any remaining buffered output and stop the collector
+	collector.Stop();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Path of the running executable, used to launch remote agents at
+///		the same (shared filesystem) location.  Empty if unavailable.
+///	</summary>
+std::string GetExecutablePath() {
+	char szPath[4096];
+	ssize_t nLength = readlink("/proc/self/exe", szPath, sizeof(szPath)-1);
+	if (nLength <= 0) {
+		return std::string();
+	}
+	szPath[nLength] = '\0';
+	return std::string(szPath);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Execute the given module run commands across multiple hosts.  The
+///		commands are partitioned into connected components of the
+///		dependency graph (so no dependency edge crosses a host) and the
+///		components are packed onto hosts greedily by estimated wall time.
+///		Each host receives a JSON assignment file in the shared working
+///		directory and an agent is launched there over ssh (or directly
+///		for the host "localhost") running this executable's "run-agent"
+///		command; agents execute their shard with the usual worker pool,
+///		leave per-module logs in the shared working directory, and write
+///		a result file that is gathered back into vecResults.  Commands
+///		whose agent produced no result are recorded as failed.
+///	</summary>
+void ExecuteDriversDistributed(
+	const std::vector<std::string> & vecHosts,
+	const std::vector<ModuleRunCommand> & vecCommands,
+	const filesystem::path & pathObsDir,
+	const filesystem::path & pathModelDir,
+	const std::string & strDataManifest,
+	const filesystem::path & pathWorkingDir,
+	const std::vector<double> & vecWallTimeEstimates,
+	std::vector<ModuleRunResult> & vecResults,
+	size_t nConcurrency,
+	size_t nCPUsPerModule,
+	const DriverResourceLimits & limits
+) {
+	_ASSERT(vecHosts.size() != 0);
+	_ASSERT(vecWallTimeEstimates.size() == vecCommands.size());
+
+	vecResults.resize(vecCommands.size());
+	for (size_t d = 0; d < vecCommands.size(); d++) {
+		vecResults[d].strModuleName = vecCommands[d].strModuleName;
+		vecResults[d].iReturnCode = -1;
+		vecResults[d].dWallTimeSeconds = 0.0;
+		vecResults[d].iMaxRSSKB = 0;
+		vecResults[d].fSkipped = false;
+		vecResults[d].fTimedOut = false;
+	}
+
+	std::string strExecutablePath = GetExecutablePath();
+	if (strExecutablePath.length() == 0) {
+		printf("ERROR: Unable to determine executable path for "
+			"remote agents\n");
+		return;
+	}
+
+	// Group commands into connected components of the dependency graph
+	// so every dependency edge stays within one host
+	std::vector<size_t> vecComponent(vecCommands.size());
+	for (size_t d = 0; d < vecCommands.size(); d++) {
+		vecComponent[d] = d;
+	}
+	std::function<size_t(size_t)> FindRoot = [&](size_t d) -> size_t {
+		while (vecComponent[d] != d) {
+			vecComponent[d] = vecComponent[vecComponent[d]];
+			d = vecComponent[d];
+		}
+		return d;
+	};
+	for (size_t d = 0; d < vecCommands.size(); d++) {
+		for (size_t e = 0; e < vecCommands[d].vecDependencies.size(); e++) {
+			vecComponent[FindRoot(d)] =
+				FindRoot(vecCommands[d].vecDependencies[e]);
+		}
+	}
+
+	std::map<size_t, std::vector<size_t> > mapComponents;
+	for (size_t d = 0; d < vecCommands.size(); d++) {
+		mapComponents[FindRoot(d)].push_back(d);
+	}
+
+	// Pack components onto hosts greedily by total estimated wall time,
+	// largest first, with components containing an unestimated command
+	// placed before all others
+	struct ComponentLoad {
+		std::vector<size_t> vecMembers;
+		double dTotalEstimate;
+		bool fUnknown;
+	};
+	std::vector<ComponentLoad> vecComponents;
+	for (auto itcomp = mapComponents.begin(); itcomp != mapComponents.end(); itcomp++) {
+		ComponentLoad load;
+		load.vecMembers = itcomp->second;
+		load.dTotalEstimate = 0.0;
+		load.fUnknown = false;
+		for (size_t s = 0; s < load.vecMembers.size(); s++) {
+			double dEstimate = vecWallTimeEstimates[load.vecMembers[s]];
+			if (dEstimate < 0.0) {
+				load.fUnknown = true;
+			} else {
+				load.dTotalEstimate += dEstimate;
+			}
+		}
+		vecComponents.push_back(load);
+	}
+	std::stable_sort(vecComponents.begin(), vecComponents.end(),
+		[](const ComponentLoad & a, const ComponentLoad & b) {
+			if (a.fUnknown != b.fUnknown) {
+				return a.fUnknown;
+			}
+			return (a.dTotalEstimate > b.dTotalEstimate);
+		});
+
+	std::vector<std::vector<size_t> > vecHostCommands(vecHosts.size());
+	std::vector<double> vecHostLoad(vecHosts.size(), 0.0);
+	for (size_t s = 0; s < vecComponents.size(); s++) {
+		size_t hBest = 0;
+		for (size_t h = 1; h < vecHosts.size(); h++) {
+			if (vecHostLoad[h] < vecHostLoad[hBest]) {
+				hBest = h;
+			}
+		}
+		for (size_t m = 0; m < vecComponents[s].vecMembers.size(); m++) {
+			vecHostCommands[hBest].push_back(
+				vecComponents[s].vecMembers[m]);
+		}
+		vecHostLoad[hBest] += vecComponents[s].dTotalEstimate;
+	}
+
+	// Write each host's assignment file and launch its agent, with the
+	// agent's console output captured to a per-host log in the shared
+	// working directory
+	struct AgentLaunch {
+		pid_t pid;
+		filesystem::path pathResult;
+		std::vector<size_t> vecAssigned;
+	};
+	std::vector<AgentLaunch> vecAgents;
+
+	for (size_t h = 0; h < vecHosts.size(); h++) {
+		if (vecHostCommands[h].size() == 0) {
+			continue;
+		}
+
+		char szFileName[128];
+		snprintf(szFileName, sizeof(szFileName),
+			".cmec_agent_%lu.assignment.json",
+			static_cast<unsigned long>(h));
+		filesystem::path pathAssignment =
+			pathWorkingDir / filesystem::path(szFileName);
+
+		snprintf(szFileName, sizeof(szFileName),
+			".cmec_agent_%lu.result.json",
+			static_cast<unsigned long>(h));
+		filesystem::path pathResult =
+			pathWorkingDir / filesystem::path(szFileName);
+
+		snprintf(szFileName, sizeof(szFileName),
+			".cmec_agent_%lu.log",
+			static_cast<unsigned long>(h));
+		filesystem::path pathAgentLog =
+			pathWorkingDir / filesystem::path(szFileName);
+
+		// Dependency indices are remapped into the shard's local order
+		std::map<size_t, size_t> mapLocalIndex;
+		for (size_t s = 0; s < vecHostCommands[h].size(); s++) {
+			mapLocalIndex.insert(
+				std::pair<size_t, size_t>(vecHostCommands[h][s], s));
+		}
+
+		nlohmann::json jassignment;
+		jassignment["obs_dir"] = pathObsDir.str();
+		jassignment["model_dir"] = pathModelDir.str();
+		jassignment["data_manifest"] = strDataManifest;
+		jassignment["result"] = pathResult.str();
+		jassignment["concurrency"] = nConcurrency;
+		jassignment["cpus_per_module"] = nCPUsPerModule;
+		jassignment["timeout"] = limits.dTimeoutSeconds;
+		jassignment["max_memory_mb"] = limits.iMaxMemoryMB;
+		jassignment["max_cpu_seconds"] = limits.iMaxCPUSeconds;
+
+		nlohmann::json jcommands = nlohmann::json::value_t::array;
+		for (size_t s = 0; s < vecHostCommands[h].size(); s++) {
+			const ModuleRunCommand & cmd =
+				vecCommands[vecHostCommands[h][s]];
+			nlohmann::json jcmd;
+			jcmd["driver"] = cmd.pathDriverScript.str();
+			jcmd["code_dir"] = cmd.pathCodeDir.str();
+			jcmd["working_dir"] = cmd.pathWorkingDir.str();
+			jcmd["module_name"] = cmd.strModuleName;
+			nlohmann::json jdeps = nlohmann::json::value_t::array;
+			for (size_t e = 0; e < cmd.vecDependencies.size(); e++) {
+				auto itlocal = mapLocalIndex.find(cmd.vecDependencies[e]);
+				_ASSERT(itlocal != mapLocalIndex.end());
+				jdeps.push_back(itlocal->second);
+			}
+			jcmd["dependencies"] = jdeps;
+			jcommands.push_back(jcmd);
+		}
+		jassignment["commands"] = jcommands;
+
+		{
+			std::ofstream ofassignment(pathAssignment.str());
+			if (!ofassignment.is_open()) {
+				printf("ERROR: Unable to write assignment file \"%s\"\n",
+					pathAssignment.str().c_str());
+				return;
+			}
+			ofassignment << jassignment.dump(4) << std::endl;
+		}
+
+		// Stale result files must not be mistaken for this run's
+		unlink(pathResult.str().c_str());
+
+		// Assemble the agent command line:  remote hosts are reached
+		// over ssh at the same executable path, which assumes the usual
+		// shared filesystem layout; "localhost" runs the agent directly
+		std::vector<std::string> vecArgs;
+		if (vecHosts[h] != "localhost") {
+			vecArgs.push_back("ssh");
+			vecArgs.push_back("-o");
+			vecArgs.push_back("BatchMode=yes");
+			vecArgs.push_back(vecHosts[h]);
+		}
+		vecArgs.push_back(strExecutablePath);
+		vecArgs.push_back("run-agent");
+		vecArgs.push_back(pathAssignment.str());
+
+		std::vector<char *> vecArgv;
+		for (size_t i = 0; i < vecArgs.size(); i++) {
+			vecArgv.push_back(const_cast<char *>(vecArgs[i].c_str()));
+		}
+		vecArgv.push_back(NULL);
+
+		int fdLog =
+			open(pathAgentLog.str().c_str(),
+				O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+
+		posix_spawn_file_actions_t fileactions;
+		posix_spawn_file_actions_init(&fileactions);
+		if (fdLog >= 0) {
+			posix_spawn_file_actions_adddup2(
+				&fileactions, fdLog, STDOUT_FILENO);
+			posix_spawn_file_actions_adddup2(
+				&fileactions, STDOUT_FILENO, STDERR_FILENO);
+		}
+
+		AgentLaunch launch;
+		launch.pathResult = pathResult;
+		launch.vecAssigned = vecHostCommands[h];
+
+		int iError =
+			posix_spawnp(
+				&(launch.pid),
+				vecArgv[0],
+				&fileactions,
+				NULL,
+				&(vecArgv[0]),
+				environ);
+
+		posix_spawn_file_actions_destroy(&fileactions);
+		if (fdLog >= 0) {
+			close(fdLog);
+		}
+
+		if (iError != 0) {
+			printf("ERROR: Unable to launch agent on host \"%s\" (%s)\n",
+				vecHosts[h].c_str(),
+				strerror(iError));
+			continue;
+		}
+
+		printf("Dispatched %lu module(s) to host \"%s\"\n",
+			static_cast<unsigned long>(vecHostCommands[h].size()),
+			vecHosts[h].c_str());
+
+		vecAgents.push_back(launch);
+	}
+
+	// Wait for every agent and gather its results.  Modules missing
+	// from a result file retain their failure marks.
+	std::map<std::string, size_t> mapModuleIndex;
+	for (size_t d = 0; d < vecCommands.size(); d++) {
+		mapModuleIndex.insert(
+			std::pair<std::string, size_t>(
+				vecCommands[d].strModuleName, d));
+	}
+
+	for (size_t a = 0; a < vecAgents.size(); a++) {
+		int iStatus = 0;
+		waitpid(vecAgents[a].pid, &iStatus, 0);
+
+		nlohmann::json jresult;
+		{
+			std::ifstream ifresult(vecAgents[a].pathResult.str());
+			if (!ifresult.is_open()) {
+				printf("WARNING: Agent result file \"%s\" is missing; "
+					"its %lu module(s) are recorded as failed\n",
+					vecAgents[a].pathResult.str().c_str(),
+					static_cast<unsigned long>(
+						vecAgents[a].vecAssigned.size()));
+				continue;
+			}
+			try {
+				jresult = nlohmann::json::parse(ifresult);
+			} catch (nlohmann::json::parse_error & e) {
+				printf("WARNING: Malformed agent result file \"%s\": %s\n",
+					vecAgents[a].pathResult.str().c_str(),
+					e.what());
+				continue;
+			}
+		}
+
+		const nlohmann::json & jresults = jresult["results"];
+		for (auto itres = jresults.begin(); itres != jresults.end(); itres++) {
+			auto itmodule = mapModuleIndex.find(
+				(*itres)["module_name"].get<std::string>());
+			if (itmodule == mapModuleIndex.end()) {
+				continue;
+			}
+			ModuleRunResult & result = vecResults[itmodule->second];
+			result.iReturnCode = (*itres)["return_code"].get<int>();
+			result.dWallTimeSeconds = (*itres)["wall_time"].get<double>();
+			result.iMaxRSSKB = (*itres)["max_rss_kb"].get<intmax_t>();
+			result.fSkipped = (*itres)["skipped"].get<bool>();
+			result.fTimedOut = (*itres)["timed_out"].get<bool>();
+
+			printf("\033[1m%s\033[0m %s (%.1fs)\n",
+				result.strModuleName.c_str(),
+				(result.fSkipped)?("skipped (dependency failed)"):
+				(result.iReturnCode == 0)?("completed"):
+				(result.fTimedOut)?("TIMED OUT"):("FAILED"),
+				result.dWallTimeSeconds);
+		}
+
+		unlink(vecAgents[a].pathResult.str().c_str());
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Execute one host's shard of a distributed run, as written by
+///		ExecuteDriversDistributed:  read the assignment file, run its
+///		commands with the usual worker pool, and write the result file
+///		the head invocation gathers.  Returns nonzero only if the
+///		assignment itself cannot be processed; module failures are
+///		conveyed through the result file.
+///	</summary>
+int cmec_run_agent(
+	const std::string & strAssignmentFile
+) {
+	nlohmann::json jassignment;
+	{
+		std::ifstream ifassignment(strAssignmentFile);
+		if (!ifassignment.is_open()) {
+			printf("ERROR: Unable to open assignment file \"%s\"\n",
+				strAssignmentFile.c_str());
+			return (-1);
+		}
+		try {
+			jassignment = nlohmann::json::parse(ifassignment);
+		} catch (nlohmann::json::parse_error & e) {
+			printf("ERROR: Malformed assignment file \"%s\": %s\n",
+				strAssignmentFile.c_str(),
+				e.what());
+			return (-1);
+		}
+	}
+
+	filesystem::path pathObsDir(
+		jassignment["obs_dir"].get<std::string>());
+	filesystem::path pathModelDir(
+		jassignment["model_dir"].get<std::string>());
+	std::string strDataManifest =
+		jassignment["data_manifest"].get<std::string>();
+	filesystem::path pathResult(
+		jassignment["result"].get<std::string>());
+	size_t nConcurrency = jassignment["concurrency"].get<size_t>();
+	size_t nCPUsPerModule = jassignment["cpus_per_module"].get<size_t>();
+
+	DriverResourceLimits limits;
+	limits.dTimeoutSeconds = jassignment["timeout"].get<double>();
+	limits.iMaxMemoryMB = jassignment["max_memory_mb"].get<intmax_t>();
+	limits.iMaxCPUSeconds = jassignment["max_cpu_seconds"].get<intmax_t>();
+
+	std::vector<ModuleRunCommand> vecCommands;
+	const nlohmann::json & jcommands = jassignment["commands"];
+	for (auto itcmd = jcommands.begin(); itcmd != jcommands.end(); itcmd++) {
+		ModuleRunCommand cmd;
+		cmd.pathDriverScript =
+			filesystem::path((*itcmd)["driver"].get<std::string>());
+		cmd.pathCodeDir =
+			filesystem::path((*itcmd)["code_dir"].get<std::string>());
+		cmd.pathWorkingDir =
+			filesystem::path((*itcmd)["working_dir"].get<std::string>());
+		cmd.strModuleName = (*itcmd)["module_name"].get<std::string>();
+		const nlohmann::json & jdeps = (*itcmd)["dependencies"];
+		for (auto itdep = jdeps.begin(); itdep != jdeps.end(); itdep++) {
+			cmd.vecDependencies.push_back(itdep->get<size_t>());
+		}
+		vecCommands.push_back(cmd);
+	}
+
+	std::vector<size_t> vecTopoOrder;
+	if (!TopologicalSortCommands(vecCommands, vecTopoOrder)) {
+		printf("ERROR: Assignment dependencies form a cycle\n");
+		return (-1);
+	}
+
+	if (nConcurrency < 1) {
+		nConcurrency = 1;
+	}
+
+	// Estimates are not re-derived on the agent; within a shard the
+	// dispatch order has already been constrained by the head node's
+	// packing
+	std::vector<double> vecWallTimeEstimates(vecCommands.size(), -1.0);
+	std::vector<ModuleRunResult> vecResults;
+
+	printf("Executing %lu assigned module(s) (%lu workers)\n",
+		static_cast<unsigned long>(vecCommands.size()),
+		static_cast<unsigned long>(nConcurrency));
+
+	ExecuteDriversParallel(
+		nConcurrency,
+		vecCommands,
+		pathObsDir,
+		pathModelDir,
+		strDataManifest,
+		vecWallTimeEstimates,
+		vecResults,
+		nCPUsPerModule,
+		limits);
+
+	nlohmann::json jresult;
+	nlohmann::json jresults = nlohmann::json::value_t::array;
+	for (size_t d = 0; d < vecResults.size(); d++) {
+		nlohmann::json jentry;
+		jentry["module_name"] = vecResults[d].strModuleName;
+		jentry["return_code"] = vecResults[d].iReturnCode;
+		jentry["wall_time"] = vecResults[d].dWallTimeSeconds;
+		jentry["max_rss_kb"] = vecResults[d].iMaxRSSKB;
+		jentry["skipped"] = vecResults[d].fSkipped;
+		jentry["timed_out"] = vecResults[d].fTimedOut;
+		jresults.push_back(jentry);
+	}
+	jresult["results"] = jresults;
+
+	std::ofstream ofresult(pathResult.str());
+	if (!ofresult.is_open()) {
+		printf("ERROR: Unable to write result file \"%s\"\n",
+			pathResult.str().c_str());
+		return (-1);
+	}
+	ofresult << jresult.dump(4) << std::endl;
+
+	return 0;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Mix the given bytes into a FNV-1a hash.
+///	</summary>
+void HashManifestBytes(
+	const void * pData,
+	size_t sBytes,
+	uint64_t & uHash
+) {
+	const unsigned char * p = reinterpret_cast<const unsigned char *>(pData);
+	for (size_t s = 0; s < sBytes; s++) {
+		uHash ^= static_cast<uint64_t>(p[s]);
+		uHash *= 1099511628211ULL;
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		One entry of a data directory manifest.
+///	</summary>
+struct DataManifestEntry {
+
+	///	<summary>
+	///		Path of the entry relative to the scanned root.
+	///	</summary>
+	std::string strRelative;
+
+	///	<summary>
+	///		Modification time of the entry (zero if unavailable).
+	///	</summary>
+	intmax_t iMTime;
+
+	///	<summary>
+	///		Size of the entry in bytes (zero if unavailable).
+	///	</summary>
+	intmax_t iSize;
+
+	///	<summary>
+	///		Set if the entry is a directory.
+	///	</summary>
+	bool fDirectory;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Order manifest entries by relative path with the path separator
+///		ranked below every other character, so a directory's own entry
+///		immediately precedes its contents.  This reproduces the
+///		depth-first, per-directory-sorted traversal order of the serial
+///		scan this replaced, keeping manifest hashes (and hence recorded
+///		fingerprints) stable.
+///	</summary>
+bool DataManifestEntryOrder(
+	const DataManifestEntry & a,
+	const DataManifestEntry & b
+) {
+	const std::string & strA = a.strRelative;
+	const std::string & strB = b.strRelative;
+	size_t sLength = (strA.length() < strB.length())
+		? strA.length() : strB.length();
+	for (size_t s = 0; s < sLength; s++) {
+		unsigned char cA = (strA[s] == '/') ? 0 : strA[s];
+		unsigned char cB = (strB[s] == '/') ? 0 : strB[s];
+		if (cA != cB) {
+			return (cA < cB);
+		}
+	}
+	return (strA.length() < strB.length());
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Scan the given directory tree into a sorted manifest, stat'ing
+///		every entry.  Directories discovered during the scan are pulled
+///		off a shared queue by a pool of workers so independent subtrees
+///		are walked concurrently; on network filesystems this overlaps the
+///		per-entry metadata latency.
+///	</summary>
+void ScanDirectoryManifest(
+	const filesystem::path & pathRoot,
+	std::vector<DataManifestEntry> & vecEntries
+) {
+	vecEntries.clear();
+
+	// Relative prefixes of directories awaiting a scan, guarded together
+	// with the in-flight count by mutexWork
+	std::mutex mutexWork;
+	std::condition_variable cvWork;
+	std::vector<std::string> vecPending;
+	size_t nInFlight = 0;
+	std::string strErrorPath;
+
+	// Collected entries, guarded by mutexEntries
+	std::mutex mutexEntries;
+
+	vecPending.push_back("");
+
+	auto WorkerLoop = [&]() {
+		for (;;) {
+			std::string strPrefix;
+			{
+				std::unique_lock<std::mutex> lock(mutexWork);
+				cvWork.wait(lock, [&]() {
+					return (!vecPending.empty() || (nInFlight == 0));
+				});
+				if (vecPending.empty()) {
+					break;
+				}
+				strPrefix = vecPending.back();
+				vecPending.pop_back();
+				nInFlight++;
+			}
+
+			filesystem::path pathDir = pathRoot;
+			if (strPrefix.length() != 0) {
+				pathDir = pathRoot / filesystem::path(strPrefix);
+			}
+
+			DIR * pDir = opendir(pathDir.str().c_str());
+			if (pDir == NULL) {
+				{
+					std::lock_guard<std::mutex> lock(mutexWork);
+					if (strErrorPath.length() == 0) {
+						strErrorPath = pathDir.str();
+					}
+					nInFlight--;
+				}
+				cvWork.notify_all();
+				continue;
+			}
+
+			std::vector<DataManifestEntry> vecLocal;
+			std::vector<std::string> vecSubdirs;
+
+			struct dirent * pDirent;
+			while ((pDirent = readdir(pDir)) != NULL) {
+				std::string strName(pDirent->d_name);
+				if ((strName == ".") || (strName == "..")) {
+					continue;
+				}
+
+				filesystem::path pathEntry =
+					pathDir / filesystem::path(strName);
+
+				DataManifestEntry entry;
+				entry.strRelative = strPrefix + strName;
+				entry.iMTime = 0;
+				entry.iSize = 0;
+				CMECValidationCache::GetFileStamp(
+					pathEntry, entry.iMTime, entry.iSize);
+				entry.fDirectory = pathEntry.is_directory();
+
+				if (entry.fDirectory) {
+					vecSubdirs.push_back(entry.strRelative + "/");
+				}
+				vecLocal.push_back(entry);
+			}
+			closedir(pDir);
+
+			{
+				std::lock_guard<std::mutex> lock(mutexEntries);
+				for (size_t s = 0; s < vecLocal.size(); s++) {
+					vecEntries.push_back(vecLocal[s]);
+				}
+			}
+			{
+				std::lock_guard<std::mutex> lock(mutexWork);
+				for (size_t s = 0; s < vecSubdirs.size(); s++) {
+					vecPending.push_back(vecSubdirs[s]);
+				}
+				nInFlight--;
+			}
+			cvWork.notify_all();
+		}
+	};
+
+	size_t nWorkers = std::thread::hardware_concurrency();
+	if (nWorkers == 0) {
+		nWorkers = 1;
+	}
+	if (nWorkers > 8) {
+		nWorkers = 8;
+	}
+
+	if (nWorkers <= 1) {
+		WorkerLoop();
+
+	} else {
+		std::vector<std::thread> vecWorkers;
+		for (size_t w = 0; w < nWorkers; w++) {
+			vecWorkers.push_back(std::thread(WorkerLoop));
+		}
+		for (size_t w = 0; w < vecWorkers.size(); w++) {
+			vecWorkers[w].join();
+		}
+	}
+
+	if (strErrorPath.length() != 0) {
+		_EXCEPTION1("Unable to open directory \"%s\"",
+			strErrorPath.c_str());
+	}
+
+	std::sort(vecEntries.begin(), vecEntries.end(), DataManifestEntryOrder);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Compute the manifest hash of a sorted manifest.
+///	</summary>
+uint64_t HashManifestEntries(
+	const std::vector<DataManifestEntry> & vecEntries
+) {
+	// FNV-1a offset basis
+	uint64_t uHash = 14695981039346656037ULL;
+	for (size_t s = 0; s < vecEntries.size(); s++) {
+		HashManifestBytes(
+			vecEntries[s].strRelative.c_str(),
+			vecEntries[s].strRelative.length(),
+			uHash);
+		HashManifestBytes(
+			&(vecEntries[s].iMTime), sizeof(vecEntries[s].iMTime), uHash);
+		HashManifestBytes(
+			&(vecEntries[s].iSize), sizeof(vecEntries[s].iSize), uHash);
+	}
+	return uHash;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Write the indexed data manifest in CBOR, listing every file of
+///		the observational and model data directories as a (path, size,
+///		mtime) triple relative to the recorded roots.  Returns false and
+///		reports a warning if the manifest cannot be written; the run
+///		itself proceeds, with modules falling back to their own
+///		traversal.
+///	</summary>
+bool WriteDataManifest(
+	const filesystem::path & pathManifest,
+	const filesystem::path & pathObsDir,
+	const filesystem::path & pathModelDir,
+	const std::vector<DataManifestEntry> & vecObsEntries,
+	const std::vector<DataManifestEntry> & vecModelEntries
+) {
+	nlohmann::json jmanifest;
+	jmanifest["version"] = 1;
+	jmanifest["obs_root"] = pathObsDir.str();
+	jmanifest["model_root"] = pathModelDir.str();
+
+	nlohmann::json jobs = nlohmann::json::value_t::array;
+	for (size_t s = 0; s < vecObsEntries.size(); s++) {
+		if (vecObsEntries[s].fDirectory) {
+			continue;
+		}
+		nlohmann::json jentry = nlohmann::json::value_t::array;
+		jentry.push_back(vecObsEntries[s].strRelative);
+		jentry.push_back(vecObsEntries[s].iSize);
+		jentry.push_back(vecObsEntries[s].iMTime);
+		jobs.push_back(jentry);
+	}
+	jmanifest["obs"] = jobs;
+
+	nlohmann::json jmodel = nlohmann::json::value_t::array;
+	for (size_t s = 0; s < vecModelEntries.size(); s++) {
+		if (vecModelEntries[s].fDirectory) {
+			continue;
+		}
+		nlohmann::json jentry = nlohmann::json::value_t::array;
+		jentry.push_back(vecModelEntries[s].strRelative);
+		jentry.push_back(vecModelEntries[s].iSize);
+		jentry.push_back(vecModelEntries[s].iMTime);
+		jmodel.push_back(jentry);
+	}
+	jmanifest["model"] = jmodel;
+
+	std::vector<uint8_t> vecCBOR = nlohmann::json::to_cbor(jmanifest);
+
+	std::ofstream ofmanifest(
+		pathManifest.str(), std::ios::out | std::ios::binary);
+	if (!ofmanifest.is_open()) {
+		printf("WARNING: Unable to write data manifest \"%s\"\n",
+			pathManifest.str().c_str());
+		return false;
+	}
+	ofmanifest.write(
+		reinterpret_cast<const char *>(&(vecCBOR[0])), vecCBOR.size());
+	return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Build the input fingerprint for one module configuration,
+///		combining stamps of the driver script and settings file with the
+///		manifest hashes of the observational and model data directories.
+///	</summary>
+nlohmann::json BuildRunFingerprint(
+	const filesystem::path & pathDriverScript,
+	const filesystem::path & pathSettings,
+	uint64_t uObsManifest,
+	uint64_t uModelManifest
+) {
+	nlohmann::json jfp;
+
+	intmax_t iMTime = 0;
+	intmax_t iSize = 0;
+
+	if (!CMECValidationCache::GetFileStamp(pathDriverScript, iMTime, iSize)) {
+		iMTime = -1;
+		iSize = -1;
+	}
+	jfp["driver"]["path"] = pathDriverScript.str();
+	jfp["driver"]["mtime"] = iMTime;
+	jfp["driver"]["size"] = iSize;
+
+	if (!CMECValidationCache::GetFileStamp(pathSettings, iMTime, iSize)) {
+		iMTime = -1;
+		iSize = -1;
+	}
+	jfp["settings"]["path"] = pathSettings.str();
+	jfp["settings"]["mtime"] = iMTime;
+	jfp["settings"]["size"] = iSize;
+
+	jfp["obs_manifest"] = uObsManifest;
+	jfp["model_manifest"] = uModelManifest;
+
+	return jfp;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Issue readahead for the metadata files of the given module paths
+///		so the strictly sequential resolution pass that follows finds
+///		them in page cache rather than paying one cold open per file
+///		(a full network round trip apiece on NFS).  Each worker opens
+///		the module's settings.json and contents.json and advises them
+///		with posix_fadvise(POSIX_FADV_WILLNEED), then parses
+///		contents.json just far enough to advise every referenced
+///		settings file as well.  Purely advisory:  all errors are ignored
+///		here and surface in the resolution pass proper.
+///	</summary>
+void WarmModuleMetadata(
+	const std::vector<filesystem::path> & vecModulePaths
+) {
+	if (vecModulePaths.size() == 0) {
+		return;
+	}
+
+	auto WarmFile = [](const filesystem::path & path) {
+		int fd = open(path.str().c_str(), O_RDONLY | O_CLOEXEC);
+		if (fd < 0) {
+			return;
+		}
+		posix_fadvise(fd, 0, 0, POSIX_FADV_WILLNEED);
+		close(fd);
+	};
+
+	std::atomic<size_t> sNextModule(0);
+
+	auto WarmLoop = [&]() {
+		for (;;) {
+			size_t m = sNextModule.fetch_add(1);
+			if (m >= vecModulePaths.size()) {
+				break;
+			}
+
+			WarmFile(
+				vecModulePaths[m]
+				/ filesystem::path(g_szCMECSettingsName));
+
+			filesystem::path pathContents =
+				vecModulePaths[m] / filesystem::path(g_szCMECTOCName);
+			WarmFile(pathContents);
+
+			// Reading the contents file here both pulls it into page
+			// cache and names the per-configuration settings files,
+			// which are the bulk of the small-file opens
+			try {
+				CompressedInputFile filein(pathContents.str());
+				nlohmann::json jcmec =
+					nlohmann::json::parse(filein.begin(), filein.end());
+				auto itcontents = jcmec.find("contents");
+				if ((itcontents == jcmec.end()) ||
+				    (!itcontents->is_array())
+				) {
+					continue;
+				}
+				for (auto itconfig = itcontents->begin();
+				     itconfig != itcontents->end(); itconfig++
+				) {
+					if (itconfig->is_string()) {
+						WarmFile(
+							vecModulePaths[m]
+							/ std::string(*itconfig));
+					}
+				}
+			} catch (...) {
+			}
+		}
+	};
+
+	size_t nWorkers =
+		static_cast<size_t>(std::thread::hardware_concurrency());
+	if (nWorkers < 1) {
+		nWorkers = 1;
+	}
+	if (nWorkers > 8) {
+		nWorkers = 8;
+	}
+	if (nWorkers > vecModulePaths.size()) {
+		nWorkers = vecModulePaths.size();
+	}
+
+	std::vector<std::thread> vecWorkers;
+	for (size_t w = 0; w < nWorkers; w++) {
+		vecWorkers.push_back(std::thread(WarmLoop));
+	}
+	for (size_t w = 0; w < vecWorkers.size(); w++) {
+		vecWorkers[w].join();
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Run the specified module.
+///	</summary>
+int cmec_run(
+	std::string strObsDir,
+	std::string strModelDir,
+	std::string strWorkingDir,
+	const std::vector<std::string> & vecModules,
+	size_t nConcurrency = 1,
+	bool fForce = false,
+	size_t nCPUsPerModule = 0,
+	const std::string & strHosts = std::string(),
+	bool fNoClobber = false,
+	const DriverResourceLimits & limits = DriverResourceLimits()
+) {
+	bool fSuccess;
+
+	// Verify existence of each directory
+	if (strObsDir.length() == 0) {
+		printf("ERROR: Observational data path not specified\n");
+		return (-1);
+	}
+	if ((strObsDir[0] != '/') && (strObsDir[0] != '\\')) {
+		strObsDir = std::string("./") + strObsDir;
+	}
+	filesystem::path pathObsDir(strObsDir);
+	if (!pathObsDir.exists()) {
+		printf("ERROR: Cannot access path \"%s\"\n", strObsDir.c_str());
+		return (-1);
+	}
+	pathObsDir = pathObsDir.make_absolute();
+	if (!pathObsDir.is_directory()) {
+		printf("ERROR: \"%s\" is not a directory\n", strObsDir.c_str());
+		return (-1);
+	}
 
-		strName = cmecsettings.GetName();
+	if (strModelDir.length() == 0) {
+		printf("ERROR: Model data path not specified\n");
+		return (-1);
+	}
+	if ((strModelDir[0] != '/') && (strModelDir[0] != '\\')) {
+		strModelDir = std::string("./") + strModelDir;
+	}
+	filesystem::path pathModelDir(strModelDir);
+	if (!pathModelDir.exists()) {
+		printf("ERROR: Cannot access path \"%s\"\n", strModelDir.c_str());
+		return (-1);
+	}
+	pathModelDir = pathModelDir.make_absolute();
+	if (!pathModelDir.is_directory()) {
+		printf("ERROR: \"%s\" is not a directory\n", strModelDir.c_str());
+		return (-1);
+	}
+
+	if (strWorkingDir.length() == 0) {
+		printf("ERROR: Working data path not specified\n");
+		return (-1);
+	}
+	if ((strWorkingDir[0] != '/') && (strWorkingDir[0] != '\\')) {
+		strWorkingDir = std::string("./") + strWorkingDir;
+	}
+	filesystem::path pathWorkingDir(strWorkingDir);
+	if (!pathWorkingDir.exists()) {
+		printf("ERROR: Cannot access path \"%s\"\n", strWorkingDir.c_str());
+		return (-1);
+	}
+	pathWorkingDir = pathWorkingDir.make_absolute();
+	if (!pathWorkingDir.is_directory()) {
+		printf("ERROR: \"%s\" is not a directory\n", strWorkingDir.c_str());
+		return (-1);
+	}
+
+	// Resolved driver lists.  Paths are interned so configurations of
+	// the same module share one stored copy of the module prefix.
+	PathInternPool pathpool;
+	std::vector<PathInternPool::Handle> vecModulePaths;
+	std::vector<PathInternPool::Handle> vecDriverScripts;
+	std::vector<PathInternPool::Handle> vecWorkingDirs;
+	std::vector<PathInternPool::Handle> vecSettingsPaths;
+	std::vector<std::vector<std::string> > vecDependencyNames;
+
+	// Check the resolved run plan cache.  The key is the module argument
+	// list; a hit whose recorded file stamps all still match restores the
+	// driver lists directly, skipping the library read and per-module
+	// resolution below.
+	std::string strPlanKey;
+	for (int m = 0; m < vecModules.size(); m++) {
+		strPlanKey += vecModules[m];
+		strPlanKey += '\n';
+	}
+
+	CMECRunPlanCache plancache;
+	nlohmann::json jplan;
+
+	g_Profiler.StartPhase("plan/lookup");
+	bool fCachedPlan = plancache.LookupPlan(strPlanKey, jplan);
+	g_Profiler.EndPhase();
+
+	// Plans recorded before dependency metadata existed lack the
+	// per-driver dependency list; treat them as misses so the plan is
+	// resolved and recorded once in the current format
+	if (fCachedPlan) {
+		const nlohmann::json & jdrivers = jplan["drivers"];
+		for (auto itdriver = jdrivers.begin(); itdriver != jdrivers.end(); itdriver++) {
+			if (itdriver->find("dependencies") == itdriver->end()) {
+				fCachedPlan = false;
+				break;
+			}
+		}
+	}
+
+	if (fCachedPlan) {
+		printf("Using cached run plan\n");
+		const nlohmann::json & jdrivers = jplan["drivers"];
+		for (auto itdriver = jdrivers.begin(); itdriver != jdrivers.end(); itdriver++) {
+			vecModulePaths.push_back(
+				pathpool.Intern((*itdriver)["module"].get<std::string>()));
+			vecDriverScripts.push_back(
+				pathpool.Intern((*itdriver)["driver"].get<std::string>()));
+			vecWorkingDirs.push_back(
+				pathpool.Intern((*itdriver)["working_dir"].get<std::string>()));
+			vecSettingsPaths.push_back(
+				pathpool.Intern((*itdriver)["settings"].get<std::string>()));
+
+			std::vector<std::string> vecDeps;
+			const nlohmann::json & jdeps = (*itdriver)["dependencies"];
+			for (auto itdep = jdeps.begin(); itdep != jdeps.end(); itdep++) {
+				vecDeps.push_back(itdep->get<std::string>());
+			}
+			vecDependencyNames.push_back(vecDeps);
+		}
+
+	} else {
+
+		// Load the CMEC library, resolving only the requested modules
+		printf("Reading CMEC library\n");
+		g_Profiler.StartPhase("library/read");
+		CMECLibrary lib;
+		lib.ReadLazy();
+		g_Profiler.EndPhase();
+
+		// Warm the metadata files of every requested module in one
+		// parallel batch before resolution walks them sequentially.
+		// Module names that fail to resolve are simply not warmed; the
+		// resolution pass below reports them.
+		g_Profiler.StartPhase("drivers/warmup");
+		{
+			std::vector<filesystem::path> vecWarmPaths;
+			std::vector<STLStringHelper::StringView> vecWarmTokens;
+			for (int m = 0; m < vecModules.size(); m++) {
+				STLStringHelper::Split(vecModules[m], '/', vecWarmTokens);
+				if (vecWarmTokens.size() == 0) {
+					continue;
+				}
+				filesystem::path pathModule;
+				if (lib.FindModulePath(
+					vecWarmTokens[0].str(), pathModule)
+				) {
+					vecWarmPaths.push_back(pathModule);
+				}
+			}
+			WarmModuleMetadata(vecWarmPaths);
+		}
+		g_Profiler.EndPhase();
+
+		// Build driver script list
+		printf("Identifying drivers\n");
+		g_Profiler.StartPhase("drivers/identify");
+
+		// Stamps of every file consulted during resolution, recorded in
+		// the cached plan
+		nlohmann::json jstamps = nlohmann::json::value_t::array;
+		CMECRunPlanCache::StampFile(lib.GetLibraryFilePath(), jstamps);
+
+		// Token vector reused across module names so Split() only allocates
+		// on the first pass
+		std::vector<STLStringHelper::StringView> vecNameTokens;
+
+		for (int m = 0; m < vecModules.size(); m++) {
+
+			// Get the name of the base module
+			std::string strParentModule;
+			std::string strConfiguration;
+			if (vecModules[m].length() == 0) {
+				_EXCEPTION1("Zero length module name at index %i\n", m);
+			}
+			if (vecModules[m][vecModules[m].length()-1] == '/') {
+				printf("ERROR: Dangling forward slash in module name \"%s\"\n", vecModules[m].c_str());
+				return (-1);
+			}
+			for (int i = 0; i < vecModules[m].length(); i++) {
+				if (!isalnum(vecModules[m][i]) && (vecModules[m][i] != '_') && (vecModules[m][i] != '/')) {
+					printf("ERROR: Non-alphanumeric characters found in module name \"%s\"\n", vecModules[m].c_str());
+					return (-1);
+				}
+			}
+
+			// Split the name into parent module and configuration at the
+			// first forward slash; later slashes remain part of the
+			// configuration name
+			STLStringHelper::Split(vecModules[m], '/', vecNameTokens);
+			if (vecNameTokens.size() == 1) {
+				strParentModule = vecModules[m];
+			} else {
+				strParentModule = vecNameTokens[0].str();
+				const char * szConfig = vecNameTokens[1].szData;
+				strConfiguration =
+					std::string(szConfig,
+						vecModules[m].c_str() + vecModules[m].length()
+							- szConfig);
+			}
+
+			// Check for base module in library
+			filesystem::path pathModule;
+			if (!lib.FindModulePath(strParentModule, pathModule)) {
+				printf("ERROR: Module \"%s\" not found in CMEC library\n",
+					strParentModule.c_str());
+				return (-1);
+			}
+
+			// Stamp the files that decide how this module resolves
+			CMECRunPlanCache::StampFile(
+				pathModule / filesystem::path(g_szCMECSettingsName), jstamps);
+			CMECRunPlanCache::StampFile(
+				pathModule / filesystem::path(g_szCMECTOCName), jstamps);
+
+			// Check if module contains a settings file
+			if (CMECModuleSettings::ExistsInModulePath(pathModule)) {
+				if (strConfiguration != "") {
+					printf("ERROR: Module \"%s\" only contains a single configuration\n", strParentModule.c_str());
+					return (-1);
+				}
+
+				CMECModuleSettings cmecsettings;
+				fSuccess = cmecsettings.ReadFromFile(pathModule / g_szCMECSettingsName);
+				if (!fSuccess) {
+					return (-1);
+				}
+
+				PathInternPool::Handle hModule =
+					pathpool.Intern(pathModule.str());
+
+				vecModulePaths.push_back(hModule);
+				vecDriverScripts.push_back(
+					pathpool.Intern(hModule, cmecsettings.GetDriverScript()));
+				vecWorkingDirs.push_back(
+					pathpool.Intern(cmecsettings.GetName()));
+				vecSettingsPaths.push_back(
+					pathpool.Intern(hModule, g_szCMECSettingsName));
+				vecDependencyNames.push_back(cmecsettings.GetDependencies());
+
+			// Check if module contains a contents file
+			} else if (CMECModuleTOC::ExistsInModulePath(pathModule)) {
+				CMECModuleTOC cmectoc;
+				fSuccess = cmectoc.ReadFromModulePath(pathModule);
+				if (!fSuccess) {
+					return (-1);
+				}
+
+				PathInternPool::Handle hModule =
+					pathpool.Intern(pathModule.str());
+				PathInternPool::Handle hTOCName =
+					pathpool.Intern(cmectoc.GetName());
+
+				bool fContainsConfiguration = false;
+				for (auto itsettings = cmectoc.begin(); itsettings != cmectoc.end(); itsettings++) {
+					if ((strConfiguration != "") && (strConfiguration != itsettings->first)) {
+						continue;
+					}
+					CMECModuleSettings cmecsettings;
+					CMECRunPlanCache::StampFile(itsettings->second, jstamps);
+					fSuccess = cmecsettings.ReadFromFile(itsettings->second);
+					if (!fSuccess) {
+						return (-1);
+					}
+
+					vecModulePaths.push_back(hModule);
+					vecDriverScripts.push_back(
+						pathpool.Intern(hModule, cmecsettings.GetDriverScript()));
+					vecWorkingDirs.push_back(
+						pathpool.Intern(hTOCName, cmecsettings.GetName()));
+					vecSettingsPaths.push_back(
+						pathpool.Intern(itsettings->second.str()));
+					vecDependencyNames.push_back(cmecsettings.GetDependencies());
+
+					fContainsConfiguration = true;
+				}
+
+				if ((strConfiguration != "") && (!fContainsConfiguration)) {
+					printf("ERROR: Module \"%s\" does not contain configuration \"%s\"\n",
+						strParentModule.c_str(),
+						strConfiguration.c_str());
+					return (-1);
+				}
+
+			} else {
+				printf("ERROR: Module \"%s\" with path \"%s\" does not contain \"%s\" or \"%s\"\n",
+					strParentModule.c_str(),
+					pathModule.str().c_str(),
+					g_szCMECSettingsName,
+					g_szCMECTOCName);
+			}
+		}
+
+		g_Profiler.EndPhase();
+
+		// Record the resolved plan so later runs with the same module
+		// arguments and unchanged inputs skip resolution
+		if (vecDriverScripts.size() != 0) {
+			nlohmann::json jdrivers = nlohmann::json::value_t::array;
+			for (int d = 0; d < vecDriverScripts.size(); d++) {
+				nlohmann::json jdriver;
+				jdriver["module"] = pathpool.Str(vecModulePaths[d]);
+				jdriver["driver"] = pathpool.Str(vecDriverScripts[d]);
+				jdriver["working_dir"] = pathpool.Str(vecWorkingDirs[d]);
+				jdriver["settings"] = pathpool.Str(vecSettingsPaths[d]);
+				jdriver["dependencies"] = vecDependencyNames[d];
+				jdrivers.push_back(jdriver);
+			}
+			jplan.clear();
+			jplan["stamps"] = jstamps;
+			jplan["drivers"] = jdrivers;
+			plancache.InsertPlan(strPlanKey, jplan);
+			plancache.Write();
+		}
+	}
+
+	_ASSERT(vecModulePaths.size() == vecDriverScripts.size());
+	_ASSERT(vecModulePaths.size() == vecWorkingDirs.size());
+	_ASSERT(vecModulePaths.size() == vecSettingsPaths.size());
+	_ASSERT(vecModulePaths.size() == vecDependencyNames.size());
+
+	// Check for zero drivers
+	if (vecDriverScripts.size() == 0) {
+		printf("ERROR: No driver files found\n");
+		return (-1);
+	}
+
+	// Output driver file list
+	printf("The following %lu module(s) will be executed:\n", vecDriverScripts.size());
+	printf("------------------------------------------------------------\n");
+	for (int d = 0; d < vecDriverScripts.size(); d++) {
+		printf("MODULE_NAME: %s\n", pathpool.Str(vecWorkingDirs[d]).c_str());
+		printf("MODULE_PATH: %s\n", pathpool.Str(vecModulePaths[d]).c_str());
+		printf("  %s\n", pathpool.Str(vecDriverScripts[d]).c_str());
+	}
+	printf("------------------------------------------------------------\n");
+
+	// Resolve declared dependency names to indices in the execution
+	// list.  A bare name refers to a sibling configuration of the same
+	// parent module; a name containing a forward slash is matched
+	// against the full configuration name.  Dependencies naming
+	// configurations outside this run are assumed current and ignored.
+	std::vector<std::vector<size_t> > vecDependencyEdges(
+		vecDriverScripts.size());
+
+	for (size_t d = 0; d < vecDependencyNames.size(); d++) {
+		for (size_t e = 0; e < vecDependencyNames[d].size(); e++) {
+			const std::string & strDep = vecDependencyNames[d][e];
+
+			std::string strFullDep = strDep;
+			if (strDep.find('/') == std::string::npos) {
+				const std::string & strWorkingDir =
+					pathpool.Str(vecWorkingDirs[d]);
+				size_t sSlash = strWorkingDir.rfind('/');
+				if (sSlash != std::string::npos) {
+					strFullDep =
+						strWorkingDir.substr(0, sSlash+1) + strDep;
+				}
+			}
+
+			bool fResolved = false;
+			for (size_t dDep = 0; dDep < vecWorkingDirs.size(); dDep++) {
+				if (pathpool.Str(vecWorkingDirs[dDep]) == strFullDep) {
+					if (dDep != d) {
+						vecDependencyEdges[d].push_back(dDep);
+					}
+					fResolved = true;
+					break;
+				}
+			}
+			if (!fResolved) {
+				printf("WARNING: Dependency \"%s\" of module \"%s\" is "
+					"not part of this run; assuming its outputs are "
+					"current\n",
+					strDep.c_str(),
+					pathpool.Str(vecWorkingDirs[d]).c_str());
+			}
+		}
+	}
+
+	// Environment variables
+	printf("The following environment variables will be set:\n");
+	printf("------------------------------------------------------------\n");
+	printf("CMEC_OBS_DATA=%s\n", pathObsDir.str().c_str());
+	printf("CMEC_MODEL_DATA=%s\n", pathModelDir.str().c_str());
+	printf("CMEC_WK_DIR=%s/$MODULE_NAME\n", pathWorkingDir.str().c_str());
+	printf("CMEC_CODE_DIR=$MODULE_PATH\n");
+	printf("CMEC_DATA_MANIFEST=%s/%s\n",
+		pathWorkingDir.str().c_str(), g_szCMECDataManifestName);
+	printf("------------------------------------------------------------\n");
+
+	// Scan the data directories once, in parallel; the manifests feed
+	// both the input fingerprints for incremental execution and the
+	// indexed data listing handed to modules.
+	printf("Scanning data directories\n");
+	g_Profiler.StartPhase("data/scan");
+	std::vector<DataManifestEntry> vecObsEntries;
+	std::vector<DataManifestEntry> vecModelEntries;
+	ScanDirectoryManifest(pathObsDir, vecObsEntries);
+	ScanDirectoryManifest(pathModelDir, vecModelEntries);
+	uint64_t uObsManifest = HashManifestEntries(vecObsEntries);
+	uint64_t uModelManifest = HashManifestEntries(vecModelEntries);
+
+	std::vector<nlohmann::json> vecFingerprints(vecDriverScripts.size());
+	std::vector<bool> vecUpToDate(vecDriverScripts.size(), false);
+
+	for (int d = 0; d < vecDriverScripts.size(); d++) {
+		vecFingerprints[d] =
+			BuildRunFingerprint(
+				pathpool.GetPath(vecDriverScripts[d]),
+				pathpool.GetPath(vecSettingsPaths[d]),
+				uObsManifest,
+				uModelManifest);
+	}
+
+	g_Profiler.EndPhase();
+
+	// Write the indexed data manifest so conforming modules can skip
+	// their own directory traversal
+	filesystem::path pathDataManifest =
+		pathWorkingDir / filesystem::path(g_szCMECDataManifestName);
+	std::string strDataManifest;
+
+	g_Profiler.StartPhase("manifest/write");
+	if (WriteDataManifest(
+			pathDataManifest, pathObsDir, pathModelDir,
+			vecObsEntries, vecModelEntries)
+	) {
+		strDataManifest = pathDataManifest.str();
+	}
+	g_Profiler.EndPhase();
+
+	// Create output directories.  All of the output directories are
+	// evaluated for conflicts in one pre-pass so the overwrite policy is
+	// answered once for the whole batch; approved directories are then
+	// cleared concurrently.  The creation pass itself is batched beneath
+	// a single descriptor of the working directory.
+	printf("Creating output directories\n");
+	g_Profiler.StartPhase("directories/create");
+
+	std::vector<size_t> vecConflicts;
+	for (int d = 0; d < vecDriverScripts.size(); d++) {
+		filesystem::path pathOut =
+			pathWorkingDir / pathpool.GetPath(vecWorkingDirs[d]);
+
+		if (!pathOut.exists()) {
+			continue;
+		}
+
+		// Skip configurations whose recorded fingerprint matches their
+		// current inputs
+		if (!fForce) {
+			filesystem::path pathFingerprint =
+				pathOut / filesystem::path(g_szCMECFingerprintName);
+
+			if (pathFingerprint.exists()) {
+				try {
+					std::ifstream iffp(pathFingerprint.str());
+					nlohmann::json jstored =
+						nlohmann::json::parse(iffp);
+					if (jstored == vecFingerprints[d]) {
+						printf("Module \"%s\" is up to date; skipping "
+							"(use --force to rerun)\n",
+							pathpool.Str(vecWorkingDirs[d]).c_str());
+						vecUpToDate[d] = true;
+						continue;
+					}
+				} catch (std::exception & e) {
+					// An unreadable fingerprint is treated as stale
+				}
+			}
+		}
+
+		vecConflicts.push_back(static_cast<size_t>(d));
+	}
+
+	if (vecConflicts.size() != 0) {
+
+		// Answer the overwrite policy up front for the whole batch
+		if (fNoClobber) {
+			printf("ERROR: %lu output directories already exist "
+				"(--no-clobber):\n",
+				vecConflicts.size());
+			for (size_t c = 0; c < vecConflicts.size(); c++) {
+				printf("  %s\n",
+					pathpool.Str(vecWorkingDirs[vecConflicts[c]]).c_str());
+			}
+			return (-1);
+		}
+
+		if (!fForce) {
+
+			// Without a terminal there is nobody to answer the prompt;
+			// require an explicit policy rather than blocking the batch
+			if (!isatty(STDIN_FILENO)) {
+				printf("ERROR: %lu output directories already exist and "
+					"stdin is not a terminal; rerun with --force to "
+					"overwrite or --no-clobber to fail fast\n",
+					vecConflicts.size());
+				return (-1);
+			}
+
+			for (size_t c = 0; c < vecConflicts.size(); c++) {
+				printf("  %s\n",
+					pathpool.Str(vecWorkingDirs[vecConflicts[c]]).c_str());
+			}
+			printf("%lu output directories already exist. "
+				"Overwrite all? [y/N]",
+				vecConflicts.size());
+
+			bool fRemove = false;
+			for (;;) {
+				char c = Terminal::GetSingleCharacter();
+				if ((c == 'y') || (c == 'Y')) {
+					fRemove = true;
+					break;
+				}
+				if ((c == '\n') || (c == '\r') || (c == 'n') || (c == 'N')) {
+					fRemove = false;
+					break;
+				}
+			}
+			if (!fRemove) {
+				printf("ERROR: Unable to clear output directories\n");
+				return (-1);
+			}
+		}
+
+		// Clear the approved directories concurrently
+		{
+			std::atomic<size_t> sNextConflict(0);
+			std::atomic<size_t> sErrorCount(0);
+
+			auto RemoveLoop = [&]() {
+				for (;;) {
+					size_t c = sNextConflict.fetch_add(1);
+					if (c >= vecConflicts.size()) {
+						break;
+					}
+					filesystem::path pathOut =
+						pathWorkingDir
+						/ pathpool.GetPath(vecWorkingDirs[vecConflicts[c]]);
+
+					size_t nRemoveErrors =
+						RemoveDirectoryTree(pathOut.str());
+					if (nRemoveErrors != 0) {
+						printf("ERROR: Unable to remove \"%s\" "
+							"(%lu entries could not be removed)\n",
+							pathOut.str().c_str(),
+							nRemoveErrors);
+						sErrorCount++;
+					}
+				}
+			};
+
+			size_t nWorkers = std::thread::hardware_concurrency();
+			if (nWorkers == 0) {
+				nWorkers = 1;
+			}
+			if (nWorkers > 8) {
+				nWorkers = 8;
+			}
+			if (nWorkers > vecConflicts.size()) {
+				nWorkers = vecConflicts.size();
+			}
+
+			std::vector<std::thread> vecRemoveWorkers;
+			for (size_t w = 0; w < nWorkers; w++) {
+				vecRemoveWorkers.push_back(std::thread(RemoveLoop));
+			}
+			for (size_t w = 0; w < vecRemoveWorkers.size(); w++) {
+				vecRemoveWorkers[w].join();
+			}
+
+			if (sErrorCount != 0) {
+				return (-1);
+			}
+		}
+	}
+
+	// Resolve the working directory prefix once and create every stale
+	// configuration's directories beneath the held descriptor, pulled
+	// off a shared queue by a worker pool
+	{
+		int fdWorkingDir =
+			open(pathWorkingDir.str().c_str(),
+				O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+		if (fdWorkingDir < 0) {
+			printf("ERROR: Unable to open working directory \"%s\" (%s)\n",
+				pathWorkingDir.str().c_str(),
+				strerror(errno));
+			return (-1);
+		}
+
+		std::atomic<size_t> sNextDir(0);
+		std::atomic<size_t> sErrorCount(0);
+
+		auto WorkerLoop = [&]() {
+			for (;;) {
+				size_t d = sNextDir.fetch_add(1);
+				if (d >= vecWorkingDirs.size()) {
+					break;
+				}
+				if (vecUpToDate[d]) {
+					continue;
+				}
+				if (!CreateDirectoriesAt(
+						fdWorkingDir, pathpool.Str(vecWorkingDirs[d]))
+				) {
+					sErrorCount++;
+				}
+			}
+		};
+
+		size_t nWorkers = std::thread::hardware_concurrency();
+		if (nWorkers == 0) {
+			nWorkers = 1;
+		}
+		if (nWorkers > 8) {
+			nWorkers = 8;
+		}
+		if (nWorkers > vecWorkingDirs.size()) {
+			nWorkers = vecWorkingDirs.size();
+		}
+
+		if (nWorkers <= 1) {
+			WorkerLoop();
+
+		} else {
+			std::vector<std::thread> vecWorkers;
+			for (size_t w = 0; w < nWorkers; w++) {
+				vecWorkers.push_back(std::thread(WorkerLoop));
+			}
+			for (size_t w = 0; w < vecWorkers.size(); w++) {
+				vecWorkers[w].join();
+			}
+		}
+
+		close(fdWorkingDir);
+
+		if (sErrorCount != 0) {
+			printf("ERROR: Unable to create %lu output directories "
+				"under \"%s\"\n",
+				static_cast<unsigned long>(sErrorCount),
+				pathWorkingDir.str().c_str());
+			return (-1);
+		}
+
+		for (size_t d = 0; d < vecWorkingDirs.size(); d++) {
+			if (!vecUpToDate[d]) {
+				printf("Created \"%s\"\n",
+					(pathWorkingDir / pathpool.GetPath(vecWorkingDirs[d])).str().c_str());
+			}
+		}
+	}
+	g_Profiler.EndPhase();
+
+	// Build the module run commands for stale configurations.
+	// Dependencies on up-to-date configurations are already satisfied
+	// and dropped; the remainder are remapped into command indices.
+	std::vector<ModuleRunCommand> vecCommands;
+	std::vector<size_t> vecCommandIndex;
+	std::vector<size_t> vecFullToCommand(
+		vecDriverScripts.size(), static_cast<size_t>(-1));
+	for (int d = 0; d < vecDriverScripts.size(); d++) {
+		if (vecUpToDate[d]) {
+			continue;
+		}
+		ModuleRunCommand cmd;
+		cmd.pathDriverScript = pathpool.GetPath(vecDriverScripts[d]);
+		cmd.pathCodeDir =
+			pathpool.GetPath(pathpool.MakeAbsolute(vecModulePaths[d]));
+		cmd.pathWorkingDir =
+			pathWorkingDir / pathpool.GetPath(vecWorkingDirs[d]);
+		cmd.strModuleName = pathpool.Str(vecWorkingDirs[d]);
+		vecFullToCommand[d] = vecCommands.size();
+		vecCommands.push_back(cmd);
+		vecCommandIndex.push_back(static_cast<size_t>(d));
+	}
+	for (size_t c = 0; c < vecCommands.size(); c++) {
+		size_t d = vecCommandIndex[c];
+		for (size_t e = 0; e < vecDependencyEdges[d].size(); e++) {
+			size_t dDep = vecDependencyEdges[d][e];
+			if (vecFullToCommand[dDep] != static_cast<size_t>(-1)) {
+				vecCommands[c].vecDependencies.push_back(
+					vecFullToCommand[dDep]);
+			}
+		}
+	}
+
+	// Verify the dependency graph is acyclic; the resulting order also
+	// drives serial execution
+	std::vector<size_t> vecTopoOrder;
+	if (!TopologicalSortCommands(vecCommands, vecTopoOrder)) {
+		printf("ERROR: Module dependencies form a cycle\n");
+		return (-1);
+	}
+
+	// Executing driver scripts
+	std::vector<ModuleRunResult> vecResults;
+
+	if (vecCommands.size() == 0) {
+		printf("All modules are up to date\n");
+		WriteProfileReport("run", pathWorkingDir);
+		return 0;
+	}
+
+	// Historical run costs provide wall time estimates for scheduling
+	// and are updated with the costs of this run
+	CMECRunHistory runhistory;
+
+	std::vector<double> vecWallTimeEstimates(vecCommands.size(), -1.0);
+	for (size_t d = 0; d < vecCommands.size(); d++) {
+		runhistory.GetWallTimeEstimate(
+			vecCommands[d].strModuleName,
+			vecWallTimeEstimates[d]);
+	}
 
-	// Check if module contains a contents file
-	} else if (CMECModuleTOC::ExistsInModulePath(pathModule)) {
-		printf("Validating %s\n", g_szCMECTOCName);
+	g_Profiler.StartPhase("drivers/execute");
 
-		CMECModuleTOC cmectoc;
-		cmectoc.ReadFromModulePath(pathModule);
+	if (strHosts.length() != 0) {
+		std::vector<STLStringHelper::StringView> vecHostTokens;
+		STLStringHelper::Split(strHosts, ',', vecHostTokens);
+		std::vector<std::string> vecHosts;
+		for (size_t h = 0; h < vecHostTokens.size(); h++) {
+			if (vecHostTokens[h].sLength != 0) {
+				vecHosts.push_back(vecHostTokens[h].str());
+			}
+		}
+		if (vecHosts.size() == 0) {
+			printf("ERROR: Invalid host list \"%s\"\n", strHosts.c_str());
+			return (-1);
+		}
+		printf("Executing driver scripts across %lu host(s)\n",
+			static_cast<unsigned long>(vecHosts.size()));
+		ExecuteDriversDistributed(
+			vecHosts,
+			vecCommands,
+			pathObsDir,
+			pathModelDir,
+			strDataManifest,
+			pathWorkingDir,
+			vecWallTimeEstimates,
+			vecResults,
+			nConcurrency,
+			nCPUsPerModule,
+			limits);
+
+	} else if (nConcurrency <= 1) {
+		printf("Executing driver scripts\n");
+		vecResults.resize(vecCommands.size());
+		for (size_t q = 0; q < vecTopoOrder.size(); q++) {
+			size_t d = vecTopoOrder[q];
+
+			vecResults[d].strModuleName = vecCommands[d].strModuleName;
+
+			// Skip commands whose dependencies failed or were skipped;
+			// the topological order guarantees dependency results are
+			// already recorded
+			bool fDependencyFailed = false;
+			for (size_t e = 0; e < vecCommands[d].vecDependencies.size(); e++) {
+				if (vecResults[vecCommands[d].vecDependencies[e]].iReturnCode != 0) {
+					fDependencyFailed = true;
+					break;
+				}
+			}
+			if (fDependencyFailed) {
+				printf("------------------------------------------------------------\n");
+				printf("\033[1m%s\033[0m skipped (dependency failed)\n",
+					vecCommands[d].strModuleName.c_str());
+				vecResults[d].iReturnCode = -1;
+				vecResults[d].dWallTimeSeconds = 0.0;
+				vecResults[d].iMaxRSSKB = 0;
+				vecResults[d].fSkipped = true;
+				vecResults[d].fTimedOut = false;
+				continue;
+			}
 
-		// Output metadata
-		strName = cmectoc.GetName();
-		std::string strLongName = cmectoc.GetLongName();
-		printf("Module \033[1m%s\033[0m (\033[1m%s\033[0m)\n", strName.c_str(), strLongName.c_str());
+			printf("------------------------------------------------------------\n");
+			printf("\033[1m%s\033[0m\n", vecCommands[d].strModuleName.c_str());
+
+			intmax_t iMaxRSSKB = 0;
+			bool fTimedOut = false;
+			auto timeBegin = std::chrono::steady_clock::now();
+			int iReturn =
+				SpawnDriverScript(
+					vecCommands[d],
+					pathObsDir,
+					pathModelDir,
+					strDataManifest,
+					-1,
+					limits,
+					iMaxRSSKB,
+					fTimedOut);
+			auto timeEnd = std::chrono::steady_clock::now();
+
+			vecResults[d].iReturnCode = iReturn;
+			vecResults[d].dWallTimeSeconds =
+				std::chrono::duration<double>(timeEnd - timeBegin).count();
+			vecResults[d].iMaxRSSKB = iMaxRSSKB;
+			vecResults[d].fTimedOut = fTimedOut;
+			if (fTimedOut) {
+				printf("\033[1m%s\033[0m TIMED OUT (%.1fs)\n",
+					vecCommands[d].strModuleName.c_str(),
+					vecResults[d].dWallTimeSeconds);
+			}
+		}
 
-		// Check number of configurations
-		printf("Contains \033[1m%lu configurations\033[0m:\n", cmectoc.size());
+	} else {
+		printf("Executing driver scripts (%lu workers)\n", nConcurrency);
 		printf("------------------------------------------------------------\n");
-		for (auto itconfig = cmectoc.begin(); itconfig != cmectoc.end(); itconfig++) {
-			printf("  %s/%s\n", strName.c_str(), itconfig->first.c_str());
+		ExecuteDriversParallel(
+			nConcurrency,
+			vecCommands,
+			pathObsDir,
+			pathModelDir,
+			strDataManifest,
+			vecWallTimeEstimates,
+			vecResults,
+			nCPUsPerModule,
+			limits);
+	}
+
+	g_Profiler.EndPhase();
+
+	// Update the run history with the costs of successful runs
+	for (size_t c = 0; c < vecResults.size(); c++) {
+		if (vecResults[c].iReturnCode != 0) {
+			continue;
 		}
-		printf("------------------------------------------------------------\n");
+		runhistory.Record(
+			vecResults[c].strModuleName,
+			vecResults[c].dWallTimeSeconds,
+			vecResults[c].iMaxRSSKB);
+	}
+	try {
+		runhistory.Write();
+	} catch (Exception & e) {
+		printf("WARNING: %s\n", e.ToString().c_str());
+	}
 
-	// Both files missing; throw error
-	} else {
-		printf("ERROR: Module path must contain \"%s\" or \"%s\"\n",
-			g_szCMECTOCName,
-			g_szCMECSettingsName);
+	// Record fingerprints of successful runs so unchanged configurations
+	// are skipped next time
+	g_Profiler.StartPhase("fingerprints/write");
+	for (size_t c = 0; c < vecResults.size(); c++) {
+		if (vecResults[c].iReturnCode != 0) {
+			continue;
+		}
+		size_t d = vecCommandIndex[c];
+
+		filesystem::path pathFingerprint =
+			pathWorkingDir / pathpool.GetPath(vecWorkingDirs[d])
+			/ filesystem::path(g_szCMECFingerprintName);
+
+		std::ofstream offp(pathFingerprint.str());
+		if (!offp.is_open()) {
+			printf("WARNING: Unable to write fingerprint file \"%s\"\n",
+				pathFingerprint.str().c_str());
+			continue;
+		}
+		offp << vecFingerprints[d].dump(4) << std::endl;
+	}
+	g_Profiler.EndPhase();
+
+	WriteProfileReport("run", pathWorkingDir, &vecResults);
+
+	// Consolidated execution summary
+	int nFailures = 0;
+	printf("------------------------------------------------------------\n");
+	printf("Execution summary:\n");
+	for (size_t d = 0; d < vecDriverScripts.size(); d++) {
+		if (vecUpToDate[d]) {
+			printf("  %-40s up to date\n",
+				pathpool.Str(vecWorkingDirs[d]).c_str());
+		}
+	}
+	for (size_t d = 0; d < vecResults.size(); d++) {
+		if (vecResults[d].fSkipped) {
+			printf("  %-40s skipped (dependency failed)\n",
+				vecResults[d].strModuleName.c_str());
+			nFailures++;
+			continue;
+		}
+		printf("  %-40s %s (%.1fs)\n",
+			vecResults[d].strModuleName.c_str(),
+			(vecResults[d].iReturnCode == 0)?("ok"):
+			(vecResults[d].fTimedOut)?("TIMED OUT"):("FAILED"),
+			vecResults[d].dWallTimeSeconds);
+		if (vecResults[d].iReturnCode != 0) {
+			nFailures++;
+		}
+	}
+	printf("------------------------------------------------------------\n");
 
+	if (nFailures != 0) {
+		printf("ERROR: %i module(s) failed\n", nFailures);
 		return (-1);
 	}
 
-	// Load the CMEC library
-	printf("Reading CMEC library\n");
-	CMECLibrary lib;
-	lib.Read();
+	return 0;
+}
 
-	// Add this path to the library
-	printf("Adding new module to library\n");
-	bool fSuccess = lib.Insert(strName, pathModule);
-	if (!fSuccess) {
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		A SAX event handler that extracts the scalar metrics from a module
+///		output.json file without building a DOM for the full document.
+///		Only the subtree under the top-level "metrics" key is retained;
+///		metric keys are flattened into "::"-delimited paths.
+///	</summary>
+class CMECMetricsSAXReader : public nlohmann::json::json_sax_t {
+
+public:
+	///	<summary>
+	///		Constructor.
+	///	</summary>
+	CMECMetricsSAXReader() :
+		m_fRootOpen(false),
+		m_nArrayDepth(0)
+	{ }
+
+public:
+	///	<summary>
+	///		The flattened metrics extracted from the document.
+	///	</summary>
+	const nlohmann::json & GetMetrics() const {
+		return m_jmetrics;
+	}
+
+	///	<summary>
+	///		Description of the parse error, if parsing failed.
+	///	</summary>
+	const std::string & GetErrorMessage() const {
+		return m_strError;
+	}
+
+public:
+	bool null() override {
+		return true;
+	}
+
+	bool boolean(bool val) override {
+		RecordMetric(val);
+		return true;
+	}
+
+	bool number_integer(number_integer_t val) override {
+		RecordMetric(val);
+		return true;
+	}
+
+	bool number_unsigned(number_unsigned_t val) override {
+		RecordMetric(val);
+		return true;
+	}
+
+	bool number_float(number_float_t val, const string_t & s) override {
+		RecordMetric(val);
+		return true;
+	}
+
+	bool string(string_t & val) override {
+		RecordMetric(val);
+		return true;
+	}
+
+	bool start_object(std::size_t elements) override {
+		if (!m_fRootOpen) {
+			m_fRootOpen = true;
+		} else if (m_nArrayDepth == 0) {
+			m_vecPath.push_back(m_strKey);
+		} else {
+			m_vecPath.push_back("#");
+		}
+		return true;
+	}
+
+	bool key(string_t & val) override {
+		m_strKey = val;
+		return true;
+	}
+
+	bool end_object() override {
+		if (m_vecPath.size() != 0) {
+			m_vecPath.pop_back();
+		}
+		return true;
+	}
+
+	bool start_array(std::size_t elements) override {
+		m_nArrayDepth++;
+		return true;
+	}
+
+	bool end_array() override {
+		m_nArrayDepth--;
+		return true;
+	}
+
+	bool parse_error(
+		std::size_t position,
+		const std::string & last_token,
+		const nlohmann::json::exception & ex
+	) override {
+		m_strError = ex.what();
+		return false;
+	}
+
+protected:
+	///	<summary>
+	///		Record a scalar value under its flattened key path, if the
+	///		current position is inside the top-level "metrics" subtree.
+	///		Array elements are not metrics and are ignored.
+	///	</summary>
+	template <typename T>
+	void RecordMetric(const T & val) {
+		if ((m_nArrayDepth != 0) ||
+		    (m_vecPath.size() == 0) ||
+		    (m_vecPath[0] != "metrics")
+		) {
+			return;
+		}
+
+		std::string strFlatKey;
+		for (size_t p = 1; p < m_vecPath.size(); p++) {
+			strFlatKey += m_vecPath[p];
+			strFlatKey += "::";
+		}
+		strFlatKey += m_strKey;
+
+		m_jmetrics[strFlatKey] = val;
+	}
+
+protected:
+	///	<summary>
+	///		Set once the document root object has been opened.
+	///	</summary>
+	bool m_fRootOpen;
+
+	///	<summary>
+	///		Current array nesting depth.
+	///	</summary>
+	int m_nArrayDepth;
+
+	///	<summary>
+	///		Keys of the enclosing objects, from the document root.
+	///	</summary>
+	std::vector<std::string> m_vecPath;
+
+	///	<summary>
+	///		Most recently observed object key.
+	///	</summary>
+	std::string m_strKey;
+
+	///	<summary>
+	///		Flattened metrics extracted from the document.
+	///	</summary>
+	nlohmann::json m_jmetrics;
+
+	///	<summary>
+	///		Description of the parse error, if parsing failed.
+	///	</summary>
+	std::string m_strError;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Recursively collect the output.json files beneath the given
+///		working directory, pairing each with the name of its module
+///		configuration (the working directory path relative to the root).
+///		Hidden entries are skipped and recursion is bounded, matching the
+///		nesting produced by cmec_run.
+///	</summary>
+void FindModuleOutputsRecursive(
+	const filesystem::path & pathDir,
+	const std::string & strPrefix,
+	int nDepthRemaining,
+	std::vector<std::pair<std::string, filesystem::path> > & vecOutputs
+) {
+	DIR * pDir = opendir(pathDir.str().c_str());
+	if (pDir == NULL) {
+		_EXCEPTION1("Unable to open directory \"%s\"",
+			pathDir.str().c_str());
+	}
+
+	// Sort entries so the index is independent of readdir order
+	std::vector<std::string> vecNames;
+	struct dirent * pDirent;
+	while ((pDirent = readdir(pDir)) != NULL) {
+		std::string strName(pDirent->d_name);
+		if ((strName.length() == 0) || (strName[0] == '.')) {
+			continue;
+		}
+		vecNames.push_back(strName);
+	}
+	closedir(pDir);
+
+	std::sort(vecNames.begin(), vecNames.end());
+
+	for (size_t s = 0; s < vecNames.size(); s++) {
+		filesystem::path pathEntry =
+			pathDir / filesystem::path(vecNames[s]);
+
+		if (vecNames[s] == g_szCMECOutputName) {
+			vecOutputs.push_back(
+				std::pair<std::string, filesystem::path>(
+					strPrefix, pathEntry));
+			continue;
+		}
+
+		if ((nDepthRemaining > 0) && (pathEntry.is_directory())) {
+			std::string strChildPrefix = strPrefix;
+			if (strChildPrefix.length() != 0) {
+				strChildPrefix += "/";
+			}
+			strChildPrefix += vecNames[s];
+
+			FindModuleOutputsRecursive(
+				pathEntry, strChildPrefix, nDepthRemaining - 1,
+				vecOutputs);
+		}
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Aggregate the metrics from the module outputs under the given
+///		working directory into a single index file.
+///	</summary>
+int cmec_aggregate(
+	std::string strWorkingDir
+) {
+	// Verify existence of the working directory
+	if (strWorkingDir.length() == 0) {
+		printf("ERROR: Working data path not specified\n");
+		return (-1);
+	}
+	if ((strWorkingDir[0] != '/') && (strWorkingDir[0] != '\\')) {
+		strWorkingDir = std::string("./") + strWorkingDir;
+	}
+	filesystem::path pathWorkingDir(strWorkingDir);
+	if (!pathWorkingDir.exists()) {
+		printf("ERROR: Cannot access path \"%s\"\n", strWorkingDir.c_str());
+		return (-1);
+	}
+	pathWorkingDir = pathWorkingDir.make_absolute();
+	if (!pathWorkingDir.is_directory()) {
+		printf("ERROR: \"%s\" is not a directory\n", strWorkingDir.c_str());
 		return (-1);
 	}
 
-	// Write CMEC library
-	printf("Writing CMEC library\n");
-	lib.Write();
+	// Collect module outputs, bounded to the module/configuration
+	// nesting produced by cmec_run
+	printf("Scanning for module outputs\n");
+
+	g_Profiler.StartPhase("outputs/scan");
+	std::vector<std::pair<std::string, filesystem::path> > vecOutputs;
+	FindModuleOutputsRecursive(pathWorkingDir, "", 3, vecOutputs);
+	g_Profiler.EndPhase();
+
+	if (vecOutputs.size() == 0) {
+		printf("No module outputs found in \"%s\"\n",
+			pathWorkingDir.str().c_str());
+		return 0;
+	}
+
+	// Stream each output through the SAX reader, retaining only the
+	// flattened metrics
+	nlohmann::json jindex;
+	jindex["version"] = g_szVersion;
+	jindex["working_dir"] = pathWorkingDir.str();
+	jindex["configurations"] = nlohmann::json::value_t::object;
+
+	size_t nMetricCount = 0;
+	size_t nConfigCount = 0;
+
+	g_Profiler.StartPhase("outputs/parse");
+	for (size_t c = 0; c < vecOutputs.size(); c++) {
+		CompressedInputFile mmapOutput(vecOutputs[c].second.str());
+
+		CMECMetricsSAXReader reader;
+		bool fSuccess =
+			nlohmann::json::sax_parse(
+				mmapOutput.begin(), mmapOutput.end(), &reader);
+
+		if (!fSuccess) {
+			printf("WARNING: Malformed module output file \"%s\": %s\n",
+				vecOutputs[c].second.str().c_str(),
+				reader.GetErrorMessage().c_str());
+			continue;
+		}
+
+		nlohmann::json & jconfig =
+			jindex["configurations"][vecOutputs[c].first];
+		jconfig["output"] = vecOutputs[c].second.str();
+		jconfig["metrics"] = reader.GetMetrics();
+
+		nMetricCount += reader.GetMetrics().size();
+		nConfigCount++;
+	}
+	g_Profiler.EndPhase();
+
+	// Write the merged index
+	filesystem::path pathIndex =
+		pathWorkingDir / filesystem::path(g_szCMECIndexName);
+
+	g_Profiler.StartPhase("index/write");
+	{
+		std::ofstream ofindex(pathIndex.str());
+		if (!ofindex.is_open()) {
+			_EXCEPTION1("Unable to open \"%s\" for writing",
+				pathIndex.str().c_str());
+		}
+		ofindex << jindex.dump(4) << std::endl;
+	}
+	g_Profiler.EndPhase();
+
+	printf("Aggregated %lu metric(s) across %lu configuration(s)\n",
+		nMetricCount, nConfigCount);
+	printf("Wrote \"%s\"\n", pathIndex.str().c_str());
+
+	WriteProfileReport("aggregate", pathWorkingDir);
 
 	return 0;
 }
@@ -889,28 +5710,186 @@ int cmec_register(
 ///////////////////////////////////////////////////////////////////////////////
 
 ///	<summary>
-///		Unregister the specified module.
+///		Classify the walltime trend of a recent-sample window by
+///		comparing the average of its older and newer halves.  Returns
+///		"rising", "falling" or "steady" (or "-" when fewer than four
+///		samples exist).
 ///	</summary>
-int cmec_unregister(
-	const std::string & strModuleName
+const char * ClassifyWallTimeTrend(
+	const nlohmann::json & jrecent
 ) {
-	printf("Unregistering \"%s\"\n", strModuleName.c_str());
+	if ((!jrecent.is_array()) || (jrecent.size() < 4)) {
+		return "-";
+	}
 
-	// Load the CMEC library
-	printf("Reading CMEC library\n");
-	CMECLibrary lib;
-	lib.Read();
+	size_t sHalf = jrecent.size() / 2;
+	double dOlder = 0.0;
+	double dNewer = 0.0;
+	for (size_t s = 0; s < jrecent.size(); s++) {
+		double dWallTime = jrecent[s][1];
+		if (s < sHalf) {
+			dOlder += dWallTime;
+		} else {
+			dNewer += dWallTime;
+		}
+	}
+	dOlder /= static_cast<double>(sHalf);
+	dNewer /= static_cast<double>(jrecent.size() - sHalf);
+
+	if (dOlder <= 0.0) {
+		return "-";
+	}
+	if (dNewer > 1.2 * dOlder) {
+		return "rising";
+	}
+	if (dNewer < 0.8 * dOlder) {
+		return "falling";
+	}
+	return "steady";
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Report runtime statistics from the accumulated run history:  for
+///		the fleet, each configuration's smoothed wall time, last run and
+///		delta against the previous run, peak RSS and trend, slowest
+///		first; for a single module (or module/configuration prefix), the
+///		full window of recent samples.
+///	</summary>
+int cmec_stats(
+	const std::string & strModule
+) {
+	CMECRunHistory runhistory;
+	const nlohmann::json & jmodules = runhistory.GetModules();
+
+	if (jmodules.size() == 0) {
+		printf("No run history recorded\n");
+		return 0;
+	}
+
+	// Collect matching entries:  everything, an exact configuration
+	// name, or every configuration of a parent module
+	std::vector<std::string> vecNames;
+	for (auto itmodule = jmodules.begin(); itmodule != jmodules.end(); itmodule++) {
+		if ((strModule.length() != 0) &&
+		    (itmodule.key() != strModule) &&
+		    (itmodule.key().compare(
+				0, strModule.length() + 1, strModule + "/") != 0)
+		) {
+			continue;
+		}
+		vecNames.push_back(itmodule.key());
+	}
+
+	if (vecNames.size() == 0) {
+		printf("No run history recorded for module \"%s\"\n",
+			strModule.c_str());
+		return (-1);
+	}
+
+	// Slowest configurations first
+	std::sort(vecNames.begin(), vecNames.end(),
+		[&](const std::string & a, const std::string & b) {
+			double dA = jmodules[a]["walltime"];
+			double dB = jmodules[b]["walltime"];
+			return (dA > dB);
+		});
+
+	printf("Run history for %lu configuration(s):\n",
+		static_cast<unsigned long>(vecNames.size()));
+	printf("--------------------------------------------------------------------------------\n");
+	printf("  %-32s %4s %9s %9s %8s %9s %s\n",
+		"configuration", "runs", "avg (s)", "last (s)",
+		"delta", "rss (MB)", "trend");
+
+	for (size_t s = 0; s < vecNames.size(); s++) {
+		const nlohmann::json & jentry = jmodules[vecNames[s]];
+
+		double dAverage = jentry["walltime"];
+		int nCount = jentry["count"];
+		intmax_t iMaxRSSKB = jentry["max_rss_kb"];
+
+		// Last run and its delta against the previous run come from the
+		// recent-sample window; histories recorded before the window
+		// existed report only the smoothed average
+		double dLast = -1.0;
+		double dPrev = -1.0;
+		const char * szTrend = "-";
+		auto itrecent = jentry.find("recent");
+		if ((itrecent != jentry.end()) && (itrecent->is_array())) {
+			if (itrecent->size() >= 1) {
+				dLast = (*itrecent)[itrecent->size()-1][1];
+			}
+			if (itrecent->size() >= 2) {
+				dPrev = (*itrecent)[itrecent->size()-2][1];
+			}
+			szTrend = ClassifyWallTimeTrend(*itrecent);
+		}
+
+		char szLast[32];
+		if (dLast >= 0.0) {
+			snprintf(szLast, sizeof(szLast), "%9.1f", dLast);
+		} else {
+			snprintf(szLast, sizeof(szLast), "%9s", "-");
+		}
+
+		// A last run more than half again slower than its predecessor
+		// is flagged as a regression
+		char szDelta[32];
+		bool fRegression = false;
+		if ((dLast >= 0.0) && (dPrev > 0.0)) {
+			double dDelta = 100.0 * (dLast - dPrev) / dPrev;
+			snprintf(szDelta, sizeof(szDelta), "%+7.1f%%", dDelta);
+			fRegression = (dLast > 1.5 * dPrev);
+		} else {
+			snprintf(szDelta, sizeof(szDelta), "%8s", "-");
+		}
 
-	// Remove module
-	printf("Removing module\n");
-	bool fSuccess = lib.Remove(strModuleName);
-	if (!fSuccess) {
-		return (-1);
+		printf("  %-32s %4i %9.1f %s %s %9.1f %s%s\n",
+			vecNames[s].c_str(),
+			nCount,
+			dAverage,
+			szLast,
+			szDelta,
+			static_cast<double>(iMaxRSSKB) / 1024.0,
+			szTrend,
+			(fRegression)?("  << regression"):(""));
 	}
+	printf("--------------------------------------------------------------------------------\n");
 
-	// Write CMEC library
-	printf("Writing CMEC library\n");
-	lib.Write();
+	// For a specific module also print the recent-sample window
+	if (strModule.length() == 0) {
+		return 0;
+	}
+
+	for (size_t s = 0; s < vecNames.size(); s++) {
+		const nlohmann::json & jentry = jmodules[vecNames[s]];
+		auto itrecent = jentry.find("recent");
+		if ((itrecent == jentry.end()) || (!itrecent->is_array()) ||
+		    (itrecent->size() == 0)
+		) {
+			continue;
+		}
+
+		printf("Recent runs of \"%s\":\n", vecNames[s].c_str());
+		for (size_t r = 0; r < itrecent->size(); r++) {
+			intmax_t iTimestamp = (*itrecent)[r][0];
+			double dWallTime = (*itrecent)[r][1];
+			intmax_t iRSSKB = (*itrecent)[r][2];
+
+			char szTime[64];
+			time_t t = static_cast<time_t>(iTimestamp);
+			struct tm tmLocal;
+			localtime_r(&t, &tmLocal);
+			strftime(szTime, sizeof(szTime), "%Y-%m-%d %H:%M:%S", &tmLocal);
+
+			printf("  %s  %9.1fs  %9.1f MB\n",
+				szTime,
+				dWallTime,
+				static_cast<double>(iRSSKB) / 1024.0);
+		}
+	}
 
 	return 0;
 }
@@ -918,323 +5897,234 @@ int cmec_unregister(
 ///////////////////////////////////////////////////////////////////////////////
 
 ///	<summary>
-///		List available modules and configurations.
+///		Resolve the path of the daemon-mode Unix domain socket.
 ///	</summary>
-int cmec_list(
-	bool fListAll
-) {
-	// Load the CMEC library
-	printf("Reading CMEC library\n");
-	CMECLibrary lib;
-	lib.Read();
+filesystem::path GetCMECSocketPath() {
+	char * homedir = getenv("HOME");
 
-	// Check for size zero library
-	if (lib.size() == 0) {
-		printf("CMEC library contains no modules\n");
-		return 0;
+	if (homedir != NULL) {
+		filesystem::path pathHome(homedir);
+		if (!pathHome.exists()) {
+			_EXCEPTIONT("Environment variable $HOME points to an invalid home directory path\n");
+		}
+		return pathHome/filesystem::path(g_szCMECSocketName);
 	}
 
-	// List modules
-	printf("CMEC library contains %lu modules:\n", lib.size());
-	printf("------------------------------------------------------------\n");
-	for (auto it = lib.begin(); it != lib.end(); it++) {
-		if (CMECModuleTOC::ExistsInModulePath(it->second)) {
-			CMECModuleTOC cmectoc;
-			cmectoc.ReadFromModulePath(it->second);
-			printf("  %s [%lu configurations]\n", it->first.c_str(), cmectoc.size());
-			if (fListAll) {
-				for (auto itconfig = cmectoc.begin(); itconfig != cmectoc.end(); itconfig++) {
-					printf("    %s/%s\n", it->first.c_str(), itconfig->first.c_str());
-				}
-			}
+	uid_t uid = getuid();
+	struct passwd *pw = getpwuid(uid);
 
-		} else {
-			printf("  %s\n", it->first.c_str());
-		}
+	if (pw == NULL) {
+		_EXCEPTIONT("Unable to identify path for .cmec.sock");
 	}
-	printf("------------------------------------------------------------\n");
 
-	return 0;
+	filesystem::path pathHome(pw->pw_dir);
+	if (!pathHome.exists()) {
+		_EXCEPTIONT("pwd points to an invalid home directory path");
+	}
+	return pathHome/filesystem::path(g_szCMECSocketName);
 }
 
 ///////////////////////////////////////////////////////////////////////////////
 
 ///	<summary>
-///		Run the specified module.
+///		Run as a resident daemon, servicing requests over a Unix domain
+///		socket at $HOME/.cmec.sock.  The library is parsed once and kept
+///		in memory, re-read only when the library file's stamp changes on
+///		disk; validated settings and TOC metadata likewise stay resident
+///		in the in-process validation cache, which is stamp-checked per
+///		lookup.  Each connection carries one newline-terminated request
+///		of space-separated tokens mirroring the command line ("list",
+///		"list all", "register <dir>", "unregister <name>",
+///		"run <obs dir> <model dir> <working dir> <modules>", "ping",
+///		"shutdown"); command output is streamed back over the socket
+///		followed by a trailing "== exit <code>" line.
 ///	</summary>
-int cmec_run(
-	std::string strObsDir,
-	std::string strModelDir,
-	std::string strWorkingDir,
-	const std::vector<std::string> & vecModules
-) {
-	bool fSuccess;
+int cmec_serve() {
 
-	// Verify existence of each directory
-	if (strObsDir.length() == 0) {
-		printf("ERROR: Observational data path not specified\n");
-		return (-1);
-	}
-	if ((strObsDir[0] != '/') && (strObsDir[0] != '\\')) {
-		strObsDir = std::string("./") + strObsDir;
-	}
-	filesystem::path pathObsDir(strObsDir);
-	if (!pathObsDir.exists()) {
-		printf("ERROR: Cannot access path \"%s\"\n", strObsDir.c_str());
-		return (-1);
-	}
-	pathObsDir = pathObsDir.make_absolute();
-	if (!pathObsDir.is_directory()) {
-		printf("ERROR: \"%s\" is not a directory\n", strObsDir.c_str());
-		return (-1);
-	}
+	// A client that disconnects mid-response must not kill the daemon
+	signal(SIGPIPE, SIG_IGN);
 
-	if (strModelDir.length() == 0) {
-		printf("ERROR: Model data path not specified\n");
-		return (-1);
-	}
-	if ((strModelDir[0] != '/') && (strModelDir[0] != '\\')) {
-		strModelDir = std::string("./") + strModelDir;
-	}
-	filesystem::path pathModelDir(strModelDir);
-	if (!pathModelDir.exists()) {
-		printf("ERROR: Cannot access path \"%s\"\n", strModelDir.c_str());
-		return (-1);
-	}
-	pathModelDir = pathModelDir.make_absolute();
-	if (!pathModelDir.is_directory()) {
-		printf("ERROR: \"%s\" is not a directory\n", strModelDir.c_str());
-		return (-1);
-	}
+	filesystem::path pathSocket = GetCMECSocketPath();
 
-	if (strWorkingDir.length() == 0) {
-		printf("ERROR: Working data path not specified\n");
-		return (-1);
+	// Bind the socket, replacing any socket left behind by an earlier
+	// daemon
+	int fdListen = socket(AF_UNIX, SOCK_STREAM, 0);
+	if (fdListen < 0) {
+		_EXCEPTION1("Unable to create socket: %s", strerror(errno));
 	}
-	if ((strWorkingDir[0] != '/') && (strWorkingDir[0] != '\\')) {
-		strWorkingDir = std::string("./") + strWorkingDir;
+
+	struct sockaddr_un addr;
+	memset(&addr, 0, sizeof(addr));
+	addr.sun_family = AF_UNIX;
+	if (pathSocket.str().length() >= sizeof(addr.sun_path)) {
+		_EXCEPTION1("Socket path \"%s\" too long", pathSocket.str().c_str());
 	}
-	filesystem::path pathWorkingDir(strWorkingDir);
-	if (!pathWorkingDir.exists()) {
-		printf("ERROR: Cannot access path \"%s\"\n", strWorkingDir.c_str());
-		return (-1);
+	strncpy(addr.sun_path, pathSocket.str().c_str(), sizeof(addr.sun_path) - 1);
+
+	unlink(pathSocket.str().c_str());
+
+	if (bind(fdListen, reinterpret_cast<struct sockaddr *>(&addr), sizeof(addr)) != 0) {
+		_EXCEPTION2("Unable to bind socket \"%s\": %s",
+			pathSocket.str().c_str(), strerror(errno));
 	}
-	pathWorkingDir = pathWorkingDir.make_absolute();
-	if (!pathWorkingDir.is_directory()) {
-		printf("ERROR: \"%s\" is not a directory\n", strWorkingDir.c_str());
-		return (-1);
+	if (listen(fdListen, 8) != 0) {
+		_EXCEPTION2("Unable to listen on socket \"%s\": %s",
+			pathSocket.str().c_str(), strerror(errno));
 	}
 
-	// Load the CMEC library
+	// Load the resident library
 	printf("Reading CMEC library\n");
 	CMECLibrary lib;
 	lib.Read();
 
-	// Build driver script list
-	printf("Identifying drivers\n");
-	std::vector<filesystem::path> vecModulePaths;
-	std::vector<filesystem::path> vecDriverScripts;
-	std::vector<filesystem::path> vecWorkingDirs;
-	std::vector<filesystem::path> vecEnvScripts;
+	intmax_t iLibMTime = 0;
+	intmax_t iLibSize = 0;
+	CMECValidationCache::GetFileStamp(lib.GetLibraryFilePath(), iLibMTime, iLibSize);
 
-	for (int m = 0; m < vecModules.size(); m++) {
+	printf("Serving requests on \"%s\"\n", pathSocket.str().c_str());
 
-		// Get the name of the base module
-		std::string strParentModule;
-		std::string strConfiguration;
-		if (vecModules[m].length() == 0) {
-			_EXCEPTION1("Zero length module name at index %i\n", m);
-		}
-		if (vecModules[m][vecModules[m].length()-1] == '/') {
-			printf("ERROR: Dangling forward slash in module name \"%s\"\n", vecModules[m].c_str());
-			return (-1);
-		}
-		for (int i = 0; i < vecModules[m].length(); i++) {
-			if (!isalnum(vecModules[m][i]) && (vecModules[m][i] != '_') && (vecModules[m][i] != '/')) {
-				printf("ERROR: Non-alphanumeric characters found in module name \"%s\"\n", vecModules[m].c_str());
-				return (-1);
+	bool fShutdown = false;
+	while (!fShutdown) {
+		int fdClient = accept(fdListen, NULL, NULL);
+		if (fdClient < 0) {
+			if (errno == EINTR) {
+				continue;
 			}
+			printf("ERROR: accept() failed: %s\n", strerror(errno));
+			break;
 		}
-		for (int i = 0; i < vecModules[m].length(); i++) {
-			if (vecModules[m][i] == '/') {
-				strParentModule = vecModules[m].substr(0,i);
-				strConfiguration = vecModules[m].substr(i+1);
+
+		// Read one newline-terminated request
+		std::string strRequest;
+		char szBuf[1024];
+		for (;;) {
+			ssize_t nRead = read(fdClient, szBuf, sizeof(szBuf));
+			if (nRead <= 0) {
+				break;
+			}
+			strRequest.append(szBuf, nRead);
+			if (strRequest.find('\n') != std::string::npos) {
+				break;
+			}
+			if (strRequest.length() > 65536) {
 				break;
 			}
 		}
-		if (strParentModule == "") {
-			strParentModule = vecModules[m];
-			strConfiguration = "";
+		size_t sNewline = strRequest.find('\n');
+		if (sNewline != std::string::npos) {
+			strRequest.resize(sNewline);
 		}
-
-		// Check for base module in library
-		CMECLibrary::const_iterator itmodule = lib.find(strParentModule);
-		if (itmodule == lib.end()) {
-			printf("ERROR: Module \"%s\" not found in CMEC library\n",
-				strParentModule.c_str());
+		if ((strRequest.length() != 0) &&
+		    (strRequest[strRequest.length()-1] == '\r')
+		) {
+			strRequest.resize(strRequest.length()-1);
 		}
 
-		// Check if module contains a settings file
-		if (CMECModuleSettings::ExistsInModulePath(itmodule->second)) {
-			if (strConfiguration != "") {
-				printf("ERROR: Module \"%s\" only contains a single configuration\n", strParentModule.c_str());
-				return (-1);
+		// Tokenize on spaces, dropping empty tokens
+		std::vector<std::string> vecTokens;
+		{
+			std::vector<STLStringHelper::StringView> vecViews;
+			STLStringHelper::Split(strRequest, ' ', vecViews);
+			for (size_t t = 0; t < vecViews.size(); t++) {
+				if (vecViews[t].sLength != 0) {
+					vecTokens.push_back(vecViews[t].str());
+				}
 			}
+		}
 
-			CMECModuleSettings cmecsettings;
-			fSuccess = cmecsettings.ReadFromFile(itmodule->second / g_szCMECSettingsName);
-			if (!fSuccess) {
-				return (-1);
+		// Refresh the resident library if the file has changed on disk
+		{
+			intmax_t iMTime = 0;
+			intmax_t iSize = 0;
+			CMECValidationCache::GetFileStamp(
+				lib.GetLibraryFilePath(), iMTime, iSize);
+			if ((iMTime != iLibMTime) || (iSize != iLibSize)) {
+				lib.Read();
+				iLibMTime = iMTime;
+				iLibSize = iSize;
 			}
+		}
 
-			vecModulePaths.push_back(itmodule->second);
-			vecDriverScripts.push_back(itmodule->second / filesystem::path(cmecsettings.GetDriverScript()));
-			vecWorkingDirs.push_back(filesystem::path(cmecsettings.GetName()));
-
-		// Check if module contains a contents file
-		} else if (CMECModuleTOC::ExistsInModulePath(itmodule->second)) {
-			CMECModuleTOC cmectoc;
-			fSuccess = cmectoc.ReadFromModulePath(itmodule->second);
-			if (!fSuccess) {
-				return (-1);
+		// Dispatch, with stdout redirected to the client for the
+		// duration of the request
+		int iResult = 0;
+
+		fflush(stdout);
+		int fdSavedStdout = dup(STDOUT_FILENO);
+		dup2(fdClient, STDOUT_FILENO);
+
+		if (vecTokens.size() == 0) {
+			printf("ERROR: Empty request\n");
+			iResult = 1;
+
+		} else if (vecTokens[0] == "ping") {
+			printf("pong\n");
+
+		} else if (vecTokens[0] == "shutdown") {
+			printf("Shutting down\n");
+			fShutdown = true;
+
+		} else if (vecTokens[0] == "list") {
+			if (vecTokens.size() == 1) {
+				iResult = cmec_list(false, lib);
+			} else if ((vecTokens.size() == 2) && (vecTokens[1] == "all")) {
+				iResult = cmec_list(true, lib);
+			} else {
+				printf("Usage: list [all]\n");
+				iResult = 1;
 			}
 
-			bool fContainsConfiguration = false;
-			for (auto itsettings = cmectoc.begin(); itsettings != cmectoc.end(); itsettings++) {
-				if ((strConfiguration != "") && (strConfiguration != itsettings->first)) {
-					continue;
-				}
-				CMECModuleSettings cmecsettings;
-				fSuccess = cmecsettings.ReadFromFile(itsettings->second);
-				if (!fSuccess) {
-					return (-1);
-				}
-
-				vecModulePaths.push_back(itmodule->second);
-				vecDriverScripts.push_back(
-					itmodule->second /
-					filesystem::path(cmecsettings.GetDriverScript()));
-				vecWorkingDirs.push_back(filesystem::path(cmectoc.GetName()) / filesystem::path(cmecsettings.GetName()));
+		} else if (vecTokens[0] == "register") {
+			if (vecTokens.size() == 2) {
+				iResult = cmec_register(vecTokens[1]);
+			} else {
+				printf("Usage: register <module directory>\n");
+				iResult = 1;
+			}
 
-				fContainsConfiguration = true;
+		} else if (vecTokens[0] == "unregister") {
+			if (vecTokens.size() == 2) {
+				iResult = cmec_unregister(vecTokens[1]);
+			} else {
+				printf("Usage: unregister <module name>\n");
+				iResult = 1;
 			}
 
-			if ((strConfiguration != "") && (!fContainsConfiguration)) {
-				printf("ERROR: Module \"%s\" does not contain configuration \"%s\"\n",
-					strParentModule.c_str(),
-					strConfiguration.c_str());
-				return (-1);
+		} else if (vecTokens[0] == "run") {
+			if (vecTokens.size() >= 5) {
+				std::vector<std::string> vecModules(
+					vecTokens.begin() + 4, vecTokens.end());
+				iResult = cmec_run(
+					vecTokens[1], vecTokens[2], vecTokens[3], vecModules);
+			} else {
+				printf("Usage: run <obs dir> <model dir> <working dir> <modules>\n");
+				iResult = 1;
 			}
 
 		} else {
-			printf("ERROR: Module \"%s\" with path \"%s\" does not contain \"%s\" or \"%s\"\n",
-				strParentModule.c_str(),
-				itmodule->second.str().c_str(),
-				g_szCMECSettingsName,
-				g_szCMECTOCName);
+			printf("ERROR: Unknown request \"%s\"\n", vecTokens[0].c_str());
+			iResult = 1;
 		}
-	}
-
-	_ASSERT(vecModulePaths.size() == vecDriverScripts.size());
-	_ASSERT(vecModulePaths.size() == vecWorkingDirs.size());
-
-	// Check for zero drivers
-	if (vecDriverScripts.size() == 0) {
-		printf("ERROR: No driver files found\n");
-		return (-1);
-	}
-
-	// Output driver file list
-	printf("The following %lu module(s) will be executed:\n", vecDriverScripts.size());
-	printf("------------------------------------------------------------\n");
-	for (int d = 0; d < vecDriverScripts.size(); d++) {
-		printf("MODULE_NAME: %s\n", vecWorkingDirs[d].str().c_str());
-		printf("MODULE_PATH: %s\n", vecModulePaths[d].str().c_str());
-		printf("  %s\n", vecDriverScripts[d].str().c_str());
-	}
-	printf("------------------------------------------------------------\n");
-
-	// Environment variables
-	printf("The following environment variables will be set:\n");
-	printf("------------------------------------------------------------\n");
-	printf("CMEC_OBS_DATA=%s\n", pathObsDir.str().c_str());
-	printf("CMEC_MODEL_DATA=%s\n", pathModelDir.str().c_str());
-	printf("CMEC_WK_DIR=%s/$MODULE_NAME\n", pathWorkingDir.str().c_str());
-	printf("CMEC_CODE_DIR=$MODULE_PATH\n");
-	printf("------------------------------------------------------------\n");
-
-	// Create output directories
-	printf("Creating output directories\n");
-
-	for (int d = 0; d < vecDriverScripts.size(); d++) {
-		filesystem::path pathOut = pathWorkingDir / vecWorkingDirs[d];
 
-		// Check for existence of output directories
-		if (pathOut.exists()) {
-			printf("Path \"%s\" already exists. Overwrite? [y/N]", pathOut.str().c_str());
-			bool fRemove = false;
-			for (;;) {
-				char c = Terminal::GetSingleCharacter();
-				if ((c == 'y') || (c == 'Y')) {
-					fRemove = true;
-					break;
-				}
-				if ((c == '\n') || (c == '\r') || (c == 'n') || (c == 'N')) {
-					fRemove = false;
-					break;
-				}
-			}
-			if (!fRemove) {
-				printf("ERROR: Unable to clear output directory");
-				return (-1);
-			}
+		fflush(stdout);
+		dup2(fdSavedStdout, STDOUT_FILENO);
+		close(fdSavedStdout);
 
-			// TODO: REPLACE WITH INTERNAL COMMANDS
-			std::string strCommand = "rm -rf " + pathOut.str();
-			int iReturn = std::system(strCommand.c_str());
-			if (iReturn != 0) {
-				printf("ERROR: Executing \"%s\" (%i)\n", strCommand.c_str(), iReturn);
-				return (-1);
-			}
+		// Trailing status line
+		char szStatus[32];
+		snprintf(szStatus, sizeof(szStatus), "== exit %i\n", iResult);
+		ssize_t nWritten = write(fdClient, szStatus, strlen(szStatus));
+		if (nWritten < 0) {
+			printf("WARNING: Unable to write status line to client\n");
 		}
 
-		// Actually create the directories
-		fSuccess = create_directories(pathOut);
-		if (!fSuccess) {
-			printf("ERROR: Unable to create directory \"%s\"\n", pathOut.str().c_str());
-			return (-1);
-		}
-		printf("\nCreated \"%s\"\n", pathOut.str().c_str());
+		close(fdClient);
 	}
 
-	// Create command scripts
-	printf("\nCreating bash driver environments");
-	for (int d = 0; d < vecDriverScripts.size(); d++) {
-		filesystem::path pathMyWorkingDir = pathWorkingDir / vecWorkingDirs[d];
-		filesystem::path pathScript = pathMyWorkingDir / "cmec_run.bash";
-		vecEnvScripts.push_back(pathScript);
-		printf("%s\n", pathScript.str().c_str());
-		std::ofstream ofscript(pathScript.str());
-		ofscript << "#!/bin/bash" << std::endl;
-		ofscript << "export CMEC_CODE_DIR=" << vecModulePaths[d].str() << std::endl;
-		ofscript << "export CMEC_OBS_DATA=" << pathObsDir.str() << std::endl;
-		ofscript << "export CMEC_MODEL_DATA=" << pathModelDir.str() << std::endl;
-		ofscript << "export CMEC_WK_DIR=" << pathMyWorkingDir.str() << std::endl;
-		ofscript << vecDriverScripts[d] << std::endl;
-		ofscript.close();
-
-		std::string strChmod = std::string("chmod u+x ") + pathScript.str();
-		system(strChmod.c_str());
-	}
-
-	// Executing command scripts
-	printf("Executing driver scripts\n");
-	for (int d = 0; d < vecDriverScripts.size(); d++) {
-		printf("------------------------------------------------------------\n");
-		printf("\033[1m%s\033[0m\n", vecWorkingDirs[d].str().c_str());
-		system(vecEnvScripts[d].str().c_str());
-	}
-	printf("------------------------------------------------------------\n");
+	close(fdListen);
+	unlink(pathSocket.str().c_str());
+
+	printf("Daemon stopped\n");
 
 	return 0;
 }
@@ -1262,12 +6152,34 @@ int main(int argc, char **argv) {
 
 	// Register
 	if (strCommand == "register") {
-		if (vecArg.size() == 1) {
-			std::string strModuleDir = vecArg[0];
+		static const ArgumentFlagSpec aRegisterFlagSpec[] = {
+			{"-scan", 0},
+			{"-profile", 0}
+		};
+
+		ArgumentParser parser(
+			aRegisterFlagSpec,
+			sizeof(aRegisterFlagSpec) / sizeof(aRegisterFlagSpec[0]));
+
+		if (!parser.Parse(2, argc, argv)) {
+			char szParseError[128];
+			parser.GetErrorMessage(szParseError, sizeof(szParseError));
+			printf("%s\n", szParseError);
+			return 1;
+		}
+		if (parser.HasFlag("-profile")) {
+			g_Profiler.Enable();
+		}
+
+		if (parser.GetArgumentCount() == 1) {
+			std::string strModuleDir = parser.GetArgument(0);
+			if (parser.HasFlag("-scan")) {
+				return cmec_register_scan(strModuleDir);
+			}
 			return cmec_register(strModuleDir);
 
 		} else {
-			printf("Usage: %s register <module directory>\n", strExecutable.c_str());
+			printf("Usage: %s register [--scan] [--profile] <module directory>\n", strExecutable.c_str());
 			return 1;
 		}
 	}
@@ -1285,30 +6197,226 @@ int main(int argc, char **argv) {
 
 	// List available modules
 	if (strCommand == "list") {
-		if (vecArg.size() == 0) {
-			return cmec_list(false);
+		static const ArgumentFlagSpec aListFlagSpec[] = {
+			{"-json", 0},
+			{"-profile", 0}
+		};
+
+		ArgumentParser parser(
+			aListFlagSpec,
+			sizeof(aListFlagSpec) / sizeof(aListFlagSpec[0]));
+
+		if (!parser.Parse(2, argc, argv)) {
+			char szParseError[128];
+			parser.GetErrorMessage(szParseError, sizeof(szParseError));
+			printf("%s\n", szParseError);
+			return 1;
+		}
+		if (parser.HasFlag("-profile")) {
+			g_Profiler.Enable();
+		}
+
+		bool fJSON = parser.HasFlag("-json");
 
-		} else if ((vecArg.size() == 1) && (vecArg[0] == "all")) {
-			return cmec_list(true);
+		if (parser.GetArgumentCount() == 0) {
+			return cmec_list(false, fJSON);
+
+		} else if ((parser.GetArgumentCount() == 1) &&
+		           (strcmp(parser.GetArgument(0), "all") == 0)
+		) {
+			return cmec_list(true, fJSON);
 
 		} else {
-			printf("Usage: %s list\n", strExecutable.c_str());
+			printf("Usage: %s list [--json] [--profile] [all]\n", strExecutable.c_str());
 			return 1;
 		}
 	}
 
 	// Execute module(s)
 	if (strCommand == "run") {
-		if (vecArg.size() >= 4) {
+		static const ArgumentFlagSpec aRunFlagSpec[] = {
+			{"j", 1},
+			{"-cpus-per-module", 1},
+			{"-hosts", 1},
+			{"-force", 0},
+			{"-no-clobber", 0},
+			{"-timeout", 1},
+			{"-max-memory", 1},
+			{"-max-cpu-time", 1},
+			{"-profile", 0}
+		};
+
+		ArgumentParser parser(
+			aRunFlagSpec,
+			sizeof(aRunFlagSpec) / sizeof(aRunFlagSpec[0]));
+
+		if (!parser.Parse(2, argc, argv)) {
+			char szParseError[128];
+			parser.GetErrorMessage(szParseError, sizeof(szParseError));
+			printf("%s\n", szParseError);
+			return 1;
+		}
+
+		// Number of concurrent module executions
+		size_t nConcurrency = 1;
+		const char * szThreads = parser.GetFlagValue("j");
+		if (szThreads != NULL) {
+			int nThreads = atoi(szThreads);
+			if (nThreads < 1) {
+				printf("ERROR: Invalid argument for \"-j\": \"%s\"\n",
+					szThreads);
+				return 1;
+			}
+			nConcurrency = static_cast<size_t>(nThreads);
+		}
+
+		// CPUs pinned to each concurrent module execution
+		size_t nCPUsPerModule = 0;
+		const char * szCPUsPerModule =
+			parser.GetFlagValue("-cpus-per-module");
+		if (szCPUsPerModule != NULL) {
+			int nCPUs = atoi(szCPUsPerModule);
+			if (nCPUs < 1) {
+				printf("ERROR: Invalid argument for \"--cpus-per-module\": \"%s\"\n",
+					szCPUsPerModule);
+				return 1;
+			}
+			nCPUsPerModule = static_cast<size_t>(nCPUs);
+		}
+
+		if (parser.HasFlag("-profile")) {
+			g_Profiler.Enable();
+		}
+
+		// Comma-separated hosts for distributed execution
+		std::string strHosts;
+		const char * szHosts = parser.GetFlagValue("-hosts");
+		if (szHosts != NULL) {
+			strHosts = szHosts;
+		}
+
+		// Overwrite policy for existing output directories
+		if (parser.HasFlag("-force") && parser.HasFlag("-no-clobber")) {
+			printf("ERROR: --force and --no-clobber are mutually exclusive\n");
+			return 1;
+		}
+
+		// Per-driver resource limits
+		DriverResourceLimits limits;
+		const char * szTimeout = parser.GetFlagValue("-timeout");
+		if (szTimeout != NULL) {
+			limits.dTimeoutSeconds = atof(szTimeout);
+			if (limits.dTimeoutSeconds <= 0.0) {
+				printf("ERROR: Invalid argument for \"--timeout\": \"%s\"\n",
+					szTimeout);
+				return 1;
+			}
+		}
+		const char * szMaxMemory = parser.GetFlagValue("-max-memory");
+		if (szMaxMemory != NULL) {
+			limits.iMaxMemoryMB = atoll(szMaxMemory);
+			if (limits.iMaxMemoryMB <= 0) {
+				printf("ERROR: Invalid argument for \"--max-memory\": \"%s\"\n",
+					szMaxMemory);
+				return 1;
+			}
+		}
+		const char * szMaxCPUTime = parser.GetFlagValue("-max-cpu-time");
+		if (szMaxCPUTime != NULL) {
+			limits.iMaxCPUSeconds = atoll(szMaxCPUTime);
+			if (limits.iMaxCPUSeconds <= 0) {
+				printf("ERROR: Invalid argument for \"--max-cpu-time\": \"%s\"\n",
+					szMaxCPUTime);
+				return 1;
+			}
+		}
+
+		if (parser.GetArgumentCount() >= 4) {
 			std::vector<std::string> vecModules;
-			for (int i = 3; i < vecArg.size(); i++) {
-				vecModules.push_back(vecArg[i]);
+			for (size_t i = 3; i < parser.GetArgumentCount(); i++) {
+				vecModules.push_back(parser.GetArgument(i));
 			}
 
-			return cmec_run(vecArg[0], vecArg[1], vecArg[2], vecModules);
+			return cmec_run(
+				parser.GetArgument(0),
+				parser.GetArgument(1),
+				parser.GetArgument(2),
+				vecModules,
+				nConcurrency,
+				parser.HasFlag("-force"),
+				nCPUsPerModule,
+				strHosts,
+				parser.HasFlag("-no-clobber"),
+				limits);
+
+		} else {
+			printf("Usage: %s run [-j <threads>] [--cpus-per-module <cpus>] [--hosts <host,host,...>] [--force] [--no-clobber] [--timeout <s>] [--max-memory <MB>] [--max-cpu-time <s>] [--profile] <obs dir> <model dir> <working dir> <modules>\n", strExecutable.c_str());
+			return 1;
+		}
+	}
+
+	// Execute one shard of a distributed run (launched by the head
+	// invocation of "run --hosts"; not intended for interactive use)
+	if (strCommand == "run-agent") {
+		if (vecArg.size() == 1) {
+			return cmec_run_agent(vecArg[0]);
+
+		} else {
+			printf("Usage: %s run-agent <assignment file>\n", strExecutable.c_str());
+			return 1;
+		}
+	}
+
+	// Aggregate module outputs
+	if (strCommand == "aggregate") {
+		static const ArgumentFlagSpec aAggregateFlagSpec[] = {
+			{"-profile", 0}
+		};
+
+		ArgumentParser parser(
+			aAggregateFlagSpec,
+			sizeof(aAggregateFlagSpec) / sizeof(aAggregateFlagSpec[0]));
+
+		if (!parser.Parse(2, argc, argv)) {
+			char szParseError[128];
+			parser.GetErrorMessage(szParseError, sizeof(szParseError));
+			printf("%s\n", szParseError);
+			return 1;
+		}
+		if (parser.HasFlag("-profile")) {
+			g_Profiler.Enable();
+		}
+
+		if (parser.GetArgumentCount() == 1) {
+			return cmec_aggregate(parser.GetArgument(0));
+
+		} else {
+			printf("Usage: %s aggregate [--profile] <working dir>\n", strExecutable.c_str());
+			return 1;
+		}
+	}
+
+	// Report run-history statistics
+	if (strCommand == "stats") {
+		if (vecArg.size() == 0) {
+			return cmec_stats(std::string(""));
+
+		} else if (vecArg.size() == 1) {
+			return cmec_stats(vecArg[0]);
+
+		} else {
+			printf("Usage: %s stats [module]\n", strExecutable.c_str());
+			return 1;
+		}
+	}
+
+	// Run as a resident daemon
+	if (strCommand == "serve") {
+		if (vecArg.size() == 0) {
+			return cmec_serve();
 
 		} else {
-			printf("Usage: %s run <obs dir> <model dir> <working dir> <modules>\n", strExecutable.c_str());
+			printf("Usage: %s serve\n", strExecutable.c_str());
 			return 1;
 		}
 	}
@@ -1316,11 +6424,14 @@ int main(int argc, char **argv) {
 	// Check command line arguments
 	{
 		printf("Usage:\n");
-		printf("%s register <module directory>\n", strExecutable.c_str());
+		printf("%s register [--scan] <module directory>\n", strExecutable.c_str());
 		printf("%s unregister <module name>\n", strExecutable.c_str());
-		printf("%s list [all]\n", strExecutable.c_str());
+		printf("%s list [--json] [all]\n", strExecutable.c_str());
 		//printf("%s remove-library\n", strExecutable.c_str());
-		printf("%s run <obs dir> <model dir> <working dir> <modules>\n", strExecutable.c_str());
+		printf("%s run [-j <threads>] [--cpus-per-module <cpus>] [--hosts <host,host,...>] [--force] [--no-clobber] [--timeout <s>] [--max-memory <MB>] [--max-cpu-time <s>] [--profile] <obs dir> <model dir> <working dir> <modules>\n", strExecutable.c_str());
+		printf("%s aggregate [--profile] <working dir>\n", strExecutable.c_str());
+		printf("%s stats [module]\n", strExecutable.c_str());
+		printf("%s serve\n", strExecutable.c_str());
 		return 1;
 	}
 
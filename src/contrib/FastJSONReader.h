@@ -0,0 +1,588 @@
+///////////////////////////////////////////////////////////////////////////////
+///
+///	\file    FastJSONReader.h
+///	\author  Paul Ullrich
+///	\version September 1, 2026
+///
+///	<remarks>
+///		Copyright (c) 2020 Paul Ullrich
+///
+///		Distributed under the BSD 3-Clause License.
+///		(See accompanying file LICENSE)
+///	</remarks>
+
+#ifndef _FASTJSONREADER_H_
+#define _FASTJSONREADER_H_
+
+///////////////////////////////////////////////////////////////////////////////
+
+#include "json.hpp"
+
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		A high-throughput JSON reader feeding the nlohmann SAX interface.
+///		The whole input buffer is scanned with 16-byte SIMD classification
+///		of whitespace runs and string contents (with a scalar fallback on
+///		targets without SSE2), strings without escapes are handed to the
+///		consumer as single bulk copies, and numbers take an inline
+///		integer fast path with strtod reserved for floats.  Events match
+///		those of the bundled lexer, so any json_sax consumer (including
+///		json_sax_dom_parser) works unchanged.  Intended for the driver's
+///		large-file paths; unlike the bundled lexer this reader does not
+///		validate that string contents are well-formed UTF-8.
+///	</summary>
+class FastJSONReader {
+
+public:
+	///	<summary>
+	///		Parse the given buffer, delivering events to the given SAX
+	///		consumer.  Returns false if the consumer aborted the parse or
+	///		(after invoking the consumer's parse_error) if the input is
+	///		malformed.
+	///	</summary>
+	template <typename SAXType>
+	static bool Parse(
+		const char * pBegin,
+		const char * pEnd,
+		SAXType & sax
+	) {
+		const char * p = pBegin;
+
+		// Skip a UTF-8 byte order mark, as the bundled lexer does
+		if ((pEnd - p >= 3) &&
+		    (memcmp(p, "\xef\xbb\xbf", 3) == 0)
+		) {
+			p += 3;
+		}
+
+		// Container stack:  true for an object, false for an array
+		std::vector<bool> vecIsObject;
+
+		// Reused decode buffer for strings and keys
+		std::string strValue;
+
+	NeedValue:
+		p = SkipWhitespace(p, pEnd);
+		if (p == pEnd) {
+			return Error(sax, pBegin, p, pEnd,
+				"unexpected end of input; expected value");
+		}
+
+		switch (*p) {
+			case '{':
+				if (!sax.start_object(static_cast<std::size_t>(-1))) {
+					return false;
+				}
+				p = SkipWhitespace(p + 1, pEnd);
+				if ((p != pEnd) && (*p == '}')) {
+					p++;
+					if (!sax.end_object()) {
+						return false;
+					}
+					goto AfterValue;
+				}
+				vecIsObject.push_back(true);
+				goto NeedKey;
+
+			case '[':
+				if (!sax.start_array(static_cast<std::size_t>(-1))) {
+					return false;
+				}
+				p = SkipWhitespace(p + 1, pEnd);
+				if ((p != pEnd) && (*p == ']')) {
+					p++;
+					if (!sax.end_array()) {
+						return false;
+					}
+					goto AfterValue;
+				}
+				vecIsObject.push_back(false);
+				goto NeedValue;
+
+			case '"':
+				if (!ParseString(p, pEnd, strValue)) {
+					return Error(sax, pBegin, p, pEnd,
+						"malformed string");
+				}
+				if (!sax.string(strValue)) {
+					return false;
+				}
+				goto AfterValue;
+
+			case 't':
+				if ((pEnd - p >= 4) && (memcmp(p, "true", 4) == 0)) {
+					p += 4;
+					if (!sax.boolean(true)) {
+						return false;
+					}
+					goto AfterValue;
+				}
+				return Error(sax, pBegin, p, pEnd, "invalid literal");
+
+			case 'f':
+				if ((pEnd - p >= 5) && (memcmp(p, "false", 5) == 0)) {
+					p += 5;
+					if (!sax.boolean(false)) {
+						return false;
+					}
+					goto AfterValue;
+				}
+				return Error(sax, pBegin, p, pEnd, "invalid literal");
+
+			case 'n':
+				if ((pEnd - p >= 4) && (memcmp(p, "null", 4) == 0)) {
+					p += 4;
+					if (!sax.null()) {
+						return false;
+					}
+					goto AfterValue;
+				}
+				return Error(sax, pBegin, p, pEnd, "invalid literal");
+
+			default: {
+				int iResult = ParseNumber(p, pEnd, sax);
+				if (iResult < 0) {
+					return Error(sax, pBegin, p, pEnd,
+						"malformed number");
+				}
+				if (iResult == 0) {
+					return false;
+				}
+				goto AfterValue;
+			}
+		}
+
+	NeedKey:
+		p = SkipWhitespace(p, pEnd);
+		if ((p == pEnd) || (*p != '"')) {
+			return Error(sax, pBegin, p, pEnd, "expected object key");
+		}
+		if (!ParseString(p, pEnd, strValue)) {
+			return Error(sax, pBegin, p, pEnd, "malformed string");
+		}
+		if (!sax.key(strValue)) {
+			return false;
+		}
+		p = SkipWhitespace(p, pEnd);
+		if ((p == pEnd) || (*p != ':')) {
+			return Error(sax, pBegin, p, pEnd, "expected \':\'");
+		}
+		p++;
+		goto NeedValue;
+
+	AfterValue:
+		if (vecIsObject.empty()) {
+			p = SkipWhitespace(p, pEnd);
+			if (p != pEnd) {
+				return Error(sax, pBegin, p, pEnd,
+					"unexpected character after document");
+			}
+			return true;
+		}
+
+		p = SkipWhitespace(p, pEnd);
+		if (p == pEnd) {
+			return Error(sax, pBegin, p, pEnd,
+				"unexpected end of input within container");
+		}
+		if (*p == ',') {
+			p++;
+			if (vecIsObject.back()) {
+				goto NeedKey;
+			}
+			goto NeedValue;
+		}
+		if (vecIsObject.back()) {
+			if (*p != '}') {
+				return Error(sax, pBegin, p, pEnd,
+					"expected \',\' or \'}\'");
+			}
+			p++;
+			vecIsObject.pop_back();
+			if (!sax.end_object()) {
+				return false;
+			}
+
+		} else {
+			if (*p != ']') {
+				return Error(sax, pBegin, p, pEnd,
+					"expected \',\' or \']\'");
+			}
+			p++;
+			vecIsObject.pop_back();
+			if (!sax.end_array()) {
+				return false;
+			}
+		}
+		goto AfterValue;
+	}
+
+	///	<summary>
+	///		Parse the given buffer into a JSON document.  Throws
+	///		nlohmann::json::parse_error on malformed input.
+	///	</summary>
+	static nlohmann::json ParseDocument(
+		const char * pBegin,
+		const char * pEnd
+	) {
+		nlohmann::json jdoc;
+		nlohmann::detail::json_sax_dom_parser<nlohmann::json> sax(jdoc, true);
+		Parse(pBegin, pEnd, sax);
+		return jdoc;
+	}
+
+protected:
+	///	<summary>
+	///		Advance past JSON whitespace, sixteen bytes at a time.
+	///	</summary>
+	static const char * SkipWhitespace(
+		const char * p,
+		const char * pEnd
+	) {
+#if defined(__SSE2__)
+		const __m128i mSpace = _mm_set1_epi8(' ');
+		const __m128i mTab = _mm_set1_epi8('\t');
+		const __m128i mNewline = _mm_set1_epi8('\n');
+		const __m128i mReturn = _mm_set1_epi8('\r');
+		while (pEnd - p >= 16) {
+			__m128i mChunk =
+				_mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+			__m128i mIsWhitespace =
+				_mm_or_si128(
+					_mm_or_si128(
+						_mm_cmpeq_epi8(mChunk, mSpace),
+						_mm_cmpeq_epi8(mChunk, mTab)),
+					_mm_or_si128(
+						_mm_cmpeq_epi8(mChunk, mNewline),
+						_mm_cmpeq_epi8(mChunk, mReturn)));
+			int iMask =
+				(~_mm_movemask_epi8(mIsWhitespace)) & 0xFFFF;
+			if (iMask != 0) {
+				return p + __builtin_ctz(iMask);
+			}
+			p += 16;
+		}
+#endif
+		while ((p != pEnd) &&
+		       ((*p == ' ') || (*p == '\t') ||
+		        (*p == '\n') || (*p == '\r'))
+		) {
+			p++;
+		}
+		return p;
+	}
+
+	///	<summary>
+	///		Find the next character requiring attention within a string:
+	///		the closing quote, a backslash, or an (invalid) unescaped
+	///		control character.
+	///	</summary>
+	static const char * ScanStringSpecial(
+		const char * p,
+		const char * pEnd
+	) {
+#if defined(__SSE2__)
+		const __m128i mQuote = _mm_set1_epi8('"');
+		const __m128i mBackslash = _mm_set1_epi8('\\');
+		const __m128i mControlMax = _mm_set1_epi8(0x1f);
+		while (pEnd - p >= 16) {
+			__m128i mChunk =
+				_mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+			// Unsigned (c <= 0x1f) via min:  min(c, 0x1f) == c
+			__m128i mIsControl =
+				_mm_cmpeq_epi8(
+					_mm_min_epu8(mChunk, mControlMax), mChunk);
+			__m128i mIsSpecial =
+				_mm_or_si128(
+					_mm_or_si128(
+						_mm_cmpeq_epi8(mChunk, mQuote),
+						_mm_cmpeq_epi8(mChunk, mBackslash)),
+					mIsControl);
+			int iMask = _mm_movemask_epi8(mIsSpecial);
+			if (iMask != 0) {
+				return p + __builtin_ctz(iMask);
+			}
+			p += 16;
+		}
+#endif
+		while (p != pEnd) {
+			unsigned char c = static_cast<unsigned char>(*p);
+			if ((c == '"') || (c == '\\') || (c <= 0x1f)) {
+				return p;
+			}
+			p++;
+		}
+		return pEnd;
+	}
+
+	///	<summary>
+	///		Append the UTF-8 encoding of the given code point.
+	///	</summary>
+	static void AppendCodePoint(
+		std::string & strOut,
+		unsigned int uCodePoint
+	) {
+		if (uCodePoint < 0x80) {
+			strOut += static_cast<char>(uCodePoint);
+		} else if (uCodePoint < 0x800) {
+			strOut += static_cast<char>(0xc0 | (uCodePoint >> 6));
+			strOut += static_cast<char>(0x80 | (uCodePoint & 0x3f));
+		} else if (uCodePoint < 0x10000) {
+			strOut += static_cast<char>(0xe0 | (uCodePoint >> 12));
+			strOut += static_cast<char>(0x80 | ((uCodePoint >> 6) & 0x3f));
+			strOut += static_cast<char>(0x80 | (uCodePoint & 0x3f));
+		} else {
+			strOut += static_cast<char>(0xf0 | (uCodePoint >> 18));
+			strOut += static_cast<char>(0x80 | ((uCodePoint >> 12) & 0x3f));
+			strOut += static_cast<char>(0x80 | ((uCodePoint >> 6) & 0x3f));
+			strOut += static_cast<char>(0x80 | (uCodePoint & 0x3f));
+		}
+	}
+
+	///	<summary>
+	///		Parse four hexadecimal digits.  Returns false on a non-hex
+	///		character.
+	///	</summary>
+	static bool ParseHex4(
+		const char * p,
+		unsigned int & uValue
+	) {
+		uValue = 0;
+		for (int i = 0; i < 4; i++) {
+			char c = p[i];
+			uValue <<= 4;
+			if ((c >= '0') && (c <= '9')) {
+				uValue |= (c - '0');
+			} else if ((c >= 'a') && (c <= 'f')) {
+				uValue |= (c - 'a' + 10);
+			} else if ((c >= 'A') && (c <= 'F')) {
+				uValue |= (c - 'A' + 10);
+			} else {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	///	<summary>
+	///		Parse a string beginning at the opening quote, leaving p one
+	///		past the closing quote.  Escape-free spans are appended in
+	///		bulk.
+	///	</summary>
+	static bool ParseString(
+		const char *& p,
+		const char * pEnd,
+		std::string & strOut
+	) {
+		p++;
+		strOut.clear();
+
+		const char * pSegment = p;
+		for (;;) {
+			p = ScanStringSpecial(p, pEnd);
+			if (p == pEnd) {
+				return false;
+			}
+			if (*p == '"') {
+				strOut.append(pSegment, p);
+				p++;
+				return true;
+			}
+			if (static_cast<unsigned char>(*p) <= 0x1f) {
+				return false;
+			}
+
+			// Escape sequence
+			strOut.append(pSegment, p);
+			p++;
+			if (p == pEnd) {
+				return false;
+			}
+			switch (*p) {
+				case '"':  strOut += '"';  break;
+				case '\\': strOut += '\\'; break;
+				case '/':  strOut += '/';  break;
+				case 'b':  strOut += '\b'; break;
+				case 'f':  strOut += '\f'; break;
+				case 'n':  strOut += '\n'; break;
+				case 'r':  strOut += '\r'; break;
+				case 't':  strOut += '\t'; break;
+
+				case 'u': {
+					if (pEnd - p < 5) {
+						return false;
+					}
+					unsigned int uCodePoint;
+					if (!ParseHex4(p + 1, uCodePoint)) {
+						return false;
+					}
+					p += 4;
+
+					// Surrogate pair
+					if ((uCodePoint >= 0xd800) && (uCodePoint <= 0xdbff)) {
+						if ((pEnd - p < 7) ||
+						    (p[1] != '\\') || (p[2] != 'u')
+						) {
+							return false;
+						}
+						unsigned int uLow;
+						if (!ParseHex4(p + 3, uLow)) {
+							return false;
+						}
+						if ((uLow < 0xdc00) || (uLow > 0xdfff)) {
+							return false;
+						}
+						uCodePoint = 0x10000
+							+ ((uCodePoint - 0xd800) << 10)
+							+ (uLow - 0xdc00);
+						p += 6;
+
+					} else if ((uCodePoint >= 0xdc00) &&
+					           (uCodePoint <= 0xdfff)
+					) {
+						return false;
+					}
+
+					AppendCodePoint(strOut, uCodePoint);
+					break;
+				}
+
+				default:
+					return false;
+			}
+			p++;
+			pSegment = p;
+		}
+	}
+
+	///	<summary>
+	///		Parse a number beginning at p, leaving p one past its last
+	///		character, and deliver it to the SAX consumer with the same
+	///		integer/unsigned/float classification as the bundled lexer.
+	///		Returns 1 on success, 0 if the consumer aborted, and (-1) on
+	///		a malformed number.
+	///	</summary>
+	template <typename SAXType>
+	static int ParseNumber(
+		const char *& p,
+		const char * pEnd,
+		SAXType & sax
+	) {
+		const char * pTokenBegin = p;
+
+		bool fNegative = false;
+		if ((p != pEnd) && (*p == '-')) {
+			fNegative = true;
+			p++;
+		}
+		if ((p == pEnd) || (*p < '0') || (*p > '9')) {
+			p = pTokenBegin;
+			return (-1);
+		}
+
+		// Integer part, accumulated inline with overflow detection
+		unsigned long long ullValue = 0;
+		bool fOverflow = false;
+		if (*p == '0') {
+			p++;
+		} else {
+			while ((p != pEnd) && (*p >= '0') && (*p <= '9')) {
+				unsigned int uDigit = static_cast<unsigned int>(*p - '0');
+				if (ullValue > (18446744073709551615ULL - uDigit) / 10ULL) {
+					fOverflow = true;
+				}
+				ullValue = 10ULL * ullValue + uDigit;
+				p++;
+			}
+		}
+
+		// Fraction and exponent force the floating point path
+		bool fIsFloat = false;
+		if ((p != pEnd) && (*p == '.')) {
+			fIsFloat = true;
+			p++;
+			if ((p == pEnd) || (*p < '0') || (*p > '9')) {
+				p = pTokenBegin;
+				return (-1);
+			}
+			while ((p != pEnd) && (*p >= '0') && (*p <= '9')) {
+				p++;
+			}
+		}
+		if ((p != pEnd) && ((*p == 'e') || (*p == 'E'))) {
+			fIsFloat = true;
+			p++;
+			if ((p != pEnd) && ((*p == '+') || (*p == '-'))) {
+				p++;
+			}
+			if ((p == pEnd) || (*p < '0') || (*p > '9')) {
+				p = pTokenBegin;
+				return (-1);
+			}
+			while ((p != pEnd) && (*p >= '0') && (*p <= '9')) {
+				p++;
+			}
+		}
+
+		if ((!fIsFloat) && (!fOverflow)) {
+			if (!fNegative) {
+				return (sax.number_unsigned(ullValue))?(1):(0);
+			}
+			if (ullValue <= 9223372036854775807ULL) {
+				return (sax.number_integer(
+					-static_cast<long long>(ullValue)))?(1):(0);
+			}
+			if (ullValue == 9223372036854775808ULL) {
+				return (sax.number_integer(
+					-9223372036854775807LL - 1LL))?(1):(0);
+			}
+			// More negative than the integer type can hold
+		}
+
+		// Floating point path:  strtod requires NUL termination, so the
+		// token is copied out of the (unterminated) input buffer
+		std::string strToken(pTokenBegin, p);
+		double dValue = strtod(strToken.c_str(), NULL);
+		if ((dValue == HUGE_VAL) || (dValue == -HUGE_VAL)) {
+			p = pTokenBegin;
+			return (-1);
+		}
+		return (sax.number_float(dValue, strToken))?(1):(0);
+	}
+
+	///	<summary>
+	///		Report a parse error to the SAX consumer.
+	///	</summary>
+	template <typename SAXType>
+	static bool Error(
+		SAXType & sax,
+		const char * pBegin,
+		const char * p,
+		const char * pEnd,
+		const char * szMessage
+	) {
+		std::size_t sPosition = static_cast<std::size_t>(p - pBegin);
+		std::size_t sTokenLength =
+			(pEnd - p > 16)?(16):(static_cast<std::size_t>(pEnd - p));
+		std::string strToken(p, p + sTokenLength);
+		sax.parse_error(sPosition, strToken,
+			nlohmann::detail::parse_error::create(
+				101, sPosition, szMessage));
+		return false;
+	}
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+#endif // _FASTJSONREADER_H_
@@ -13,33 +13,162 @@
 
 #include <cstdio>
 #include <cstdlib>
+#include <cstdint>
 #include <unistd.h>
 #include <pwd.h>
+#include <dirent.h>
+#include <sys/stat.h>
+
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
 
 #include "contrib/json.hpp"
+#include "contrib/FastJSONReader.h"
 #include "filesystem_path.h"
 
+#include "ArgumentParser.h"
+#include "CompressedFile.h"
+#include "DataArray1D.h"
 #include "Exception.h"
 #include "Terminal.h"
 
 ///////////////////////////////////////////////////////////////////////////////
 
+///	<summary>
+///		A per-level dictionary of dimension values with hashed lookup and
+///		interned key strings.  Each distinct value is stored exactly once,
+///		in the hash map node, and assigned a dense integer ID in
+///		first-seen order; the per-level value arrays hold pointers to the
+///		interned strings, so an ID is usable directly as a tensor
+///		coordinate and converts back to its string without a search.  The
+///		set of keys to avoid is likewise hashed, so both membership tests
+///		that were previously linear scans are O(1).
+///	</summary>
+class DimensionDictionary {
+
+public:
+	///	<summary>
+	///		ID returned by Find() when a value is absent.
+	///	</summary>
+	static const size_t InvalidId = static_cast<size_t>(-1);
+
+public:
+	///	<summary>
+	///		Constructor, capturing the set of keys to avoid.
+	///	</summary>
+	DimensionDictionary(
+		const std::vector<std::string> & vecInvalidStrings
+	) {
+		for (size_t s = 0; s < vecInvalidStrings.size(); s++) {
+			m_setInvalidStrings.insert(vecInvalidStrings[s]);
+		}
+	}
+
+	///	<summary>
+	///		Set the number of dimension levels.
+	///	</summary>
+	void SetLevelCount(size_t sLevels) {
+		m_vecValueIds.resize(sLevels);
+		m_vecValues.resize(sLevels);
+	}
+
+	///	<summary>
+	///		Number of dimension levels.
+	///	</summary>
+	size_t GetLevelCount() const {
+		return m_vecValues.size();
+	}
+
+	///	<summary>
+	///		Check a key against the set of keys to avoid.
+	///	</summary>
+	bool IsInvalidString(const std::string & strKey) const {
+		return (m_setInvalidStrings.find(strKey) != m_setInvalidStrings.end());
+	}
+
+	///	<summary>
+	///		Intern a value at the given level, assigning it the next dense
+	///		ID if it has not been seen before.  Returns the value's ID.
+	///	</summary>
+	size_t Intern(size_t sLevel, const std::string & strValue) {
+		_ASSERT(sLevel < m_vecValueIds.size());
+
+		auto result =
+			m_vecValueIds[sLevel].insert(
+				std::pair<std::string, size_t>(
+					strValue, m_vecValues[sLevel].size()));
+		if (result.second) {
+			m_vecValues[sLevel].push_back(&(result.first->first));
+		}
+		return result.first->second;
+	}
+
+	///	<summary>
+	///		Look up the ID of a value at the given level, or InvalidId if
+	///		the value has not been interned.
+	///	</summary>
+	size_t Find(size_t sLevel, const std::string & strValue) const {
+		_ASSERT(sLevel < m_vecValueIds.size());
+
+		auto it = m_vecValueIds[sLevel].find(strValue);
+		if (it == m_vecValueIds[sLevel].end()) {
+			return InvalidId;
+		}
+		return it->second;
+	}
+
+	///	<summary>
+	///		Number of distinct values at the given level.
+	///	</summary>
+	size_t LevelSize(size_t sLevel) const {
+		_ASSERT(sLevel < m_vecValues.size());
+		return m_vecValues[sLevel].size();
+	}
+
+	///	<summary>
+	///		The interned value with the given ID at the given level.
+	///	</summary>
+	const std::string & Value(size_t sLevel, size_t sId) const {
+		_ASSERT(sLevel < m_vecValues.size());
+		_ASSERT(sId < m_vecValues[sLevel].size());
+		return *(m_vecValues[sLevel][sId]);
+	}
+
+protected:
+	///	<summary>
+	///		Set of keys to avoid.
+	///	</summary>
+	std::unordered_set<std::string> m_setInvalidStrings;
+
+	///	<summary>
+	///		Per-level map from interned value to dense ID.  The map nodes
+	///		own the interned strings.
+	///	</summary>
+	std::vector< std::unordered_map<std::string, size_t> > m_vecValueIds;
+
+	///	<summary>
+	///		Per-level array of pointers to interned values, indexed by ID.
+	///		Pointers remain stable across insertions since the hash map is
+	///		node-based.
+	///	</summary>
+	std::vector< std::vector<const std::string *> > m_vecValues;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
 void RecurseDimensionValuesFromRESULTS(
-	const std::vector<std::string> & vecInvalidStrings,
+	DimensionDictionary & dimdict,
 	const nlohmann::json & js,
-	std::vector< std::vector<std::string> > & vecDimensionValues,
 	size_t sLevel
 ) {
 	for (auto it = js.begin(); it != js.end(); it++) {
 		std::string strKey = it.key();
 
 		// Check key against list of keys to avoid
-		bool fInvalidString =
-			std::find(
-				vecInvalidStrings.begin(),
-				vecInvalidStrings.end(),
-				strKey) != vecInvalidStrings.end();
-		if (fInvalidString) {
+		if (dimdict.IsInvalidString(strKey)) {
 			continue;
 		}
 
@@ -48,34 +177,21 @@ void RecurseDimensionValuesFromRESULTS(
 			strKey = "Unspecified";
 		}
 
-		// Check if this is already in the array of dimension names
-		bool fExists =
-			std::find(
-				vecDimensionValues[sLevel].begin(),
-				vecDimensionValues[sLevel].end(),
-				strKey) != vecDimensionValues[sLevel].end();
+		dimdict.Intern(sLevel, strKey);
 
-		if (sLevel != vecDimensionValues.size()-1) {
+		if (sLevel != dimdict.GetLevelCount()-1) {
 			RecurseDimensionValuesFromRESULTS(
-				vecInvalidStrings,
+				dimdict,
 				*it,
-				vecDimensionValues,
 				sLevel+1);
 		}
-
-		if (fExists) {
-			continue;
-		}
-
-		vecDimensionValues[sLevel].push_back(strKey);
 	}
 }
 
 ///////////////////////////////////////////////////////////////////////////////
 
 void RecursivelyCopyRESULTS(
-	const std::vector<std::string> & vecInvalidStrings,
-	const std::vector< std::vector<std::string> > & vecDimensionValues,
+	const DimensionDictionary & dimdict,
 	bool fBlank,
 	const nlohmann::json & jsIn,
 	nlohmann::json & jsOut,
@@ -83,18 +199,17 @@ void RecursivelyCopyRESULTS(
 ) {
 	// Generate a blank RESULTS panel
 	if (fBlank) {
-		if (sLevel == vecDimensionValues.size()) {
+		if (sLevel == dimdict.GetLevelCount()) {
 			jsOut = -999.0;
 		} else {
-			for (size_t s = 0; s < vecDimensionValues[sLevel].size(); s++) {
-				jsOut[vecDimensionValues[sLevel][s]] = nlohmann::json::object();
+			for (size_t s = 0; s < dimdict.LevelSize(sLevel); s++) {
+				jsOut[dimdict.Value(sLevel, s)] = nlohmann::json::object();
 
 				RecursivelyCopyRESULTS(
-					vecInvalidStrings,
-					vecDimensionValues,
+					dimdict,
 					fBlank,
 					jsIn,
-					jsOut[vecDimensionValues[sLevel][s]],
+					jsOut[dimdict.Value(sLevel, s)],
 					sLevel+1);
 			}
 		}
@@ -102,7 +217,7 @@ void RecursivelyCopyRESULTS(
 	}
 
 	// Fill in RESULTS from the file
-	std::vector<bool> vecValuesFound(vecDimensionValues[sLevel].size(), false);
+	std::vector<bool> vecValuesFound(dimdict.LevelSize(sLevel), false);
 
 	for (auto it = jsIn.begin(); it != jsIn.end(); it++) {
 		std::string strKey = it.key();
@@ -110,12 +225,7 @@ void RecursivelyCopyRESULTS(
 		std::cout << strKey << std::endl;
 
 		// Check key against list of keys to avoid
-		bool fInvalidString =
-			std::find(
-				vecInvalidStrings.begin(),
-				vecInvalidStrings.end(),
-				strKey) != vecInvalidStrings.end();
-		if (fInvalidString) {
+		if (dimdict.IsInvalidString(strKey)) {
 			continue;
 		}
 
@@ -125,23 +235,18 @@ void RecursivelyCopyRESULTS(
 		}
 
 		// Identify this value as found
-		for (size_t v = 0; v <= vecDimensionValues[sLevel].size(); v++) {
-			if (v == vecDimensionValues[sLevel].size()) {
-				_EXCEPTIONT("Logic Error");
-			}
-			if (strKey == vecDimensionValues[sLevel][v]) {
-				vecValuesFound[v] = true;
-				break;
-			}
+		size_t sValueId = dimdict.Find(sLevel, strKey);
+		if (sValueId == DimensionDictionary::InvalidId) {
+			_EXCEPTIONT("Logic Error");
 		}
+		vecValuesFound[sValueId] = true;
 
 		// Recursively copy
 		if (it->is_object()) {
 			jsOut[strKey] = nlohmann::json::object();
 
 			RecursivelyCopyRESULTS(
-				vecInvalidStrings,
-				vecDimensionValues,
+				dimdict,
 				false,
 				*it,
 				jsOut[strKey],
@@ -158,11 +263,10 @@ void RecursivelyCopyRESULTS(
 	for (size_t s = 0; s < vecValuesFound.size(); s++) {
 		if (!vecValuesFound[s]) {
 			RecursivelyCopyRESULTS(
-				vecInvalidStrings,
-				vecDimensionValues,
+				dimdict,
 				true,
 				jsIn,
-				jsOut[vecDimensionValues[sLevel][s]],
+				jsOut[dimdict.Value(sLevel, s)],
 				sLevel+1);
 		}
 	}
@@ -171,14 +275,450 @@ void RecursivelyCopyRESULTS(
 ///////////////////////////////////////////////////////////////////////////////
 
 ///	<summary>
-///		Convert a PMP style metrics JSON file to a CMEC style JSON file.
+///		Fill a dense RESULTS tensor from the nested JSON representation.
+///		The tensor is stored in row-major order with one coordinate per
+///		dimension level; missing entries retain their fill value.  Returns
+///		false if the RESULTS block does not fit the dense model (a scalar
+///		above the innermost level or an object at the innermost level),
+///		in which case the caller should fall back to the recursive copy.
+///	</summary>
+bool FillDenseRESULTS(
+	const DimensionDictionary & dimdict,
+	const nlohmann::json & jsIn,
+	DataArray1D<double> & dTensor,
+	size_t sLevel,
+	size_t sOffset
+) {
+	for (auto it = jsIn.begin(); it != jsIn.end(); it++) {
+		std::string strKey = it.key();
+
+		// Check key against list of keys to avoid
+		if (dimdict.IsInvalidString(strKey)) {
+			continue;
+		}
+
+		// Change blank keys to "Unspecified"
+		if (strKey == "") {
+			strKey = "Unspecified";
+		}
+
+		// Convert the key to a dense tensor coordinate
+		size_t sValueId = dimdict.Find(sLevel, strKey);
+		if (sValueId == DimensionDictionary::InvalidId) {
+			_EXCEPTIONT("Logic Error");
+		}
+		size_t sChildOffset =
+			sOffset * dimdict.LevelSize(sLevel) + sValueId;
+
+		if (it->is_object()) {
+			if (sLevel == dimdict.GetLevelCount()-1) {
+				return false;
+			}
+			if (!FillDenseRESULTS(
+				dimdict,
+				*it,
+				dTensor,
+				sLevel+1,
+				sChildOffset)
+			) {
+				return false;
+			}
+
+		} else {
+			if (sLevel != dimdict.GetLevelCount()-1) {
+				return false;
+			}
+			if (it->is_string()) {
+				dTensor(sChildOffset) = std::stod(std::string(it.value()));
+			} else if (it->is_number()) {
+				dTensor(sChildOffset) = it.value();
+			} else {
+				return false;
+			}
+		}
+	}
+
+	return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Serialize a dense RESULTS tensor to the output stream in a single
+///		pass.  In pretty mode four-space indentation is used to match the
+///		pretty-printed remainder of the document; in compact mode all
+///		whitespace is omitted.
+///	</summary>
+void StreamDenseRESULTS(
+	std::ostream & os,
+	const DimensionDictionary & dimdict,
+	const DataArray1D<double> & dTensor,
+	size_t sLevel,
+	size_t sOffset,
+	bool fCompact,
+	const std::string & strIndent
+) {
+	if (sLevel == dimdict.GetLevelCount()) {
+		os << nlohmann::json(dTensor(sOffset)).dump();
+		return;
+	}
+
+	std::string strChildIndent = strIndent + "    ";
+
+	os << "{";
+	for (size_t s = 0; s < dimdict.LevelSize(sLevel); s++) {
+		if (s != 0) {
+			os << ",";
+		}
+		if (fCompact) {
+			os << nlohmann::json(dimdict.Value(sLevel, s)).dump() << ":";
+		} else {
+			os << "\n" << strChildIndent
+				<< nlohmann::json(dimdict.Value(sLevel, s)).dump() << ": ";
+		}
+		StreamDenseRESULTS(
+			os,
+			dimdict,
+			dTensor,
+			sLevel+1,
+			sOffset * dimdict.LevelSize(sLevel) + s,
+			fCompact,
+			strChildIndent);
+	}
+	if (fCompact) {
+		os << "}";
+	} else {
+		os << "\n" << strIndent << "}";
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Write a blank RESULTS subtree (all values -999.0) directly to the
+///		output stream.  Streaming-mode analogue of the fBlank branch of
+///		RecursivelyCopyRESULTS.
+///	</summary>
+void StreamBlankRESULTSSubtree(
+	std::ostream & os,
+	const DimensionDictionary & dimdict,
+	size_t sLevel
+) {
+	if (sLevel == dimdict.GetLevelCount()) {
+		os << "-999.0";
+		return;
+	}
+
+	os << "{";
+	for (size_t s = 0; s < dimdict.LevelSize(sLevel); s++) {
+		if (s != 0) {
+			os << ",";
+		}
+		os << nlohmann::json(dimdict.Value(sLevel, s)).dump() << ":";
+		StreamBlankRESULTSSubtree(os, dimdict, sLevel+1);
+	}
+	os << "}";
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		A SAX consumer which streams the RESULTS subtree of a PMP file
+///		directly to the output stream, performing the same key filtering,
+///		string-to-number conversion and blank filling as
+///		RecursivelyCopyRESULTS but without materializing either tree.
+///	</summary>
+class CMECResultsStreamWriter : public nlohmann::json::json_sax_t {
+
+public:
+	///	<summary>
+	///		Constructor.
+	///	</summary>
+	CMECResultsStreamWriter(
+		std::ostream & os,
+		const DimensionDictionary & dimdict
+	) :
+		m_os(os),
+		m_dimdict(dimdict),
+		m_nDepth(0),
+		m_fInRESULTS(false),
+		m_fPendingTopKeyRESULTS(false),
+		m_nSkipDepth(0),
+		m_fSkipScalar(false)
+	{ }
+
+public:
+	virtual bool null() override {
+		return Scalar("null");
+	}
+
+	virtual bool boolean(bool val) override {
+		return Scalar(val?("true"):("false"));
+	}
+
+	virtual bool number_integer(number_integer_t val) override {
+		return Scalar(std::to_string(val));
+	}
+
+	virtual bool number_unsigned(number_unsigned_t val) override {
+		return Scalar(std::to_string(val));
+	}
+
+	virtual bool number_float(number_float_t val, const string_t& s) override {
+		return Scalar(s);
+	}
+
+	virtual bool string(string_t& val) override {
+
+		// Match the DOM path:  string-valued metrics are converted to
+		// floating point on output.
+		if (m_fInRESULTS && (m_nSkipDepth == 0) && (!m_fSkipScalar)) {
+			return Scalar(nlohmann::json(std::stod(val)).dump());
+		}
+		return Scalar(nlohmann::json(val).dump());
+	}
+
+	virtual bool start_object(std::size_t elements) override {
+		m_nDepth++;
+
+		if (m_fSkipScalar) {
+			m_fSkipScalar = false;
+			m_nSkipDepth = 1;
+			return true;
+		}
+		if (m_nSkipDepth != 0) {
+			m_nSkipDepth++;
+			return true;
+		}
+
+		// The RESULTS object itself
+		if (m_fPendingTopKeyRESULTS) {
+			m_fPendingTopKeyRESULTS = false;
+			m_fInRESULTS = true;
+			m_os << "{";
+			m_vecValuesFound.resize(1);
+			m_vecValuesFound[0].assign(
+				m_dimdict.LevelSize(0), false);
+			m_vecNeedComma.assign(1, false);
+			return true;
+		}
+
+		// An object nested within RESULTS
+		if (m_fInRESULTS) {
+			m_os << "{";
+			size_t sLevel = m_vecValuesFound.size();
+			m_vecValuesFound.resize(sLevel+1);
+			if (sLevel < m_dimdict.GetLevelCount()) {
+				m_vecValuesFound[sLevel].assign(
+					m_dimdict.LevelSize(sLevel), false);
+			}
+			m_vecNeedComma.push_back(false);
+		}
+		return true;
+	}
+
+	virtual bool key(string_t& val) override {
+
+		if (m_nSkipDepth != 0) {
+			return true;
+		}
+
+		// Record the top-level key, watching for RESULTS
+		if (m_nDepth == 1) {
+			m_fPendingTopKeyRESULTS = (val == "RESULTS");
+			return true;
+		}
+
+		if (!m_fInRESULTS) {
+			return true;
+		}
+
+		std::string strKey = val;
+
+		// Check key against list of keys to avoid
+		if (m_dimdict.IsInvalidString(strKey)) {
+			m_fSkipScalar = true;
+			return true;
+		}
+
+		// Change blank keys to "Unspecified"
+		if (strKey == "") {
+			strKey = "Unspecified";
+		}
+
+		// Identify this value as found
+		size_t sLevel = m_vecValuesFound.size()-1;
+		if (sLevel < m_dimdict.GetLevelCount()) {
+			size_t sValueId = m_dimdict.Find(sLevel, strKey);
+			if (sValueId == DimensionDictionary::InvalidId) {
+				_EXCEPTION2("Logic Error key %s level %lu", strKey.c_str(), sLevel);
+			}
+			m_vecValuesFound[sLevel][sValueId] = true;
+		}
+
+		if (m_vecNeedComma[sLevel]) {
+			m_os << ",";
+		}
+		m_vecNeedComma[sLevel] = true;
+		m_os << nlohmann::json(strKey).dump() << ":";
+
+		return true;
+	}
+
+	virtual bool end_object() override {
+		m_nDepth--;
+
+		if (m_nSkipDepth != 0) {
+			m_nSkipDepth--;
+			if (m_nSkipDepth == 0) {
+				m_fSkipScalar = false;
+			}
+			return true;
+		}
+
+		if (!m_fInRESULTS) {
+			return true;
+		}
+
+		// Fill in blanks for dimension values not present in this object
+		size_t sLevel = m_vecValuesFound.size()-1;
+		if (sLevel < m_dimdict.GetLevelCount()) {
+			for (size_t v = 0; v < m_vecValuesFound[sLevel].size(); v++) {
+				if (!m_vecValuesFound[sLevel][v]) {
+					if (m_vecNeedComma[sLevel]) {
+						m_os << ",";
+					}
+					m_vecNeedComma[sLevel] = true;
+					m_os << nlohmann::json(
+						m_dimdict.Value(sLevel, v)).dump() << ":";
+					StreamBlankRESULTSSubtree(
+						m_os, m_dimdict, sLevel+1);
+				}
+			}
+		}
+
+		m_os << "}";
+		m_vecValuesFound.pop_back();
+		m_vecNeedComma.pop_back();
+
+		// End of the RESULTS object
+		if (m_vecValuesFound.empty()) {
+			m_fInRESULTS = false;
+		}
+
+		return true;
+	}
+
+	virtual bool start_array(std::size_t elements) override {
+		if ((m_fInRESULTS) && (m_nSkipDepth == 0) && (!m_fSkipScalar)) {
+			_EXCEPTIONT("Unexpected array within RESULTS");
+		}
+		if (m_fSkipScalar) {
+			m_fSkipScalar = false;
+			m_nSkipDepth = 1;
+		} else if (m_nSkipDepth != 0) {
+			m_nSkipDepth++;
+		}
+		m_nDepth++;
+		return true;
+	}
+
+	virtual bool end_array() override {
+		m_nDepth--;
+		if (m_nSkipDepth != 0) {
+			m_nSkipDepth--;
+			if (m_nSkipDepth == 0) {
+				m_fSkipScalar = false;
+			}
+		}
+		return true;
+	}
+
+	virtual bool parse_error(
+		std::size_t position,
+		const std::string& last_token,
+		const nlohmann::json::exception& ex
+	) override {
+		_EXCEPTION2("Malformed PMP JSON file %s at byte position %lu",
+			ex.what(), position);
+	}
+
+protected:
+	///	<summary>
+	///		Write a scalar value, honoring skip state.
+	///	</summary>
+	bool Scalar(const std::string & strValue) {
+		if (m_fSkipScalar && (m_nSkipDepth == 0)) {
+			m_fSkipScalar = false;
+			return true;
+		}
+		if ((!m_fInRESULTS) || (m_nSkipDepth != 0)) {
+			return true;
+		}
+		m_os << strValue;
+		return true;
+	}
+
+protected:
+	///	<summary>
+	///		Output stream.
+	///	</summary>
+	std::ostream & m_os;
+
+	///	<summary>
+	///		Dimension dictionary, also holding the set of keys to avoid.
+	///	</summary>
+	const DimensionDictionary & m_dimdict;
+
+	///	<summary>
+	///		Current object/array nesting depth in the document.
+	///	</summary>
+	int m_nDepth;
+
+	///	<summary>
+	///		Set when streaming within the RESULTS subtree.
+	///	</summary>
+	bool m_fInRESULTS;
+
+	///	<summary>
+	///		Set when the last top-level key seen was "RESULTS".
+	///	</summary>
+	bool m_fPendingTopKeyRESULTS;
+
+	///	<summary>
+	///		Nonzero when skipping a container associated with an invalid key.
+	///	</summary>
+	int m_nSkipDepth;
+
+	///	<summary>
+	///		Set when the next value read should be discarded.
+	///	</summary>
+	bool m_fSkipScalar;
+
+	///	<summary>
+	///		Per-level record of which dimension values have been observed.
+	///	</summary>
+	std::vector< std::vector<bool> > m_vecValuesFound;
+
+	///	<summary>
+	///		Per-level record of whether a separating comma is needed.
+	///	</summary>
+	std::vector<bool> m_vecNeedComma;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Convert a PMP style metrics JSON file to a CMEC style JSON file,
+///		pretty-printed with four-space indentation or (if fCompact is set)
+///		with all whitespace omitted.
 ///	</summary>
 void PMPtoCMECJSON(
 	const std::string & strPMPfile,
-	const std::string & strCMECfile
+	const std::string & strCMECfile,
+	bool fCompact = false
 ) {
 	std::vector< std::string > vecDimensionNames;
-	std::vector< std::vector<std::string> > vecDimensionValues;
 
 	// List of strings to not parse in RESULTS
 	std::vector<std::string> vecInvalidStrings;
@@ -190,23 +730,20 @@ void PMPtoCMECJSON(
 	vecInvalidStrings.push_back("InputRegionMD5");
 	vecInvalidStrings.push_back("source");
 
-	// Input stream
-	std::ifstream ifs(strPMPfile);
-	if (!ifs.is_open()) {
-		_EXCEPTION1("Unable to open PMP JSON file \"%s\"",
-			strPMPfile.c_str());
-	}
+	// Dimension dictionary
+	DimensionDictionary dimdict(vecInvalidStrings);
 
-	// Output stream
-	std::ofstream ofs(strCMECfile, std::ios::out);
-	if (!ofs.is_open()) {
-		_EXCEPTION1("Unable to open file \"%s\" for writing", strCMECfile.c_str());
-	}
+	// Map the input file into memory, decompressing gzip content
+	CompressedInputFile mmapPMP(strPMPfile);
+
+	// Output stream, compressed when the output filename ends in ".gz"
+	CompressedOutputFile fileOut(strCMECfile);
+	std::ostream & ofs = fileOut.Stream();
 
 	// Parse into a PMP JSON object
 	nlohmann::json jpmp;
 	try {
-		jpmp = nlohmann::json::parse(ifs);
+		jpmp = FastJSONReader::ParseDocument(mmapPMP.begin(), mmapPMP.end());
 	} catch (nlohmann::json::parse_error& e) {
 		_EXCEPTION3("Malformed PMP JSON file "
 			"%s (%i) at byte position %i",
@@ -249,40 +786,697 @@ void PMPtoCMECJSON(
 	}
 
 	// Recursively examine RESULTS to build dimension names
-	vecDimensionValues.resize(vecDimensionNames.size());
+	dimdict.SetLevelCount(vecDimensionNames.size());
 	RecurseDimensionValuesFromRESULTS(
-		vecInvalidStrings,
+		dimdict,
 		*itjresults,
-		vecDimensionValues,
 		0);
 
 	auto & jdims = jcmec["DIMENSIONS"]["dimensions"];
-	for (int s = 0; s < vecDimensionValues.size(); s++) {
+	for (size_t s = 0; s < dimdict.GetLevelCount(); s++) {
 		jdims[vecDimensionNames[s]] = nlohmann::json::object();
 		if (vecDimensionNames[s] == "statistic") {
 			jdims[vecDimensionNames[s]]["indices"] = nlohmann::json::array();
-			for (int v = 0; v < vecDimensionValues[s].size(); v++) {
-				jdims[vecDimensionNames[s]]["indices"].push_back(vecDimensionValues[s][v]);
+			for (size_t v = 0; v < dimdict.LevelSize(s); v++) {
+				jdims[vecDimensionNames[s]]["indices"].push_back(dimdict.Value(s, v));
 			}
 		} else {
-			for (int v = 0; v < vecDimensionValues[s].size(); v++) {
-				jdims[vecDimensionNames[s]][vecDimensionValues[s][v]] = nlohmann::json::object();
+			for (size_t v = 0; v < dimdict.LevelSize(s); v++) {
+				jdims[vecDimensionNames[s]][dimdict.Value(s, v)] = nlohmann::json::object();
 			}
 		}
 	}
 
-	// Recursively copy RESULTS
+	// Attempt the dense-tensor conversion:  the dictionary's dense IDs
+	// are the tensor coordinates, so the flat tensor is filled in one
+	// pass
+	bool fDense = (dimdict.GetLevelCount() != 0);
+
+	size_t sTotalSize = 1;
+	for (size_t s = 0; s < dimdict.GetLevelCount(); s++) {
+		sTotalSize *= dimdict.LevelSize(s);
+	}
+	if (sTotalSize == 0) {
+		fDense = false;
+	}
+
+	DataArray1D<double> dTensor;
+	if (fDense) {
+		dTensor.Allocate(sTotalSize);
+		for (size_t i = 0; i < sTotalSize; i++) {
+			dTensor(i) = -999.0;
+		}
+
+		fDense = FillDenseRESULTS(
+			dimdict,
+			*itjresults,
+			dTensor,
+			0, 0);
+	}
+
+	if (fDense) {
+
+		// Serialize the tensor in one pass, splicing RESULTS into the
+		// serialized remainder of the document
+		if (fCompact) {
+			std::string strHeader = jcmec.dump();
+			_ASSERT(strHeader.length() >= 1);
+			strHeader.resize(strHeader.length()-1);
+			ofs << strHeader << ",\"RESULTS\":";
+			StreamDenseRESULTS(ofs, dimdict, dTensor, 0, 0, true, "");
+			ofs << "}\n";
+
+		} else {
+			std::string strHeader = jcmec.dump(4);
+			_ASSERT(strHeader.length() >= 2);
+			strHeader.resize(strHeader.length()-2);
+			ofs << strHeader << ",\n    \"RESULTS\": ";
+			StreamDenseRESULTS(ofs, dimdict, dTensor, 0, 0, false, "    ");
+			ofs << "\n}" << std::endl;
+		}
+		fileOut.Close();
+		return;
+	}
+
+	// The RESULTS block does not fit the dense model; fall back to the
+	// recursive copy
 	RecursivelyCopyRESULTS(
-		vecInvalidStrings,
-		vecDimensionValues,
+		dimdict,
 		false,
 		*itjresults,
 		jcmec["RESULTS"],
 		0);
 
 	// Write to file
-	ofs << std::setw(4) << jcmec << std::endl;
-	ofs.close();
+	if (fCompact) {
+		ofs << jcmec << "\n";
+	} else {
+		ofs << std::setw(4) << jcmec << std::endl;
+	}
+	fileOut.Close();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Convert a PMP style metrics JSON file to a CMEC style JSON file
+///		using the SAX interface, without materializing the RESULTS tree
+///		in memory.  The file is read twice:  once to build the dimension
+///		dictionary (discarding RESULTS as it is parsed) and once to
+///		stream RESULTS directly to the output file.
+///	</summary>
+void PMPtoCMECJSONStreaming(
+	const std::string & strPMPfile,
+	const std::string & strCMECfile
+) {
+	std::vector< std::string > vecDimensionNames;
+
+	// List of strings to not parse in RESULTS
+	std::vector<std::string> vecInvalidStrings;
+	vecInvalidStrings.push_back("units");
+	vecInvalidStrings.push_back("SimulationDescription");
+	vecInvalidStrings.push_back("InputClimatologyFileName");
+	vecInvalidStrings.push_back("InputClimatologyMD5");
+	vecInvalidStrings.push_back("InputRegionFileName");
+	vecInvalidStrings.push_back("InputRegionMD5");
+	vecInvalidStrings.push_back("source");
+
+	// Dimension dictionary, grown level by level during the first pass
+	// since json_structure may follow RESULTS in the file
+	DimensionDictionary dimdict(vecInvalidStrings);
+
+	// Map the input file into memory, decompressing gzip content; both
+	// passes parse directly from the same buffer.
+	CompressedInputFile mmapPMP(strPMPfile);
+
+	// Output stream, compressed when the output filename ends in ".gz"
+	CompressedOutputFile fileOut(strCMECfile);
+	std::ostream & ofs = fileOut.Stream();
+
+	// First pass:  Parse the file with a callback that collects dimension
+	// values from RESULTS keys and discards the RESULTS subtree, leaving
+	// only the (small) remainder of the file in the DOM.
+	bool fInRESULTS = false;
+	int nSkipKeyDepth = 0;
+
+	nlohmann::json::parser_callback_t callback =
+		[&](int nDepth, nlohmann::json::parse_event_t event, nlohmann::json & parsed)
+	-> bool {
+		if (event == nlohmann::json::parse_event_t::key) {
+
+			// Note:  Discarded values generate no value or container-end
+			// events, so the end of an invalid key's subtree is detected
+			// by the arrival of a key at or above the skip depth.
+			if ((nSkipKeyDepth != 0) && (nDepth <= nSkipKeyDepth)) {
+				nSkipKeyDepth = 0;
+			}
+
+			if (nDepth == 1) {
+				fInRESULTS = (parsed == "RESULTS");
+				return true;
+			}
+			if ((fInRESULTS) && (nDepth >= 2) && (nSkipKeyDepth == 0)) {
+				std::string strKey = parsed;
+
+				// Check key against list of keys to avoid; the whole
+				// subtree beneath an invalid key is skipped
+				if (dimdict.IsInvalidString(strKey)) {
+					nSkipKeyDepth = nDepth;
+					return true;
+				}
+
+				// Change blank keys to "Unspecified"
+				if (strKey == "") {
+					strKey = "Unspecified";
+				}
+
+				size_t sLevel = static_cast<size_t>(nDepth-2);
+				if (sLevel >= dimdict.GetLevelCount()) {
+					dimdict.SetLevelCount(sLevel+1);
+				}
+
+				dimdict.Intern(sLevel, strKey);
+				return true;
+			}
+			return true;
+		}
+
+		// Discard everything within the RESULTS object as it is parsed,
+		// leaving only an empty RESULTS container in the DOM.
+		if (fInRESULTS) {
+			if (nDepth == 1) {
+				if (event == nlohmann::json::parse_event_t::object_end) {
+					fInRESULTS = false;
+				}
+				return true;
+			}
+			return false;
+		}
+
+		return true;
+	};
+
+	nlohmann::json jpmp;
+	try {
+		jpmp = nlohmann::json::parse(mmapPMP.begin(), mmapPMP.end(), callback);
+	} catch (nlohmann::json::parse_error& e) {
+		_EXCEPTION3("Malformed PMP JSON file "
+			"%s (%i) at byte position %i",
+			e.what(), e.id, e.byte);
+	}
+
+	// Get "json_structure" from PMP file
+	auto itjstruct = jpmp.find("json_structure");
+	if (itjstruct == jpmp.end()) {
+		_EXCEPTION1("Malformed PMP JSON file \"%s\" (missing top level \"json_structure\" key)",
+			strPMPfile.c_str());
+	}
+
+	// Output JSON object (everything except RESULTS)
+	nlohmann::json jcmec;
+
+	jcmec["SCHEMA"]["name"] = "CMEC";
+	jcmec["SCHEMA"]["version"] = "v1";
+	jcmec["SCHEMA"]["package"] = "PMP";
+
+	// Copy over additional keys
+	for (auto itkey = jpmp.begin(); itkey != jpmp.end(); itkey++) {
+		if ((itkey.key() != "RESULTS") && (itkey.key() != "json_structure")) {
+			jcmec[itkey.key()] = itkey.value();
+		}
+	}
+
+	// Dimensions
+	auto & jcmecdimarr = jcmec["DIMENSIONS"]["json_structure"] = nlohmann::json::array();
+	for (auto itdim = itjstruct->begin(); itdim != itjstruct->end(); itdim++) {
+		vecDimensionNames.push_back(itdim.value());
+		jcmecdimarr.push_back(itdim.value());
+	}
+
+	// Trim the dictionary to the declared dimension count, dropping any
+	// levels collected beneath the innermost declared dimension
+	dimdict.SetLevelCount(vecDimensionNames.size());
+
+	auto & jdims = jcmec["DIMENSIONS"]["dimensions"];
+	for (size_t s = 0; s < dimdict.GetLevelCount(); s++) {
+		jdims[vecDimensionNames[s]] = nlohmann::json::object();
+		if (vecDimensionNames[s] == "statistic") {
+			jdims[vecDimensionNames[s]]["indices"] = nlohmann::json::array();
+			for (size_t v = 0; v < dimdict.LevelSize(s); v++) {
+				jdims[vecDimensionNames[s]]["indices"].push_back(dimdict.Value(s, v));
+			}
+		} else {
+			for (size_t v = 0; v < dimdict.LevelSize(s); v++) {
+				jdims[vecDimensionNames[s]][dimdict.Value(s, v)] = nlohmann::json::object();
+			}
+		}
+	}
+
+	// Write the header, leaving the object open for RESULTS
+	std::string strHeader = jcmec.dump();
+	_ASSERT(strHeader.length() >= 2);
+	strHeader.resize(strHeader.length()-1);
+	ofs << strHeader << ",\"RESULTS\":";
+
+	// Second pass:  Stream RESULTS directly to the output file
+	CMECResultsStreamWriter saxwriter(ofs, dimdict);
+	FastJSONReader::Parse(mmapPMP.begin(), mmapPMP.end(), saxwriter);
+
+	ofs << "}" << std::endl;
+	fileOut.Close();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Filename of the conversion cache index, written into the output
+///		directory by incremental batch conversions.
+///	</summary>
+static const char * g_szConversionCacheName = ".pmp_to_cmec_cache.json";
+
+///	<summary>
+///		Compute the 64-bit FNV-1a digest of the given file's contents.
+///		Returns false if the file cannot be read.
+///	</summary>
+bool DigestFileContents(
+	const std::string & strFile,
+	uint64_t & uDigest
+) {
+	FILE * fp = fopen(strFile.c_str(), "rb");
+	if (fp == NULL) {
+		return false;
+	}
+
+	uDigest = 0xcbf29ce484222325ULL;
+
+	std::vector<unsigned char> vecBuffer(1024 * 1024);
+	for (;;) {
+		size_t sRead = fread(&(vecBuffer[0]), 1, vecBuffer.size(), fp);
+		for (size_t s = 0; s < sRead; s++) {
+			uDigest ^= static_cast<uint64_t>(vecBuffer[s]);
+			uDigest *= 0x100000001b3ULL;
+		}
+		if (sRead < vecBuffer.size()) {
+			break;
+		}
+	}
+
+	bool fSuccess = (ferror(fp) == 0);
+	fclose(fp);
+	return fSuccess;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		An index of input-file digests for previously converted files,
+///		stored alongside the outputs, which lets the batch converter skip
+///		inputs whose content has not changed.  Entries are keyed by
+///		output filename and record the input's FNV-1a content digest
+///		together with its size and mtime:  an input whose size and mtime
+///		both match is skipped without being reread, and one that fails
+///		that fast path is rehashed and still skipped if the digest
+///		matches (its stamp is then refreshed).  The conversion mode is
+///		part of each entry so changing --streaming or --compact forces a
+///		reconversion.  Methods are internally synchronized for use from
+///		the conversion worker pool.
+///	</summary>
+class ConversionCache {
+
+public:
+	///	<summary>
+	///		Constructor.
+	///	</summary>
+	ConversionCache() :
+		m_jentries(nlohmann::json::value_t::object)
+	{ }
+
+	///	<summary>
+	///		Read the cache index from the given output directory.  A
+	///		missing or malformed index simply leaves the cache empty, so
+	///		every input is converted and the index is rebuilt.
+	///	</summary>
+	void Read(
+		const filesystem::path & pathOutputDir
+	) {
+		m_pathCache =
+			pathOutputDir / filesystem::path(g_szConversionCacheName);
+
+		std::ifstream ifcache(m_pathCache.str());
+		if (!ifcache.is_open()) {
+			return;
+		}
+		nlohmann::json jcache;
+		try {
+			jcache = nlohmann::json::parse(ifcache);
+		} catch (nlohmann::json::parse_error &) {
+			printf("WARNING: Malformed conversion cache \"%s\"; "
+				"rebuilding\n",
+				m_pathCache.str().c_str());
+			return;
+		}
+		auto itentries = jcache.find("entries");
+		if ((itentries == jcache.end()) || (!itentries->is_object())) {
+			return;
+		}
+		m_jentries = *itentries;
+	}
+
+	///	<summary>
+	///		Write the cache index back to the output directory.
+	///	</summary>
+	void Write() {
+		nlohmann::json jcache;
+		jcache["version"] = 1;
+		jcache["entries"] = m_jentries;
+
+		std::ofstream ofcache(m_pathCache.str());
+		if (!ofcache.is_open()) {
+			printf("WARNING: Unable to write conversion cache \"%s\"\n",
+				m_pathCache.str().c_str());
+			return;
+		}
+		ofcache << jcache.dump(4) << std::endl;
+	}
+
+	///	<summary>
+	///		True if the entry for the given output filename matches the
+	///		input's size and mtime under the same conversion mode.
+	///	</summary>
+	bool MatchesStamp(
+		const std::string & strOutputFilename,
+		intmax_t iSize,
+		intmax_t iMTime,
+		const std::string & strMode
+	) {
+		std::lock_guard<std::mutex> lock(m_mutexCache);
+		auto itentry = m_jentries.find(strOutputFilename);
+		if (itentry == m_jentries.end()) {
+			return false;
+		}
+		return (((*itentry)["size"].get<intmax_t>() == iSize) &&
+		        ((*itentry)["mtime"].get<intmax_t>() == iMTime) &&
+		        ((*itentry)["mode"].get<std::string>() == strMode));
+	}
+
+	///	<summary>
+	///		True if the entry for the given output filename matches the
+	///		input's content digest under the same conversion mode.  On a
+	///		match the size and mtime stamp is refreshed so the fast path
+	///		applies next time.
+	///	</summary>
+	bool MatchesDigest(
+		const std::string & strOutputFilename,
+		uint64_t uDigest,
+		intmax_t iSize,
+		intmax_t iMTime,
+		const std::string & strMode
+	) {
+		std::lock_guard<std::mutex> lock(m_mutexCache);
+		auto itentry = m_jentries.find(strOutputFilename);
+		if (itentry == m_jentries.end()) {
+			return false;
+		}
+		if (((*itentry)["digest"].get<uint64_t>() != uDigest) ||
+		    ((*itentry)["mode"].get<std::string>() != strMode)
+		) {
+			return false;
+		}
+		(*itentry)["size"] = iSize;
+		(*itentry)["mtime"] = iMTime;
+		return true;
+	}
+
+	///	<summary>
+	///		Record the entry for a completed conversion.
+	///	</summary>
+	void Update(
+		const std::string & strOutputFilename,
+		uint64_t uDigest,
+		intmax_t iSize,
+		intmax_t iMTime,
+		const std::string & strMode
+	) {
+		std::lock_guard<std::mutex> lock(m_mutexCache);
+		nlohmann::json & jentry = m_jentries[strOutputFilename];
+		jentry["digest"] = uDigest;
+		jentry["size"] = iSize;
+		jentry["mtime"] = iMTime;
+		jentry["mode"] = strMode;
+	}
+
+protected:
+	///	<summary>
+	///		Path of the cache index file.
+	///	</summary>
+	filesystem::path m_pathCache;
+
+	///	<summary>
+	///		Cache entries, keyed by output filename.
+	///	</summary>
+	nlohmann::json m_jentries;
+
+	///	<summary>
+	///		Mutex protecting the entries.
+	///	</summary>
+	std::mutex m_mutexCache;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Convert a set of PMP files concurrently across a pool of worker
+///		threads, writing each output file (with the same filename) into
+///		the given output directory.  Arguments naming directories are
+///		expanded to the .json files they contain.  In incremental mode a
+///		conversion cache index in the output directory is consulted and
+///		inputs whose content digest is unchanged (and whose output still
+///		exists) are skipped, so a repeated pass over a large archive
+///		scales with the files that actually changed.  Returns the number
+///		of failed conversions.
+///	</summary>
+int PMPtoCMECBatch(
+	const std::vector<std::string> & vecInputArgs,
+	const std::string & strOutputDir,
+	bool fStreaming,
+	bool fCompact,
+	bool fIncremental,
+	size_t nConcurrency
+) {
+	// Expand directory arguments into their .json contents
+	std::vector<std::string> vecInputFiles;
+	for (size_t f = 0; f < vecInputArgs.size(); f++) {
+		filesystem::path pathInput(vecInputArgs[f]);
+		if (pathInput.is_directory()) {
+			DIR * pDir = opendir(pathInput.str().c_str());
+			if (pDir == NULL) {
+				_EXCEPTION1("Unable to open directory \"%s\"",
+					pathInput.str().c_str());
+			}
+			struct dirent * pDirent;
+			while ((pDirent = readdir(pDir)) != NULL) {
+				std::string strFilename(pDirent->d_name);
+				if ((strFilename.length() > 5) &&
+				    (strFilename.substr(strFilename.length()-5) == ".json")
+				) {
+					vecInputFiles.push_back(
+						(pathInput / filesystem::path(strFilename)).str());
+				}
+			}
+			closedir(pDir);
+
+		} else {
+			vecInputFiles.push_back(vecInputArgs[f]);
+		}
+	}
+
+	if (vecInputFiles.size() == 0) {
+		printf("ERROR: No input files found\n");
+		return 1;
+	}
+
+	filesystem::path pathOutputDir(strOutputDir);
+	if (!pathOutputDir.exists() || !pathOutputDir.is_directory()) {
+		printf("ERROR: Output path \"%s\" is not a directory\n",
+			strOutputDir.c_str());
+		return 1;
+	}
+
+	if (nConcurrency > vecInputFiles.size()) {
+		nConcurrency = vecInputFiles.size();
+	}
+
+	printf("Converting %lu file(s) (%lu workers)\n",
+		vecInputFiles.size(), nConcurrency);
+
+	// Conversion cache, consulted and rebuilt in incremental mode.  The
+	// conversion mode is part of each entry so cached results from a
+	// differently flagged pass are not reused.
+	ConversionCache cache;
+	std::string strMode =
+		std::string((fStreaming)?("streaming"):("dom"))
+		+ ((fCompact)?(",compact"):(""));
+	if (fIncremental) {
+		cache.Read(pathOutputDir);
+	}
+
+	// Per-file conversion status, gathered by the worker pool
+	std::vector<std::string> vecErrors(vecInputFiles.size());
+	std::vector<char> vecUpToDate(vecInputFiles.size(), 0);
+	std::atomic<size_t> sNextFile(0);
+	std::atomic<size_t> sFailureCount(0);
+	std::atomic<size_t> sUpToDateCount(0);
+	std::mutex mutexConsole;
+
+	auto WorkerLoop = [&]() {
+		for (;;) {
+			size_t f = sNextFile.fetch_add(1);
+			if (f >= vecInputFiles.size()) {
+				break;
+			}
+
+			filesystem::path pathInput(vecInputFiles[f]);
+			filesystem::path pathOutput =
+				pathOutputDir / filesystem::path(pathInput.filename());
+
+			try {
+				// Note make_absolute() requires an existing file, so the
+				// output path is resolved from its parent directory
+				filesystem::path pathOutputResolved =
+					pathOutputDir.make_absolute()
+					/ filesystem::path(pathInput.filename());
+
+				if (pathInput.make_absolute().str() ==
+				    pathOutputResolved.str()
+				) {
+					_EXCEPTIONT("Output file would overwrite input file");
+				}
+
+				// In incremental mode skip inputs whose cached entry is
+				// current:  first on the size+mtime stamp, then (if the
+				// stamp is stale) on the content digest.  A conversion
+				// whose output file has been removed is redone even if
+				// the digest matches.
+				intmax_t iSize = 0;
+				intmax_t iMTime = 0;
+				uint64_t uDigest = 0;
+				bool fHaveDigest = false;
+				if (fIncremental) {
+					struct stat statInput;
+					if (stat(pathInput.str().c_str(), &statInput) != 0) {
+						_EXCEPTION1("Unable to stat input file (%s)",
+							strerror(errno));
+					}
+					iSize = static_cast<intmax_t>(statInput.st_size);
+					iMTime = static_cast<intmax_t>(statInput.st_mtime);
+
+					if (pathOutput.exists()) {
+						bool fUpToDate =
+							cache.MatchesStamp(
+								pathInput.filename(),
+								iSize, iMTime, strMode);
+						if (!fUpToDate) {
+							if (!DigestFileContents(
+									pathInput.str(), uDigest)
+							) {
+								_EXCEPTIONT("Unable to read input file");
+							}
+							fHaveDigest = true;
+							fUpToDate =
+								cache.MatchesDigest(
+									pathInput.filename(),
+									uDigest,
+									iSize, iMTime, strMode);
+						}
+						if (fUpToDate) {
+							vecUpToDate[f] = 1;
+							sUpToDateCount.fetch_add(1);
+
+							std::lock_guard<std::mutex> lock(mutexConsole);
+							printf("[%lu/%lu] %s up to date\n",
+								f+1,
+								vecInputFiles.size(),
+								vecInputFiles[f].c_str());
+							continue;
+						}
+					}
+
+					// Digest before converting, so the recorded digest
+					// cannot postdate the content that was converted
+					if (!fHaveDigest) {
+						if (!DigestFileContents(pathInput.str(), uDigest)) {
+							_EXCEPTIONT("Unable to read input file");
+						}
+						fHaveDigest = true;
+					}
+				}
+
+				if (fStreaming) {
+					PMPtoCMECJSONStreaming(pathInput.str(), pathOutput.str());
+				} else {
+					PMPtoCMECJSON(pathInput.str(), pathOutput.str(), fCompact);
+				}
+
+				if (fIncremental) {
+					cache.Update(
+						pathInput.filename(),
+						uDigest, iSize, iMTime, strMode);
+				}
+
+			} catch(Exception & e) {
+				vecErrors[f] = e.ToString();
+				sFailureCount.fetch_add(1);
+			} catch(std::exception & e) {
+				vecErrors[f] = e.what();
+				sFailureCount.fetch_add(1);
+			}
+
+			{
+				std::lock_guard<std::mutex> lock(mutexConsole);
+				printf("[%lu/%lu] %s %s\n",
+					f+1,
+					vecInputFiles.size(),
+					vecInputFiles[f].c_str(),
+					(vecErrors[f] == "")?("converted"):("FAILED"));
+			}
+		}
+	};
+
+	// Launch workers
+	std::vector<std::thread> vecWorkers;
+	for (size_t w = 0; w < nConcurrency; w++) {
+		vecWorkers.push_back(std::thread(WorkerLoop));
+	}
+	for (size_t w = 0; w < vecWorkers.size(); w++) {
+		vecWorkers[w].join();
+	}
+
+	// Write back the updated conversion cache
+	if (fIncremental) {
+		cache.Write();
+	}
+
+	// Aggregate failure report
+	size_t sFailures = sFailureCount.load();
+	size_t sUpToDate = sUpToDateCount.load();
+	printf("------------------------------------------------------------\n");
+	if (fIncremental) {
+		printf("Converted %lu file(s); %lu up to date; %lu failure(s)\n",
+			vecInputFiles.size() - sFailures - sUpToDate,
+			sUpToDate,
+			sFailures);
+	} else {
+		printf("Converted %lu file(s); %lu failure(s)\n",
+			vecInputFiles.size() - sFailures,
+			sFailures);
+	}
+	for (size_t f = 0; f < vecInputFiles.size(); f++) {
+		if (vecErrors[f] != "") {
+			printf("  %s: %s\n", vecInputFiles[f].c_str(), vecErrors[f].c_str());
+		}
+	}
+
+	return static_cast<int>(sFailures);
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -292,22 +1486,94 @@ int main(int argc, char **argv) {
 	try {
 
 	// Executable
-	std::string strExecutable = argv[0];
+	const char * szExecutable = argv[0];
+
+	// Parse flags and arguments in place, without copying argv
+	static const ArgumentFlagSpec aFlagSpec[] = {
+		{"-streaming", 0},
+		{"-compact", 0},
+		{"-batch", 0},
+		{"-incremental", 0},
+		{"j", 1}
+	};
+
+	ArgumentParser parser(
+		aFlagSpec,
+		sizeof(aFlagSpec) / sizeof(aFlagSpec[0]));
+
+	if (!parser.Parse(1, argc, argv)) {
+		char szParseError[128];
+		parser.GetErrorMessage(szParseError, sizeof(szParseError));
+		printf("%s\n", szParseError);
+		return 1;
+	}
+
+	bool fStreaming = parser.HasFlag("-streaming");
+	bool fCompact = parser.HasFlag("-compact");
+
+	size_t nConcurrency = 0;
+	const char * szThreads = parser.GetFlagValue("j");
+	if (szThreads != NULL) {
+		int nThreads = atoi(szThreads);
+		if (nThreads < 1) {
+			printf("ERROR: Flag \"-j\" requires a positive integer argument\n");
+			return 1;
+		}
+		nConcurrency = static_cast<size_t>(nThreads);
+	}
+
+	// Batch conversion mode
+	if (parser.HasFlag("-batch")) {
+		if (parser.GetArgumentCount() < 2) {
+			printf("Usage: %s --batch [--streaming] [--compact] [--incremental] [-j <threads>] <PMP json file or dir> [...] <output dir>\n", szExecutable);
+			return 1;
+		}
 
-	// Arguments
-	std::vector<std::string> vecArg;
-	for (int c = 1; c < argc; c++) {
-		vecArg.push_back(argv[c]);
+		std::vector<std::string> vecInputArgs;
+		for (size_t s = 0; s + 1 < parser.GetArgumentCount(); s++) {
+			vecInputArgs.push_back(parser.GetArgument(s));
+		}
+		std::string strOutputDir =
+			parser.GetArgument(parser.GetArgumentCount() - 1);
+
+		if (nConcurrency == 0) {
+			nConcurrency = static_cast<size_t>(std::thread::hardware_concurrency());
+			if (nConcurrency < 1) {
+				nConcurrency = 1;
+			}
+			if (nConcurrency > 8) {
+				nConcurrency = 8;
+			}
+		}
+
+		return PMPtoCMECBatch(
+			vecInputArgs,
+			strOutputDir,
+			fStreaming,
+			fCompact,
+			parser.HasFlag("-incremental"),
+			nConcurrency);
+	}
+
+	// The conversion cache lives next to the outputs, so incremental
+	// mode only applies to batch conversions
+	if (parser.HasFlag("-incremental")) {
+		printf("ERROR: --incremental requires --batch\n");
+		return 1;
 	}
 
 	// Only two arguments allowed
-	if (vecArg.size() != 2) {
-		printf("Usage: %s <PMP json file> <CMEC json file>\n", strExecutable.c_str());
+	if (parser.GetArgumentCount() != 2) {
+		printf("Usage: %s [--streaming] [--compact] <PMP json file> <CMEC json file>\n", szExecutable);
 		return 1;
 	}
 
 	// Call the converter
-	PMPtoCMECJSON(vecArg[0], vecArg[1]);
+	if (fStreaming) {
+		PMPtoCMECJSONStreaming(parser.GetArgument(0), parser.GetArgument(1));
+	} else {
+		PMPtoCMECJSON(parser.GetArgument(0), parser.GetArgument(1), fCompact);
+	}
 
 	// Catch exceptions
 	} catch(Exception & e) {